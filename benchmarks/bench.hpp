@@ -0,0 +1,197 @@
+/**
+ * Minimal benchmark harness for the CBT benchmark suite
+ *
+ * Each case is a callable that performs a known number of operations. The
+ * harness calibrates how many calls make one repetition last at least
+ * min_time_ms, runs warmup repetitions, then times each repetition with
+ * steady_clock at nanosecond resolution and reports the mean, standard
+ * deviation, min and max cost per operation plus throughput.
+ *
+ * Command line:
+ *   --json <path>     also write results as JSON
+ *   --filter <text>   only run cases whose "group/name" contains text
+ *   --reps <n>        measured repetitions per case (default 10)
+ *   --min-time <ms>   minimum duration of one repetition (default 20)
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cbt::bench {
+
+/// Fixed seed shared by every data generator, so runs are reproducible
+constexpr std::uint32_t seed = 20240607u;
+
+/// @brief Force value to be materialized, defeating dead-code elimination
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+    (void)*p;
+#endif
+}
+
+/// @brief Compiler barrier: memory written so far is considered observed
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct options {
+    std::size_t warmup = 2;
+    std::size_t repetitions = 10;
+    double min_time_ms = 20.0;
+    std::string filter;
+    std::string json_path;
+};
+
+struct result {
+    std::string group;
+    std::string name;
+    std::size_t ops_per_call;
+    std::size_t calls_per_rep;
+    std::size_t repetitions;
+    double ns_per_op;      ///< Mean over repetitions
+    double stddev_ns;      ///< Sample standard deviation over repetitions
+    double min_ns;
+    double max_ns;
+    double ops_per_second;
+};
+
+class suite {
+private:
+    using clock = std::chrono::steady_clock;
+
+    options options_;
+    std::vector<result> results_;
+
+    template<typename F>
+    static double time_calls(F& body, std::size_t calls) {
+        auto start = clock::now();
+        for (std::size_t c = 0; c < calls; ++c) {
+            body();
+            clobber_memory();
+        }
+        auto stop = clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+public:
+    explicit suite(options opts) : options_(std::move(opts)) {}
+
+    static options parse(int argc, char** argv) {
+        options opts;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    std::cerr << "missing value for " << arg << "\n";
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+            if (arg == "--json") {
+                opts.json_path = next();
+            } else if (arg == "--filter") {
+                opts.filter = next();
+            } else if (arg == "--reps") {
+                opts.repetitions = std::max<std::size_t>(2, std::stoul(next()));
+            } else if (arg == "--min-time") {
+                opts.min_time_ms = std::stod(next());
+            } else {
+                std::cerr << "unknown argument " << arg << "\n";
+                std::exit(2);
+            }
+        }
+        return opts;
+    }
+
+    /// @brief Time body(), which performs ops operations per call
+    template<typename F>
+    void run(const std::string& group, const std::string& name, std::size_t ops, F&& body) {
+        std::string id = group + "/" + name;
+        if (!options_.filter.empty() && id.find(options_.filter) == std::string::npos) return;
+
+        // Calibrate: double the call count until one repetition is long enough
+        std::size_t calls = 1;
+        const double min_ns = options_.min_time_ms * 1e6;
+        while (time_calls(body, calls) < min_ns && calls < (std::size_t(1) << 30)) calls *= 2;
+        for (std::size_t w = 0; w < options_.warmup; ++w) time_calls(body, calls);
+
+        std::vector<double> per_op(options_.repetitions);
+        for (auto& sample : per_op) {
+            sample = time_calls(body, calls) / static_cast<double>(calls * ops);
+        }
+        double mean = 0;
+        for (double s : per_op) mean += s;
+        mean /= static_cast<double>(per_op.size());
+        double var = 0;
+        for (double s : per_op) var += (s - mean) * (s - mean);
+        var /= static_cast<double>(per_op.size() - 1);
+
+        result r{group, name, ops, calls, per_op.size(), mean, std::sqrt(var),
+                 *std::min_element(per_op.begin(), per_op.end()),
+                 *std::max_element(per_op.begin(), per_op.end()),
+                 1e9 / mean};
+        std::cout << std::left << std::setw(44) << id << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << r.ns_per_op << " ns/op  ±"
+                  << std::setw(8) << r.stddev_ns << "  " << std::setprecision(1)
+                  << std::setw(10) << r.ops_per_second / 1e6 << " Mop/s\n";
+        results_.push_back(std::move(r));
+    }
+
+    const std::vector<result>& results() const { return results_; }
+
+    void write_json(std::ostream& os) const {
+        os << "{\n  \"library\": \"cbt\",\n  \"seed\": " << seed << ",\n";
+#ifdef __VERSION__
+        os << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+        os << "  \"repetitions\": " << options_.repetitions << ",\n  \"results\": [\n";
+        os << std::setprecision(6) << std::scientific;
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const auto& r = results_[i];
+            os << "    {\"group\": \"" << r.group << "\", \"name\": \"" << r.name
+               << "\", \"ops_per_call\": " << r.ops_per_call
+               << ", \"calls_per_rep\": " << r.calls_per_rep
+               << ", \"repetitions\": " << r.repetitions
+               << ", \"ns_per_op\": " << r.ns_per_op
+               << ", \"stddev_ns\": " << r.stddev_ns
+               << ", \"variance_ns2\": " << r.stddev_ns * r.stddev_ns
+               << ", \"min_ns\": " << r.min_ns
+               << ", \"max_ns\": " << r.max_ns
+               << ", \"ops_per_second\": " << r.ops_per_second << "}"
+               << (i + 1 < results_.size() ? ",\n" : "\n");
+        }
+        os << "  ]\n}\n";
+    }
+
+    /// @brief Write JSON if requested; returns the process exit code
+    int finish() const {
+        if (options_.json_path.empty()) return 0;
+        std::ofstream out(options_.json_path);
+        if (!out) {
+            std::cerr << "cannot write " << options_.json_path << "\n";
+            return 1;
+        }
+        write_json(out);
+        std::cout << "wrote " << results_.size() << " results to " << options_.json_path << "\n";
+        return 0;
+    }
+};
+
+} // namespace cbt::bench
@@ -0,0 +1,691 @@
+// Per-operation microbenchmarks for every CBT transform header
+//
+// Build: cmake -S . -B build -DCBT_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release
+// Run:   cmake --build build --target benchmarks   (writes cbt_benchmarks.json)
+//
+// Each transform is measured next to the baseline operation it replaces, with
+// inputs drawn from generators seeded by bench::seed.
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/cbt/cbt.hpp"
+#include "bench.hpp"
+
+using namespace cbt;
+using bench::do_not_optimize;
+
+namespace {
+
+constexpr std::size_t batch = 4096;
+
+std::vector<double> uniform_doubles(std::size_t n, double lo, double hi, std::uint32_t stream) {
+    std::mt19937_64 gen(bench::seed + stream);
+    std::uniform_real_distribution<double> dis(lo, hi);
+    std::vector<double> out(n);
+    for (auto& v : out) v = dis(gen);
+    return out;
+}
+
+std::vector<std::uint32_t> uniform_words(std::size_t n, std::uint32_t bound, std::uint32_t stream) {
+    std::mt19937 gen(bench::seed + stream);
+    std::vector<std::uint32_t> out(n);
+    for (auto& v : out) v = gen() % bound;
+    return out;
+}
+
+void bench_logarithmic(bench::suite& s) {
+    auto probs = uniform_doubles(batch, 1e-11, 1e-9, 1);
+    std::vector<lgd> logs;
+    for (double p : probs) logs.emplace_back(p);
+
+    s.run("logarithmic", "baseline_double_multiply", batch, [&] {
+        double product = 1.0;
+        for (double p : probs) product *= p;
+        do_not_optimize(product);
+    });
+    s.run("logarithmic", "lg_multiply", batch, [&] {
+        lgd product(1.0);
+        for (const auto& l : logs) product = product * l;
+        do_not_optimize(product);
+    });
+    s.run("logarithmic", "lg_add", batch, [&] {
+        lgd sum = lgd::from_log(-std::numeric_limits<double>::infinity());
+        for (const auto& l : logs) sum = sum + l;
+        do_not_optimize(sum);
+    });
+    s.run("logarithmic", "lg_sum_batched", batch, [&] {
+        do_not_optimize(lg_sum(logs));
+    });
+    s.run("logarithmic", "transform_from_double", batch, [&] {
+        for (double p : probs) do_not_optimize(lgd(p));
+    });
+
+    lg_vector<double> a(probs), b(uniform_doubles(batch, 0.1, 1.0, 2)), c(uniform_doubles(batch, 0.1, 1.0, 3));
+    lg_vector<double> out(batch);
+    s.run("lg_vector", "fused_mul_div", batch, [&] {
+        out = a * b / c;
+        do_not_optimize(out.data());
+    });
+    s.run("lg_vector", "reduce_product", batch, [&] {
+        do_not_optimize(reduce_product(a * b));
+    });
+    s.run("lg_vector", "dot", batch, [&] {
+        do_not_optimize(dot(a, b));
+    });
+}
+
+void bench_odds_ratio(bench::suite& s) {
+    auto ratios = uniform_doubles(batch, 0.1, 10.0, 4);
+    std::vector<odds_ratio<double>> lrs;
+    std::vector<log_odds<double>> log_lrs;
+    for (double r : ratios) {
+        lrs.emplace_back(r);
+        log_lrs.push_back(log_odds<double>::from_odds(r));
+    }
+
+    s.run("odds_ratio", "baseline_probability_update", batch, [&] {
+        double p = 0.01;
+        for (double r : ratios) {
+            double odds = p / (1 - p) * r;
+            p = odds / (1 + odds);
+        }
+        do_not_optimize(p);
+    });
+    s.run("odds_ratio", "odds_update", batch, [&] {
+        auto odds = odds_ratio<double>::from_probability(0.01);
+        for (const auto& lr : lrs) odds = odds * lr;
+        do_not_optimize(odds);
+    });
+    s.run("odds_ratio", "log_odds_update", batch, [&] {
+        auto lo = log_odds<double>::from_probability(0.01);
+        for (const auto& lr : log_lrs) lo = lo + lr;
+        do_not_optimize(lo);
+    });
+
+    // Triage scoring: 4096 records × 64 tests, one packed word per record
+    bayesian_diagnostic<double> panel(0.01);
+    auto rates = uniform_doubles(128, 0.6, 0.99, 5);
+    for (std::size_t t = 0; t < 64; ++t) panel.add_test(rates[2 * t], rates[2 * t + 1]);
+    std::mt19937_64 gen(bench::seed + 6);
+    std::vector<std::uint64_t> records(batch);
+    for (auto& w : records) w = gen();
+    s.run("bayesian", "update_batch_64_tests", batch, [&] {
+        do_not_optimize(panel.update_batch(records));
+    });
+}
+
+void bench_log_odds_scorer(bench::suite& s) {
+    // 1024 documents × 64 features drawn from a 2^20-feature vocabulary
+    constexpr std::size_t docs = 1024, per_doc = 64, vocabulary = std::size_t(1) << 20;
+    auto ids = uniform_words(docs * per_doc, vocabulary, 7);
+    std::vector<std::uint64_t> features(ids.begin(), ids.end());
+    std::vector<std::size_t> offsets(docs + 1);
+    for (std::size_t d = 0; d <= docs; ++d) offsets[d] = d * per_doc;
+    auto weights = uniform_doubles(vocabulary, -1.0, 1.0, 8);
+
+    log_odds_scorer<double> dense(vocabulary);
+    hashed_log_odds_scorer<double> hashed(vocabulary);
+    for (std::size_t f = 0; f < vocabulary; ++f) {
+        dense.add_weight(f, weights[f]);
+        hashed.add_weight(f, weights[f]);
+    }
+    s.run("log_odds_scorer", "dense_score_batch_64", docs, [&] {
+        do_not_optimize(dense.score_batch(features, offsets));
+    });
+    s.run("log_odds_scorer", "hashed_score_batch_64", docs, [&] {
+        do_not_optimize(hashed.score_batch(features, offsets));
+    });
+}
+
+void bench_rns(bench::suite& s) {
+    auto xs = uniform_words(batch, 100000, 5);
+    auto ys = uniform_words(batch, 100000, 6);
+    std::vector<rns3<int32_t>> rx, ry;
+    std::vector<int32_t> ix(xs.begin(), xs.end()), iy(ys.begin(), ys.end());
+    for (std::size_t i = 0; i < batch; ++i) {
+        rx.push_back(rns3<int32_t>::from_integer(ix[i]));
+        ry.push_back(rns3<int32_t>::from_integer(iy[i]));
+    }
+
+    s.run("rns", "baseline_int64_multiply", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) {
+            do_not_optimize(static_cast<std::int64_t>(ix[i]) * iy[i]);
+        }
+    });
+    s.run("rns", "rns3_multiply", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) do_not_optimize(rx[i] * ry[i]);
+    });
+    s.run("rns", "rns3_from_integer", batch, [&] {
+        for (int32_t v : ix) do_not_optimize(rns3<int32_t>::from_integer(v));
+    });
+    s.run("rns", "rns3_to_integer", batch, [&] {
+        for (const auto& r : rx) do_not_optimize(r.to_integer());
+    });
+    s.run("rns", "rns3_compare", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) do_not_optimize(rx[i].compare(ry[i]));
+    });
+
+    auto ax = rns_array<int32_t, 3>::from_integers(ix);
+    auto ay = rns_array<int32_t, 3>::from_integers(iy);
+    s.run("rns_array", "multiply", batch, [&] {
+        auto product = ax * ay;
+        do_not_optimize(product.channel(0).data());
+    });
+    s.run("rns_array", "dot", batch, [&] {
+        do_not_optimize(dot(ax, ay));
+    });
+}
+
+void bench_modular(bench::suite& s) {
+    auto xs = uniform_words(batch, 1000000007u, 7);
+    std::vector<mod_prime> mx;
+    std::vector<mod_goldilocks> gx;
+    for (auto x : xs) {
+        mx.emplace_back(static_cast<int>(x));
+        gx.emplace_back(static_cast<std::uint64_t>(x) * 2654435761u);
+    }
+
+    s.run("modular", "baseline_percent_multiply", batch, [&] {
+        std::uint64_t acc = 1;
+        for (auto x : xs) acc = acc * x % 1000000007u;
+        do_not_optimize(acc);
+    });
+    s.run("modular", "montgomery32_multiply", batch, [&] {
+        mod_prime acc(1);
+        for (const auto& x : mx) acc = acc * x;
+        do_not_optimize(acc);
+    });
+    s.run("modular", "goldilocks_multiply", batch, [&] {
+        mod_goldilocks acc(1);
+        for (const auto& x : gx) acc = acc * x;
+        do_not_optimize(acc);
+    });
+    s.run("modular", "pow_1e9", 1, [&] {
+        do_not_optimize(mx[0].pow(1000000000));
+    });
+    s.run("modular", "inverse", 1, [&] {
+        do_not_optimize(mx[1].inverse());
+    });
+}
+
+void bench_ntt(bench::suite& s) {
+    using F = modular<std::uint32_t, 998244353u>;
+    auto xs = uniform_words(batch, 998244353u, 8);
+    std::vector<F> a, b;
+    for (std::size_t i = 0; i < batch; ++i) {
+        a.emplace_back(xs[i]);
+        b.emplace_back(xs[batch - 1 - i]);
+    }
+    ntt998 plan(2 * batch);
+    std::vector<F> buffer(2 * batch);
+
+    s.run("ntt", "forward_8192", 1, [&] {
+        std::copy(a.begin(), a.end(), buffer.begin());
+        plan.forward(buffer);
+        do_not_optimize(buffer.data());
+    });
+    // Twiddles from the compile-time root ladder, no pow() per stage
+    s.run("ntt", "plan_8192", 1, [&] {
+        ntt998 fresh(2 * batch);
+        do_not_optimize(fresh.size());
+    });
+    s.run("ntt", "convolve_4096x4096", 1, [&] {
+        do_not_optimize(ntt_convolve(a, b).data());
+    });
+    std::vector<F> small_a(a.begin(), a.begin() + 512), small_b(b.begin(), b.begin() + 512);
+    s.run("ntt", "baseline_schoolbook_512x512", 1, [&] {
+        std::vector<F> result(1023);
+        for (std::size_t i = 0; i < 512; ++i)
+            for (std::size_t j = 0; j < 512; ++j) result[i + j] = result[i + j] + small_a[i] * small_b[j];
+        do_not_optimize(result.data());
+    });
+    s.run("ntt", "convolve_512x512", 1, [&] {
+        do_not_optimize(ntt_convolve(small_a, small_b).data());
+    });
+}
+
+void bench_multiscale(bench::suite& s) {
+    auto large = uniform_doubles(batch, 1e90, 1e100, 9);
+    auto small = uniform_doubles(batch, 1e-100, 1e-90, 10);
+    std::vector<multiscale<double>> ml, ms;
+    for (std::size_t i = 0; i < batch; ++i) {
+        ml.emplace_back(large[i]);
+        ms.emplace_back(small[i]);
+    }
+
+    s.run("multiscale", "baseline_double_divide", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) do_not_optimize(large[i] / small[i]);
+    });
+    s.run("multiscale", "divide", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) do_not_optimize(ml[i] / ms[i]);
+    });
+    s.run("multiscale", "multiply", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) do_not_optimize(ml[i] * ms[i]);
+    });
+    s.run("multiscale", "construct", batch, [&] {
+        for (double v : large) do_not_optimize(multiscale<double>(v));
+    });
+}
+
+void bench_stern_brocot(bench::suite& s) {
+    auto xs = uniform_doubles(256, 0.0, 10.0, 11);
+    s.run("stern_brocot", "approximate_den_1e6", xs.size(), [&] {
+        for (double x : xs) do_not_optimize(stern_brocot<long long>::approximate(x, 1000000));
+    });
+    s.run("stern_brocot", "approximate_many_den_1e6", xs.size(), [&] {
+        do_not_optimize(stern_brocot<long long>::approximate_many(xs, 1000000));
+    });
+
+    // Order-preserving path keys for 256 rationals with denominators ≤ 10⁶
+    auto keyed = stern_brocot<long long>::approximate_many(xs, 1000000);
+    s.run("stern_brocot", "encode_path", keyed.size(), [&] {
+        unsigned char key[stern_brocot<long long>::path_key_capacity];
+        for (const auto& r : keyed) do_not_optimize(r.encode_path(key));
+    });
+    s.run("stern_brocot", "continued_fraction_inline", keyed.size(), [&] {
+        for (const auto& r : keyed) do_not_optimize(r.to_continued_fraction_inline().size());
+    });
+    s.run("stern_brocot", "continued_fraction_vector", keyed.size(), [&] {
+        for (const auto& r : keyed) do_not_optimize(r.to_continued_fraction().size());
+    });
+    const stern_brocot<long long> a(355, 113), b(22, 7);
+    s.run("stern_brocot", "add", 1, [&] { do_not_optimize(a + b); });
+    s.run("stern_brocot", "multiply", 1, [&] { do_not_optimize(a * b); });
+
+    // Denominators near 3·10⁹: cross products need the 128-bit intermediates
+    const stern_brocot<long long> c(1, 3000000019LL), d(2, 3000000037LL);
+    s.run("stern_brocot", "add_large_denominators", 1, [&] { do_not_optimize(c + d); });
+    s.run("stern_brocot", "compare_large_denominators", 1, [&] { do_not_optimize(c < d); });
+
+    // 10⁵ price-like rationals: eager left fold versus lazy tree-wise sum
+    std::vector<stern_brocot<long long>> prices;
+    {
+        const long long dens[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 25, 100, 360, 1000};
+        auto numerators = uniform_words(100000, 2001, 13);
+        auto picks = uniform_words(100000, 16, 14);
+        for (std::size_t i = 0; i < numerators.size(); ++i) {
+            prices.emplace_back(static_cast<long long>(numerators[i]) - 1000, dens[picks[i]]);
+        }
+    }
+    s.run("stern_brocot", "sum_1e5_eager_fold", prices.size(), [&] {
+        stern_brocot<long long> total;
+        for (const auto& p : prices) total = total + p;
+        do_not_optimize(total);
+    });
+    s.run("stern_brocot", "sum_1e5_lazy_tree", prices.size(), [&] {
+        do_not_optimize(stern_brocot_lazy<long long>::sum(prices));
+    });
+
+    // Same small operands on the big_integer backend (inline, no allocation)
+    const stern_brocot<big_integer> ba(355, 113), bb(22, 7);
+    s.run("stern_brocot", "big_integer_add_small", 1, [&] { do_not_optimize(ba + bb); });
+    s.run("stern_brocot", "big_integer_multiply_small", 1, [&] { do_not_optimize(ba * bb); });
+    s.run("stern_brocot", "big_integer_harmonic_100", 100, [&] {
+        stern_brocot<big_integer> h;
+        for (int i = 1; i <= 100; ++i) h = h + stern_brocot<big_integer>(1, i);
+        do_not_optimize(h);
+    });
+}
+
+void bench_dual_interval(bench::suite& s) {
+    auto xs = uniform_doubles(batch, 0.5, 2.0, 12);
+
+    s.run("dual", "baseline_sin_and_cos", batch, [&] {
+        for (double x : xs) {
+            do_not_optimize(std::sin(x * x));
+            do_not_optimize(2 * x * std::cos(x * x));
+        }
+    });
+    s.run("dual", "derivative_sin_x_squared", batch, [&] {
+        for (double x : xs) {
+            auto v = dual<double>::variable(x);
+            do_not_optimize(sin(v * v));
+        }
+    });
+
+    // 32-parameter gradient: 32 scalar-dual passes versus one dual_vec pass
+    std::vector<double> params(xs.begin(), xs.begin() + 32);
+    auto model = [](const auto& p) {
+        using V = typename std::decay_t<decltype(p)>::value_type;
+        V acc = 0.0;
+        for (std::size_t i = 0; i + 1 < p.size(); ++i) acc = acc + sin(p[i] * p[i + 1]) + exp(p[i]) / p[i + 1];
+        return acc;
+    };
+    s.run("dual", "gradient_32_scalar_passes", 1, [&] {
+        std::vector<dual<double>> in(params.size());
+        for (std::size_t d = 0; d < params.size(); ++d) {
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                in[i] = dual<double>(params[i], i == d ? 1.0 : 0.0);
+            }
+            do_not_optimize(model(in).derivative());
+        }
+    });
+    s.run("dual", "gradient_32_dual_vec", 1, [&] {
+        do_not_optimize(gradient<32>(model, params));
+    });
+
+    // 4096-input loss: one recording plus one reverse sweep, arena reused
+    tape<double> t;
+    std::vector<adjoint<double>> weights;
+    for (double x : xs) weights.push_back(t.variable(x));
+    const auto after_inputs = t.checkpoint();
+    s.run("adjoint", "baseline_loss_value_4096", batch, [&] {
+        double loss = 0;
+        for (std::size_t i = 0; i + 1 < xs.size(); ++i) loss += std::sin(xs[i] * xs[i + 1]);
+        do_not_optimize(loss);
+    });
+    s.run("adjoint", "gradient_4096_inputs", batch, [&] {
+        t.rewind(after_inputs);
+        adjoint<double> loss = 0.0;
+        for (std::size_t i = 0; i + 1 < weights.size(); ++i) loss += sin(weights[i] * weights[i + 1]);
+        do_not_optimize(t.gradient(loss));
+    });
+    s.run("adjoint", "hessian_vector_4096_inputs", batch, [&] {
+        t.rewind(after_inputs);
+        adjoint<double> loss = 0.0;
+        for (std::size_t i = 0; i + 1 < weights.size(); ++i) loss += sin(weights[i] * weights[i + 1]);
+        do_not_optimize(t.hessian_vector(loss, xs));
+    });
+
+    s.run("interval", "baseline_double_multiply", batch, [&] {
+        for (std::size_t i = 1; i < batch; ++i) do_not_optimize(xs[i - 1] * xs[i]);
+    });
+    s.run("interval", "multiply", batch, [&] {
+        for (std::size_t i = 1; i < batch; ++i) {
+            do_not_optimize(interval<double>(xs[i - 1], xs[i - 1] + 0.1) *
+                            interval<double>(-xs[i], xs[i]));
+        }
+    });
+    std::vector<double> widened(xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) widened[i] = xs[i] + 0.1;
+    interval_array<double> boxes(xs, widened);
+    s.run("interval", "array_multiply", batch, [&] { do_not_optimize(boxes * boxes); });
+    s.run("interval", "array_sum", batch, [&] { do_not_optimize(boxes.sum()); });
+
+    // Six-hump camel to a 1e-3 box tolerance, reported per examined box
+    using I = interval<double>;
+    auto camel = [](const auto& x) {
+        I x2 = x[0] * x[0], y2 = x[1] * x[1];
+        return (I(4.0) - I(2.1) * x2 + x2 * x2 / I(3.0)) * x2 + x[0] * x[1] +
+               (I(-4.0) + I(4.0) * y2) * y2;
+    };
+    bnb_options<double> options;
+    options.threads = 1;
+    options.box_tolerance = 1e-3;
+    const interval_bnb<double> solver({I(-3.0, 3.0), I(-2.0, 2.0)}, options);
+    const std::size_t camel_boxes = solver.minimize(camel).stats.boxes;
+    s.run("interval_bnb", "camel_2d_per_box", camel_boxes, [&] { do_not_optimize(solver.minimize(camel)); });
+}
+
+void bench_tropical(bench::suite& s) {
+    const std::size_t n = 256;
+    std::mt19937 gen(bench::seed + 13);
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    tropical_matrix_dyn<double> dense(n);
+    std::vector<tropical_edge<double>> edges;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            if (gen() % 8 == 0) dense.set(i, j, weight(gen));
+        }
+    }
+    s.run("tropical", "min_plus_gemm_256_serial", n * n * n, [&] {
+        do_not_optimize(dense.multiply(dense, 1).data());
+    });
+    s.run("tropical", "min_plus_gemm_256_threads", n * n * n, [&] {
+        do_not_optimize(dense.multiply(dense).data());
+    });
+
+    const std::size_t vertices = 100000;
+    for (std::size_t e = 0; e < 8 * vertices; ++e) {
+        edges.push_back({gen() % vertices, gen() % vertices, weight(gen)});
+    }
+    tropical_sparse_matrix<tropical_min<double>> sparse(vertices, edges);
+    std::vector<double> x(vertices, 1.0);
+    s.run("tropical", "spmv_100k_800k", edges.size(), [&] {
+        do_not_optimize(sparse.multiply(x).data());
+    });
+    s.run("tropical", "bellman_ford_100k", edges.size(), [&] {
+        do_not_optimize(sparse.bellman_ford(0).data());
+    });
+    s.run("tropical", "delta_stepping_100k", edges.size(), [&] {
+        do_not_optimize(delta_stepping(sparse, 0, 2.0).data());
+    });
+}
+
+void bench_hmm(bench::suite& s) {
+    // One frame per call; throughput per transition relaxed
+    const std::size_t n = 512;
+    auto weights = uniform_doubles(n * n, -12.0, -1.0, 32);
+    std::vector<tropical_max<double>> log_a;
+    for (double w : weights) log_a.emplace_back(w);
+    auto dense = hmm_transitions<double>::from_dense(n, log_a);
+    std::vector<tropical_edge<double>> edges;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = 0; k < 8; ++k) edges.push_back({i, (i * 31 + k * 97) % n, weights[i * 8 + k]});
+    }
+    auto sparse = hmm_transitions<double>::from_sparse(tropical_sparse_matrix<tropical_max<double>>(n, edges));
+    auto scores = uniform_doubles(n, -6.0, 0.0, 33);
+    std::vector<tropical_max<double>> emission, initial(n, tropical_max<double>(0.0));
+    std::vector<lgd> lg_emission, lg_initial(n, lgd(1.0));
+    for (double e : scores) {
+        emission.emplace_back(e);
+        lg_emission.push_back(lgd::from_log(e));
+    }
+
+    viterbi_decoder<double> viterbi_dense(dense, initial), viterbi_sparse(sparse, initial);
+    viterbi_decoder<double> viterbi_beam(dense, initial, viterbi_options<double>{6.0, 64, 0});
+    hmm_forward<double> forward_dense(dense, lg_initial);
+    s.run("hmm", "viterbi_dense_512", n * n, [&] { viterbi_dense.step(emission); viterbi_dense.take_committed(); });
+    s.run("hmm", "viterbi_dense_512_beam6", n * n, [&] { viterbi_beam.step(emission); viterbi_beam.take_committed(); });
+    s.run("hmm", "viterbi_sparse_512x8", edges.size(), [&] { viterbi_sparse.step(emission); viterbi_sparse.take_committed(); });
+    s.run("hmm", "forward_dense_512", n * n, [&] { forward_dense.step(lg_emission); });
+}
+
+void bench_quaternion(bench::suite& s) {
+    auto angles = uniform_doubles(batch, 0.0, 3.0, 14);
+    std::vector<quaternion<double>> qs;
+    for (double a : angles) qs.push_back(quaternion<double>::from_axis_angle(0.0, 0.6, 0.8, a));
+
+    s.run("quaternion", "multiply", batch, [&] {
+        auto acc = quaternion<double>::identity();
+        for (const auto& q : qs) acc = acc * q;
+        do_not_optimize(acc);
+    });
+    s.run("quaternion", "rotate", batch, [&] {
+        for (const auto& q : qs) do_not_optimize(q.rotate(1.0, 2.0, 3.0));
+    });
+    s.run("quaternion", "slerp", batch, [&] {
+        for (std::size_t i = 1; i < batch; ++i) do_not_optimize(qs[i - 1].slerp(qs[i], 0.3));
+    });
+
+    // One rotation applied to a point cloud: per-point rotate vs SoA matrix
+    auto coords = uniform_doubles(3 * batch, -1.0, 1.0, 15);
+    std::vector<std::array<double, 3>> points(batch);
+    for (std::size_t i = 0; i < batch; ++i) points[i] = {coords[3 * i], coords[3 * i + 1], coords[3 * i + 2]};
+    auto cloud = vec3_array<double>::from_points(points);
+    const auto& q = qs[batch / 2];
+    s.run("quaternion", "rotate_points_scalar", batch, [&] {
+        for (const auto& p : points) do_not_optimize(q.rotate(p[0], p[1], p[2]));
+    });
+    s.run("quaternion", "rotate_points_array", batch, [&] {
+        cloud.rotate(q);
+        do_not_optimize(cloud);
+    });
+    auto orientations = quaternion_array<double>::from_quaternions(qs);
+    s.run("quaternion", "rotate_paired_array", batch, [&] { do_not_optimize(orientations.rotate(cloud)); });
+    s.run("quaternion", "slerp_paired_array", batch, [&] {
+        do_not_optimize(orientations.slerp(orientations * orientations, 0.3));
+    });
+    auto ts = uniform_doubles(batch, 0.0, 1.0, 16);
+    s.run("quaternion", "slerp_shared_endpoints", batch, [&] {
+        do_not_optimize(quaternion_array<double>::from_slerp(qs[0], qs[1], ts));
+    });
+    s.run("quaternion", "nlerp_shared_endpoints", batch, [&] {
+        do_not_optimize(quaternion_array<double>::from_nlerp(qs[0], qs[1], ts));
+    });
+}
+
+void bench_mappings(bench::suite& s) {
+    using namespace cbt::mappings;
+    auto logs = uniform_doubles(batch, -800.0, 800.0, 29);
+    std::vector<lgd> lgs;
+    for (double l : logs) lgs.push_back(lgd::from_log(l));
+    std::vector<multiscale<double>> scaled(batch);
+    std::vector<lgd> back(batch);
+    std::vector<tropical_min<double>> tropical(batch);
+
+    s.run("mappings", "lg_to_multiscale", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) scaled[i] = lg_to_multiscale(lgs[i]);
+        do_not_optimize(scaled.data());
+    });
+    s.run("mappings", "convert_batch_lg_to_multiscale", batch, [&] {
+        convert_batch(span<const lgd>(lgs), span<multiscale<double>>(scaled));
+        do_not_optimize(scaled.data());
+    });
+    s.run("mappings", "convert_batch_multiscale_to_lg", batch, [&] {
+        convert_batch(span<const multiscale<double>>(scaled), span<lgd>(back));
+        do_not_optimize(back.data());
+    });
+    s.run("mappings", "convert_batch_lg_to_tropical_min", batch, [&] {
+        convert_batch(span<const lgd>(lgs), span<tropical_min<double>>(tropical));
+        do_not_optimize(tropical.data());
+    });
+    s.run("mappings", "convert_batch_tropical_min_to_lg", batch, [&] {
+        convert_batch(span<const tropical_min<double>>(tropical), span<lgd>(back));
+        do_not_optimize(back.data());
+    });
+    // Two hops (tropical_min → lg → multiscale) fused per element
+    s.run("mappings", "convert_batch_tropical_min_to_multiscale", batch, [&] {
+        convert_batch(span<const tropical_min<double>>(tropical), span<multiscale<double>>(scaled));
+        do_not_optimize(scaled.data());
+    });
+}
+
+void bench_adaptive(bench::suite& s) {
+    // Two batched multiplies per run (factors, then their reciprocals) so
+    // the values stay put: the adaptive array against the representation
+    // it should settle on, near 1 and far outside the range of double
+    auto factors = uniform_doubles(batch, 0.5, 2.0, 35);
+    std::vector<double> inverses(batch);
+    for (std::size_t i = 0; i < batch; ++i) inverses[i] = 1 / factors[i];
+    const auto policy = adaptive_policy<double>::defaults();
+    std::vector<double> plain(batch, 1.0);
+    s.run("adaptive", "near_one_plain", 2 * batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) plain[i] *= factors[i];
+        for (std::size_t i = 0; i < batch; ++i) plain[i] *= inverses[i];
+        do_not_optimize(plain.data());
+    });
+    auto near_one = adaptive_array<double>::from_values(std::vector<double>(batch, 1.0), policy);
+    s.run("adaptive", "near_one_adaptive", 2 * batch, [&] {
+        near_one.multiply(factors);
+        near_one.multiply(inverses);
+        do_not_optimize(near_one.profile());
+    });
+    std::vector<double> wide_start(batch, 1e-300);
+    lg_vector<double> logs(wide_start);
+    s.run("adaptive", "wide_lg", 2 * batch, [&] {
+        logs = logs * lg_vector<double>(factors);
+        logs = logs * lg_vector<double>(inverses);
+        do_not_optimize(logs.data());
+    });
+    auto wide = adaptive_array<double>::from_values(wide_start, policy);
+    s.run("adaptive", "wide_adaptive", 2 * batch, [&] {
+        wide.multiply(factors);
+        wide.multiply(inverses);
+        do_not_optimize(wide.profile());
+    });
+    s.run("adaptive", "calibrate", 1, [&] { do_not_optimize(adaptive_policy<double>::calibrate(1024, 1)); });
+}
+
+void bench_instrumentation(bench::suite& s) {
+    // Cost of an enabled hook (the disabled policy compiles to nothing)
+    using live = instrumentation::policy<true>;
+    s.run("instrumentation", "count_enabled", batch, [&] {
+        for (std::size_t i = 0; i < batch; ++i) live::count(instrumentation::counter::lg_ops);
+    });
+    s.run("instrumentation", "snapshot", 1, [&] {
+        do_not_optimize(live::snapshot().values[0]);
+    });
+}
+
+void bench_parallel(bench::suite& s) {
+    // Same fixed tree on one thread and on the shared pool
+    const std::size_t n = 1 << 20;
+    auto probs = uniform_doubles(n, 1e-3, 1.0, 30);
+    std::vector<lgd> lgs;
+    for (double p : probs) lgs.push_back(lgd(p));
+    s.run("parallel", "lg_product_inline", n, [&] {
+        do_not_optimize(parallel_reduce(lgs, std::multiplies<>(), inline_executor()));
+    });
+    s.run("parallel", "lg_product_pool", n, [&] {
+        do_not_optimize(parallel_reduce(lgs, std::multiplies<>()));
+    });
+    auto angles = uniform_doubles(n, 0.0, 3.0, 31);
+    std::vector<quaternion<double>> qs;
+    for (double a : angles) qs.push_back(quaternion<double>::from_axis_angle(0.0, 0.6, 0.8, a));
+    std::vector<quaternion<double>> prefix(n);
+    s.run("parallel", "quaternion_scan_pool", n, [&] {
+        parallel_inclusive_scan(span<const quaternion<double>>(qs), span<quaternion<double>>(prefix), std::multiplies<>());
+        do_not_optimize(prefix.data());
+    });
+    thread_pool pool;
+    s.run("parallel", "bulk_overhead", 64, [&] {
+        pool.bulk(64, [&](std::size_t i) { do_not_optimize(i); });
+    });
+}
+
+void bench_serialization(bench::suite& s) {
+    // Mapping a saved table vs transforming the raw values again; each
+    // variant then reads every element once (page cache warm)
+    const std::size_t n = 1 << 20;
+    const std::string path = std::filesystem::temp_directory_path() / "cbt_bench_serialization.cbt";
+    auto probs = uniform_doubles(n, 1e-300, 1.0, 34);
+    lg_vector<double> logs(probs);
+    s.run("serialization", "lg_save", n, [&] { save_array(path, logs); });
+    s.run("serialization", "lg_retransform", n, [&] {
+        lg_vector<double> fresh(probs);
+        do_not_optimize(fresh.product());
+    });
+    s.run("serialization", "lg_map", n, [&] {
+        mapped_lg_vector<double> mapped(path);
+        do_not_optimize(reduce_product(mapped));
+    });
+    auto ms = multiscale_array<double, 3>::from_values(probs);
+    save_array(path, ms);
+    s.run("serialization", "multiscale_retransform", n, [&] {
+        do_not_optimize(multiscale_array<double, 3>::from_values(probs).sum());
+    });
+    s.run("serialization", "multiscale_map_copy", n, [&] {
+        mapped_multiscale_array<double, 3> mapped(path);
+        do_not_optimize(mapped.to_array().sum());
+    });
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::suite s(bench::suite::parse(argc, argv));
+    bench_logarithmic(s);
+    bench_odds_ratio(s);
+    bench_log_odds_scorer(s);
+    bench_rns(s);
+    bench_modular(s);
+    bench_ntt(s);
+    bench_multiscale(s);
+    bench_stern_brocot(s);
+    bench_dual_interval(s);
+    bench_tropical(s);
+    bench_hmm(s);
+    bench_quaternion(s);
+    bench_mappings(s);
+    bench_adaptive(s);
+    bench_instrumentation(s);
+    bench_parallel(s);
+    bench_serialization(s);
+    return s.finish();
+}
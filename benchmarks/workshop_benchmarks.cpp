@@ -1,5 +1,8 @@
 // Benchmarks for CBT Workshop Paper
-// Compile: g++ -std=c++17 -O3 -march=native workshop_benchmarks.cpp -o workshop_benchmarks
+// Build: cmake -S . -B build -DCBT_BUILD_BENCHMARKS=ON && cmake --build build --target cbt_workshop_benchmarks
+//
+// Narrative end-to-end scenarios; per-operation numbers with variance and
+// JSON output come from cbt_benchmarks (transform_benchmarks.cpp).
 
 #include <iostream>
 #include <chrono>
@@ -12,17 +15,18 @@
 #include "../include/cbt/odds_ratio.hpp"
 #include "../include/cbt/residue_number_system.hpp"
 #include "../include/cbt/multiscale.hpp"
+#include "bench.hpp"
 
 using namespace std::chrono;
 using namespace cbt;
 
-// Timer utility
+// Timer utility (monotonic, sub-microsecond resolution)
 class Timer {
-    high_resolution_clock::time_point start;
+    steady_clock::time_point start;
 public:
-    Timer() : start(high_resolution_clock::now()) {}
+    Timer() : start(steady_clock::now()) {}
     double elapsed_ms() {
-        return duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+        return duration<double, std::milli>(steady_clock::now() - start).count();
     }
 };
 
@@ -32,8 +36,7 @@ void benchmark_logarithmic() {
     const int N = 1000000;
 
     // Generate small probabilities
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(bench::seed + 1);
     std::uniform_real_distribution<> dis(1e-11, 1e-9);
 
     std::vector<double> values(N);
@@ -65,7 +68,7 @@ void benchmark_logarithmic() {
         double time = t.elapsed_ms();
         std::cout << "Logarithmic transform: Completed " << N << " multiplications" << std::endl;
         std::cout << "Logarithmic time: " << time << "ms" << std::endl;
-        std::cout << "Final value (log space): " << product.log_value() << std::endl;
+        std::cout << "Final value (log space): " << product.log() << std::endl;
     }
 }
 
@@ -75,13 +78,14 @@ void benchmark_odds_ratio() {
     const int N = 1000000;
 
     // Generate likelihood ratios
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(bench::seed + 2);
     std::uniform_real_distribution<> dis(0.1, 10.0);
 
     std::vector<double> likelihood_ratios(N);
     for (auto& lr : likelihood_ratios) lr = dis(gen);
 
+    double baseline_time = 0;
+
     // Baseline: Probability space with normalization
     {
         Timer t;
@@ -93,6 +97,7 @@ void benchmark_odds_ratio() {
             prob = odds / (1 + odds); // Normalization required
         }
         double time = t.elapsed_ms();
+        baseline_time = time;
         std::cout << "Probability space with normalization: " << time << "ms" << std::endl;
         std::cout << "Final probability: " << prob << std::endl;
     }
@@ -102,14 +107,13 @@ void benchmark_odds_ratio() {
         Timer t;
         auto odds = odds_ratio<double>::from_probability(0.01);
         for (const auto& lr : likelihood_ratios) {
-            odds = odds * lr; // Simple multiplication, no normalization
+            odds = odds * odds_ratio<double>(lr); // Simple multiplication, no normalization
         }
         double time = t.elapsed_ms();
         std::cout << "Odds-ratio transform: " << time << "ms" << std::endl;
         std::cout << "Final probability: " << odds.to_probability() << std::endl;
 
-        // Calculate speedup
-        double baseline_time = 124.0; // From previous run
+        // Calculate speedup against the baseline measured above
         std::cout << "Speedup: " << (baseline_time / time) << "×" << std::endl;
     }
 }
@@ -120,13 +124,14 @@ void benchmark_inter_domain_mapping() {
     const int N = 100000;
 
     // Scenario: Convert from log domain to odds-ratio domain directly
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(bench::seed + 3);
     std::uniform_real_distribution<> dis(-10, -1);
 
     std::vector<double> log_probs(N);
     for (auto& lp : log_probs) lp = dis(gen);
 
+    double baseline_time = 0;
+
     // Method 1: Via baseline domain (log -> prob -> odds)
     {
         Timer t;
@@ -137,12 +142,13 @@ void benchmark_inter_domain_mapping() {
             results.push_back(odds_ratio<double>::from_probability(prob));
         }
         double time = t.elapsed_ms();
+        baseline_time = time;
         std::cout << "Via baseline (log->prob->odds): " << time << "ms" << std::endl;
 
         // Check for overflow/underflow issues
         int underflows = 0;
         for (const auto& r : results) {
-            if (r.odds_value() == 0.0 || std::isinf(r.odds_value())) {
+            if (r.value() == 0.0 || std::isinf(r.value())) {
                 underflows++;
             }
         }
@@ -158,7 +164,7 @@ void benchmark_inter_domain_mapping() {
             // When p is small: log(1-p) ≈ 0, so odds ≈ exp(log_p)
             // This avoids the exp() overflow for very small probabilities
             double log_odds = lp - std::log1p(-std::exp(lp));
-            results.push_back(odds_ratio<double>::from_log_odds(log_odds));
+            results.push_back(odds_ratio<double>(std::exp(log_odds)));
         }
         double time = t.elapsed_ms();
         std::cout << "Direct mapping (log->odds): " << time << "ms" << std::endl;
@@ -166,14 +172,13 @@ void benchmark_inter_domain_mapping() {
         // Check for overflow/underflow issues
         int issues = 0;
         for (const auto& r : results) {
-            if (r.odds_value() == 0.0 || std::isinf(r.odds_value())) {
+            if (r.value() == 0.0 || std::isinf(r.value())) {
                 issues++;
             }
         }
         std::cout << "Numerical issues: " << issues << " values" << std::endl;
 
-        // Show speedup
-        double baseline_time = 45.0; // From previous run
+        // Show speedup against the baseline measured above
         std::cout << "Speedup: " << (baseline_time / time) << "×" << std::endl;
     }
 }
@@ -184,8 +189,7 @@ void benchmark_rns() {
     const int N = 1000000;
 
     // Generate random integers
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(bench::seed + 4);
     std::uniform_int_distribution<int> dis(1, 1000000);
 
     std::vector<int> values1(N), values2(N);
@@ -194,6 +198,8 @@ void benchmark_rns() {
         values2[i] = dis(gen);
     }
 
+    double baseline_time = 0;
+
     // Baseline: Standard arithmetic
     {
         Timer t;
@@ -202,6 +208,8 @@ void benchmark_rns() {
             results[i] = static_cast<long long>(values1[i]) * values2[i];
         }
         double time = t.elapsed_ms();
+        baseline_time = time;
+        bench::do_not_optimize(results.data());
         std::cout << "Standard arithmetic: " << time << "ms" << std::endl;
     }
 
@@ -217,9 +225,10 @@ void benchmark_rns() {
         double time = t.elapsed_ms();
         std::cout << "RNS arithmetic: " << time << "ms" << std::endl;
 
-        // Calculate speedup
-        double baseline_time = 89.0; // Typical value
-        std::cout << "Speedup potential (with hardware): " << (baseline_time / time) << "×" << std::endl;
+        bench::do_not_optimize(rns_results.data());
+
+        // Relative cost against the baseline measured above
+        std::cout << "Speedup: " << (baseline_time / time) << "×" << std::endl;
     }
 }
 
@@ -229,8 +238,7 @@ void benchmark_multiscale() {
     const int N = 10000;
 
     // Generate values with extreme ranges
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(bench::seed + 5);
     std::uniform_real_distribution<> small_dis(1e-100, 1e-90);
     std::uniform_real_distribution<> large_dis(1e90, 1e100);
 
@@ -262,7 +270,7 @@ void benchmark_multiscale() {
             multiscale<double> a(large_values[i]);
             multiscale<double> b(small_values[i]);
             auto result = a / b;
-            if (!std::isinf(result.to_standard()) && result.to_standard() != 0.0) {
+            if (!std::isinf(result.to_value()) && result.to_value() != 0.0) {
                 successful++;
             }
         }
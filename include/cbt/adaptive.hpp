@@ -0,0 +1,564 @@
+/**
+ * Adaptive Arrays - Choosing plain, lg or multiscale Storage per Workload
+ *
+ * Transform: stream of batches → whichever of T, lg<T>, multiscale<T> is
+ *            cheapest among those that can hold the next result
+ *
+ * adaptive_array<T> holds one representation at a time and re-decides at
+ * every batch boundary (each multiply() or add() of a whole batch). The
+ * selector sees an adaptive_profile: the binary exponent range and sign of
+ * the contents, the range the batch's result will have, and the recent mix
+ * of multiplies and additions. Representations that cannot hold the result
+ * are excluded:
+ *   - plain while every |log₂ x| stays within max_exponent / 2, so a
+ *     product of two in-range values cannot overflow or lose precision
+ *     to subnormals
+ *   - lg only without negative values
+ *   - multiscale while log₂|x| stays within its levels, about 10^±381
+ *     at SCALE_FACTOR 3 (beyond them it saturates or flushes to 0)
+ * and the cheapest of the rest, by per-element costs in adaptive_policy,
+ * wins; a batch no representation holds throws std::overflow_error. The incumbent is kept unless it is unsafe or slower than the best
+ * by more than switch_margin, so a stream near the threshold does not flap.
+ * Switches convert the whole array in one pass: plain ↔ lg and
+ * plain ↔ multiscale through the containers' batch transforms, lg ↔
+ * multiscale through mappings::convert_batch, which never forms the real
+ * number. Each switch counts instrumentation::counter::adaptive_switches.
+ *
+ * The costs come from adaptive_policy::calibrated(), which times the same
+ * kernels the arrays run, once per process on first use; defaults() are
+ * its figures on x86-64, for when timing at startup is unwanted.
+ *
+ * Trade-off:
+ *   Gain: Streams that stay near 1 run at plain-T speed; streams that
+ *         drift by hundreds of orders of magnitude move to lg or multiscale
+ *         before they overflow, with no change to the calling code
+ *   Loss: An extra streaming pass per batch for its range (plus a rescan of
+ *         the contents outside plain), a conversion pass per switch, and
+ *         one batch of lookahead only: a single batch that overflows T by
+ *         itself is already out of range when it arrives
+ *
+ * Applications:
+ *   - Likelihood and weight accumulation whose range is unknown upfront
+ *   - Libraries that must be fast on typical data and correct on extremes
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "instrumentation.hpp"
+#include "lg_vector.hpp"
+#include "logarithmic.hpp"
+#include "mappings.hpp"
+#include "multiscale.hpp"
+#include "multiscale_array.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+enum class adaptive_representation : std::uint8_t { plain, lg, multiscale };
+
+constexpr std::size_t adaptive_representation_count = 3;
+
+constexpr const char* name(adaptive_representation r) {
+    constexpr const char* names[adaptive_representation_count] = {"plain", "lg", "multiscale"};
+    return names[static_cast<std::size_t>(r)];
+}
+
+/// @brief What the selector sees at a batch boundary
+struct adaptive_profile {
+    double min_log2 = std::numeric_limits<double>::infinity();    ///< lower bound of log₂|x| over nonzero x
+    double max_log2 = -std::numeric_limits<double>::infinity();   ///< upper bound of log₂|x|
+    bool negative = false;
+    double multiplies = 0;   ///< recent elementwise multiplies, halved every batch
+    double additions = 0;    ///< recent elementwise additions, halved every batch
+
+    /// No nonzero values (every representation holds the result exactly)
+    bool all_zero() const { return max_log2 < min_log2; }
+};
+
+namespace detail {
+
+/// Top 32 bits of x: sign, exponent and leading mantissa bits
+template<typename T>
+std::uint32_t top_word(T x) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "top_word needs float or double");
+    if constexpr (sizeof(T) == 8) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return static_cast<std::uint32_t>(bits >> 32);
+    } else {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+}
+
+/// Exponent bounds and sign of plain values from their bit patterns:
+/// |x| orders like its sign-cleared top word, and integer min/max
+/// reductions vectorize even where floating-point selects do not (SSE2).
+/// Bounds are whole binades; words of 0 (zero, the tiniest subnormals)
+/// count as zero, and ∞ / NaN exceed every finite limit.
+template<typename T>
+adaptive_profile adaptive_range(span<const T> values) {
+    constexpr int word_mantissa_bits = std::numeric_limits<T>::digits - 1 - (sizeof(T) == 8 ? 32 : 0);
+    constexpr int bias = std::numeric_limits<T>::max_exponent - 1;
+    std::int32_t largest = 0, smallest = 0x7FFFFFFF;
+    std::uint32_t signs = 0;
+    const T* x = values.data();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        std::uint32_t word = top_word(x[i]);
+        std::int32_t magnitude = static_cast<std::int32_t>(word & 0x7FFFFFFFu);
+        std::uint32_t zero = 0u - static_cast<std::uint32_t>(magnitude == 0);   // all ones for zeros
+        largest = std::max(largest, magnitude);
+        smallest = std::min(smallest, magnitude | static_cast<std::int32_t>(zero & 0x7FFFFFFFu));
+        signs |= word & ~zero;
+    }
+    adaptive_profile range;
+    if (largest != 0) {
+        range.min_log2 = (smallest >> word_mantissa_bits) - bias;
+        range.max_log2 = (largest >> word_mantissa_bits) - bias + 1;
+    }
+    range.negative = (signs >> 31) != 0;
+    return range;
+}
+
+template<typename T>
+adaptive_profile adaptive_range(const lg_vector<T>& values) {
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    constexpr double log2_e = 1.442695040888963407359924681001892137;
+    T smallest = inf, largest = -inf;
+    const T* logs = values.data();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        largest = std::max(largest, logs[i]);
+        smallest = logs[i] > -inf ? std::min(smallest, logs[i]) : smallest;
+    }
+    adaptive_profile range;
+    if (largest > -inf) {
+        range.min_log2 = static_cast<double>(smallest) * log2_e;
+        range.max_log2 = static_cast<double>(largest) * log2_e;
+    }
+    return range;
+}
+
+/// Normalized mantissas lie in [1/SCALE, 1), so the levels bound log₂|x|
+template<typename T, int SCALE_FACTOR>
+adaptive_profile adaptive_range(const multiscale_array<T, SCALE_FACTOR>& values) {
+    constexpr double level_log2 = SCALE_FACTOR * 3.321928094887362347870319429489390175;
+    const T* m = values.mantissas().data();
+    const std::int8_t* s = values.scales().data();
+    int low = 128, high = -129;
+    T lowest = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        high = std::max(high, m[i] != 0 ? int(s[i]) : -129);
+        low = std::min(low, m[i] != 0 ? int(s[i]) : 128);
+        lowest = std::min(lowest, m[i]);
+    }
+    adaptive_profile range;
+    if (high >= low) {
+        range.min_log2 = (low - 1) * level_log2;
+        range.max_log2 = high * level_log2;
+    }
+    range.negative = lowest < 0;
+    return range;
+}
+
+inline void check_adaptive_size(std::size_t expected, std::size_t actual) {
+    if (expected != actual) {
+        throw std::invalid_argument("adaptive_array batch size must match the array");
+    }
+}
+
+// Elementwise kernels, one overload per representation
+
+template<typename T>
+void adaptive_multiply(std::vector<T>& values, span<const T> factors) {
+    T* dst = values.data();
+    for (std::size_t i = 0; i < values.size(); ++i) dst[i] *= factors[i];
+}
+
+template<typename T>
+void adaptive_add(std::vector<T>& values, span<const T> terms) {
+    T* dst = values.data();
+    for (std::size_t i = 0; i < values.size(); ++i) dst[i] += terms[i];
+}
+
+template<typename T>
+void adaptive_multiply(lg_vector<T>& values, span<const T> factors) {
+    values = values * lg_vector<T>(factors);
+}
+
+/// log(a + b) = max + log1p(exp(min - max)), with selects for -∞
+template<typename T>
+void adaptive_add(lg_vector<T>& values, span<const T> terms) {
+    constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+    T* dst = values.data();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        T t = terms[i];
+        T b = t > 0 ? std::log(t) : neg_inf;
+        T hi = std::max(dst[i], b);
+        T lo = std::min(dst[i], b);
+        T sum = hi + std::log1p(std::exp(lo - hi));
+        dst[i] = hi == neg_inf ? neg_inf : sum;
+    }
+}
+
+template<typename T, int SCALE_FACTOR>
+void adaptive_multiply(multiscale_array<T, SCALE_FACTOR>& values, span<const T> factors) {
+    values = values * multiscale_array<T, SCALE_FACTOR>::from_values(factors);
+}
+
+template<typename T, int SCALE_FACTOR>
+void adaptive_add(multiscale_array<T, SCALE_FACTOR>& values, span<const T> terms) {
+    values = values + multiscale_array<T, SCALE_FACTOR>::from_values(terms);
+}
+
+/// Best-of-repetitions time per element of kernel(container, batch)
+template<typename Container, typename Kernel, typename T>
+double adaptive_time(const Container& initial, span<const T> batch, int repetitions, Kernel kernel) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < repetitions; ++r) {
+        Container work = initial;
+        auto start = std::chrono::steady_clock::now();
+        kernel(work, batch);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / static_cast<double>(batch.size()));
+    }
+    return best;
+}
+
+} // namespace detail
+
+/**
+ * @brief Per-element costs and safety limits the selector works from
+ * @details Costs are nanoseconds per element, indexed by representation.
+ */
+template<typename T, int SCALE_FACTOR = 3>
+struct adaptive_policy {
+    std::array<double, adaptive_representation_count> multiply_cost;
+    std::array<double, adaptive_representation_count> add_cost;
+    double plain_exponent_limit = std::numeric_limits<T>::max_exponent / 2;   ///< plain needs |log₂ x| ≤ this
+    double switch_margin = 1.25;   ///< keep the incumbent unless the best is this much cheaper
+
+    /// log₂|x| the multiscale levels span: mantissas in [1/SCALE, 1) at levels -128 … 127
+    static constexpr double multiscale_log2_min = -129 * SCALE_FACTOR * 3.321928094887362347870319429489390175;
+    static constexpr double multiscale_log2_max = 127 * SCALE_FACTOR * 3.321928094887362347870319429489390175;
+
+    /// @brief calibrate() figures from an x86-64 SSE2 build, for skipping the timing
+    static adaptive_policy defaults() {
+        adaptive_policy policy;
+        policy.multiply_cost = {0.7, 8.0, 18.0};
+        policy.add_cost = {0.6, 36.0, 36.0};
+        return policy;
+    }
+
+    /// @brief Time every kernel on n elements on this machine
+    static adaptive_policy calibrate(std::size_t n = 4096, int repetitions = 5) {
+        if (n == 0 || repetitions <= 0) {
+            throw std::invalid_argument("adaptive_policy::calibrate needs elements and repetitions");
+        }
+        // Values in [0.5, 2): typical magnitudes, no special cases
+        std::vector<T> values(n), batch(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = T(0.5) + T(1.5) * static_cast<T>(std::fmod(0.6180339887 * static_cast<double>(i), 1.0));
+            batch[i] = T(0.5) + T(1.5) * static_cast<T>(std::fmod(0.4142135624 * static_cast<double>(i), 1.0));
+        }
+        const span<const T> b(batch);
+        const lg_vector<T> logs(values);
+        const auto scaled = multiscale_array<T, SCALE_FACTOR>::from_values(values);
+        auto multiply = [](auto& c, span<const T> x) { detail::adaptive_multiply(c, x); };
+        auto add = [](auto& c, span<const T> x) { detail::adaptive_add(c, x); };
+
+        adaptive_policy policy;
+        policy.multiply_cost = {detail::adaptive_time(values, b, repetitions, multiply),
+                                detail::adaptive_time(logs, b, repetitions, multiply),
+                                detail::adaptive_time(scaled, b, repetitions, multiply)};
+        policy.add_cost = {detail::adaptive_time(values, b, repetitions, add),
+                           detail::adaptive_time(logs, b, repetitions, add),
+                           detail::adaptive_time(scaled, b, repetitions, add)};
+        return policy;
+    }
+
+    /// @brief calibrate() once per process, on first use
+    static const adaptive_policy& calibrated() {
+        static const adaptive_policy policy = calibrate();
+        return policy;
+    }
+
+    bool holds(adaptive_representation r, const adaptive_profile& p) const {
+        switch (r) {
+            case adaptive_representation::plain:
+                return p.all_zero() || (p.max_log2 <= plain_exponent_limit && p.min_log2 >= -plain_exponent_limit);
+            case adaptive_representation::lg:
+                return !p.negative;
+            default:
+                return p.all_zero() || (p.max_log2 <= multiscale_log2_max && p.min_log2 >= multiscale_log2_min);
+        }
+    }
+
+    /// @brief Estimated cost of the profile's operation mix in r
+    double cost(adaptive_representation r, const adaptive_profile& p) const {
+        const auto i = static_cast<std::size_t>(r);
+        if (p.multiplies == 0 && p.additions == 0) return multiply_cost[i] + add_cost[i];
+        return p.multiplies * multiply_cost[i] + p.additions * add_cost[i];
+    }
+
+    /// @brief The representation for a batch with this profile
+    /// @throws std::overflow_error if no representation holds it (signed
+    ///         values beyond the multiscale levels)
+    adaptive_representation select(const adaptive_profile& p, adaptive_representation current) const {
+        bool found = false;
+        auto best = adaptive_representation::multiscale;
+        for (auto r : {adaptive_representation::multiscale, adaptive_representation::plain, adaptive_representation::lg}) {
+            if (holds(r, p) && (!found || cost(r, p) < cost(best, p))) {
+                best = r;
+                found = true;
+            }
+        }
+        if (!found) throw std::overflow_error("adaptive_array: no representation holds the result");
+        if (holds(current, p) && cost(current, p) <= switch_margin * cost(best, p)) return current;
+        return best;
+    }
+};
+
+/**
+ * @brief Array whose storage moves between T, lg<T> and multiscale<T>
+ * @tparam T Underlying floating-point type
+ * @tparam SCALE_FACTOR Level width of the multiscale representation
+ */
+template<typename T, int SCALE_FACTOR = 3>
+class adaptive_array {
+    static_assert(std::is_floating_point_v<T>, "adaptive_array requires floating-point type");
+
+public:
+    using policy_type = adaptive_policy<T, SCALE_FACTOR>;
+
+private:
+    policy_type policy_;
+    adaptive_representation representation_ = adaptive_representation::plain;
+    std::vector<T> plain_;
+    lg_vector<T> lg_;
+    multiscale_array<T, SCALE_FACTOR> multiscale_;
+    adaptive_profile profile_;   // contents' range and sign, recent operation mix
+    std::size_t switches_ = 0;
+
+    void rescan() {
+        adaptive_profile range;
+        switch (representation_) {
+            case adaptive_representation::plain: range = detail::adaptive_range(span<const T>(plain_)); break;
+            case adaptive_representation::lg: range = detail::adaptive_range(lg_); break;
+            default: range = detail::adaptive_range(multiscale_); break;
+        }
+        profile_.min_log2 = range.min_log2;
+        profile_.max_log2 = range.max_log2;
+        profile_.negative = range.negative;
+    }
+
+    /// Range of the result of combining the contents with a batch of this range
+    adaptive_profile predict(const adaptive_profile& in, bool multiplying) const {
+        adaptive_profile next = profile_;
+        if (multiplying) {
+            if (profile_.all_zero() || in.all_zero()) {
+                next.min_log2 = std::numeric_limits<double>::infinity();
+                next.max_log2 = -std::numeric_limits<double>::infinity();
+            } else {
+                next.min_log2 = profile_.min_log2 + in.min_log2;
+                next.max_log2 = profile_.max_log2 + in.max_log2;
+            }
+        } else if (!in.all_zero()) {
+            next.min_log2 = std::min(profile_.min_log2, in.min_log2);
+            next.max_log2 = std::max(profile_.max_log2, in.max_log2) + 1;
+        }
+        next.negative = profile_.negative || in.negative;
+        return next;
+    }
+
+    /// The batch boundary: decay the operation mix, predict the result's
+    /// range and switch representation if the selector asks to. Plain keeps
+    /// the predicted (conservative) bounds between scans, since a scan costs
+    /// as much as the plain kernel, and rescans only before leaving plain;
+    /// the other representations rescan every batch.
+    void prepare(span<const T> batch, bool multiplying) {
+        detail::check_adaptive_size(size(), batch.size());
+        const adaptive_profile in = detail::adaptive_range(batch);
+        const double n = static_cast<double>(batch.size());
+        profile_.multiplies = profile_.multiplies / 2 + (multiplying ? n : 0);
+        profile_.additions = profile_.additions / 2 + (multiplying ? 0 : n);
+        adaptive_profile next = predict(in, multiplying);
+        if (representation_ != adaptive_representation::plain ||
+            !policy_.holds(adaptive_representation::plain, next)) {
+            rescan();
+            next = predict(in, multiplying);
+        }
+        auto target = policy_.select(next, representation_);
+        if (target != representation_) convert_to(target);
+        profile_ = next;
+    }
+
+public:
+    adaptive_array() : policy_(policy_type::defaults()) {}
+
+    /// @brief Starts in the cheapest representation that holds the values
+    static adaptive_array from_values(span<const T> values,
+                                      const policy_type& policy = policy_type::calibrated()) {
+        adaptive_array result;
+        result.policy_ = policy;
+        result.plain_.assign(values.begin(), values.end());
+        result.rescan();
+        auto target = policy.select(result.profile_, adaptive_representation::plain);
+        if (target != adaptive_representation::plain) {
+            result.convert_to(target);
+            result.switches_ = 0;
+        }
+        return result;
+    }
+
+    static adaptive_array from_values(const std::vector<T>& values,
+                                      const policy_type& policy = policy_type::calibrated()) {
+        return from_values(span<const T>(values), policy);
+    }
+
+    /// @brief Elementwise x[i] *= factors[i], after re-selecting
+    /// @throws std::invalid_argument if the sizes differ
+    /// @throws std::overflow_error if no representation holds the result
+    void multiply(span<const T> factors) {
+        prepare(factors, true);
+        switch (representation_) {
+            case adaptive_representation::plain: detail::adaptive_multiply(plain_, factors); break;
+            case adaptive_representation::lg: detail::adaptive_multiply(lg_, factors); break;
+            default: detail::adaptive_multiply(multiscale_, factors); break;
+        }
+    }
+
+    void multiply(const std::vector<T>& factors) { multiply(span<const T>(factors)); }
+
+    /// @brief Elementwise x[i] += terms[i], after re-selecting
+    /// @throws std::invalid_argument if the sizes differ
+    /// @throws std::overflow_error if no representation holds the result
+    void add(span<const T> terms) {
+        prepare(terms, false);
+        switch (representation_) {
+            case adaptive_representation::plain: detail::adaptive_add(plain_, terms); break;
+            case adaptive_representation::lg: detail::adaptive_add(lg_, terms); break;
+            default: detail::adaptive_add(multiscale_, terms); break;
+        }
+    }
+
+    void add(const std::vector<T>& terms) { add(span<const T>(terms)); }
+
+    /// @brief Convert the whole array now (the next batch may switch back)
+    /// @throws std::domain_error converting negative values to lg
+    /// @throws std::overflow_error converting values beyond the levels to multiscale
+    void convert_to(adaptive_representation target) {
+        if (target == representation_) return;
+        if (target != adaptive_representation::plain) rescan();   // the contents exactly, not the prediction
+        if (target == adaptive_representation::lg && profile_.negative) {
+            throw std::domain_error("adaptive_array: negative values have no lg representation");
+        }
+        if (target == adaptive_representation::multiscale && !policy_.holds(target, profile_)) {
+            throw std::overflow_error("adaptive_array: values beyond the multiscale levels");
+        }
+        const std::size_t n = size();
+        using ms = multiscale<T, SCALE_FACTOR>;
+        switch (representation_) {
+            case adaptive_representation::plain:
+                if (target == adaptive_representation::lg) {
+                    lg_ = lg_vector<T>(plain_);
+                } else {
+                    multiscale_ = multiscale_array<T, SCALE_FACTOR>::from_values(plain_);
+                }
+                plain_ = std::vector<T>();
+                break;
+            case adaptive_representation::lg:
+                if (target == adaptive_representation::plain) {
+                    plain_ = lg_.to_values();
+                } else {
+                    std::vector<lg<T>> logs(n);
+                    for (std::size_t i = 0; i < n; ++i) logs[i] = lg_[i];
+                    std::vector<ms> converted(n);
+                    mappings::convert_batch(span<const lg<T>>(logs), span<ms>(converted));
+                    std::vector<T> mantissas(n);
+                    std::vector<std::int8_t> scales(n);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        mantissas[i] = converted[i].mantissa();
+                        scales[i] = converted[i].scale_level();
+                    }
+                    multiscale_ = multiscale_array<T, SCALE_FACTOR>::from_normalized(mantissas, scales);
+                }
+                lg_ = lg_vector<T>();
+                break;
+            default:
+                if (target == adaptive_representation::plain) {
+                    plain_ = multiscale_.to_values();
+                } else {
+                    std::vector<ms> values(n);
+                    for (std::size_t i = 0; i < n; ++i) values[i] = multiscale_.get(i);
+                    std::vector<lg<T>> converted(n);
+                    mappings::convert_batch(span<const ms>(values), span<lg<T>>(converted));
+                    lg_ = lg_vector<T>::from_lg(converted);
+                }
+                multiscale_ = multiscale_array<T, SCALE_FACTOR>();
+                break;
+        }
+        representation_ = target;
+        ++switches_;
+        instrumentation::count(instrumentation::counter::adaptive_switches);
+    }
+
+    // Getters
+    std::size_t size() const {
+        switch (representation_) {
+            case adaptive_representation::plain: return plain_.size();
+            case adaptive_representation::lg: return lg_.size();
+            default: return multiscale_.size();
+        }
+    }
+
+    bool empty() const { return size() == 0; }
+    adaptive_representation representation() const { return representation_; }
+    const adaptive_profile& profile() const { return profile_; }
+    const policy_type& policy() const { return policy_; }
+
+    /// @brief Representation changes since construction
+    std::size_t switches() const { return switches_; }
+
+    /// @warning Overflows or underflows T when the array holds a wide range
+    T get(std::size_t i) const {
+        switch (representation_) {
+            case adaptive_representation::plain: return plain_[i];
+            case adaptive_representation::lg: return lg_[i].value();
+            default: return multiscale_.get(i).to_value();
+        }
+    }
+
+    /// @warning Elements may overflow or underflow in the real domain
+    std::vector<T> to_values() const {
+        switch (representation_) {
+            case adaptive_representation::plain: return plain_;
+            case adaptive_representation::lg: return lg_.to_values();
+            default: return multiscale_.to_values();
+        }
+    }
+
+    /// @throws std::domain_error if any value is negative
+    lg_vector<T> to_lg() const {
+        adaptive_array copy = *this;
+        copy.convert_to(adaptive_representation::lg);
+        return copy.lg_;
+    }
+
+    multiscale_array<T, SCALE_FACTOR> to_multiscale() const {
+        adaptive_array copy = *this;
+        copy.convert_to(adaptive_representation::multiscale);
+        return copy.multiscale_;
+    }
+};
+
+} // namespace cbt
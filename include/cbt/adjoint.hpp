@@ -0,0 +1,460 @@
+/**
+ * Adjoint Numbers - Reverse-Mode Automatic Differentiation
+ *
+ * Transform: f(x) → recorded Wengert list → ∇f(x) by one reverse sweep
+ * Each elementary operation appends (op, parents, local partials) to a tape;
+ * the sweep accumulates x̄ᵢ += ȳ·∂y/∂xᵢ from the output back to the inputs.
+ *
+ * dual<T> (dual.hpp) costs one pass per input; adjoint<T> costs one forward
+ * recording plus one reverse sweep for all inputs of a scalar output. The
+ * elementary functions match dual.hpp, so templated code accepts either.
+ *
+ * Trade-off:
+ *   Gain: Gradient cost is a small constant multiple of the function cost,
+ *         independent of the number of inputs; nodes live in a chunked
+ *         arena reused across recordings, so operations never allocate
+ *   Loss: Memory proportional to the number of operations recorded; a
+ *         tape belongs to one thread
+ *
+ * Applications:
+ *   - Loss gradients with thousands of parameters
+ *   - Adjoint sensitivity analysis
+ *   - Re-evaluating one recorded computation at new inputs (replay)
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "span.hpp"
+
+namespace cbt {
+
+template<typename T> class tape;
+
+namespace detail {
+
+enum class adjoint_op : std::uint8_t {
+    input, add, sub, mul, div, neg,
+    add_c, sub_c, c_sub, mul_c, div_c, c_div,
+    sin, cos, exp, log, pow_c, sqrt
+};
+
+/// Parent slot of unary and input nodes
+constexpr std::uint32_t adjoint_no_parent = std::numeric_limits<std::uint32_t>::max();
+
+/// One Wengert-list entry; unused parents are adjoint_no_parent
+template<typename T>
+struct adjoint_node {
+    T value;
+    T d_lhs;
+    T d_rhs;
+    T constant;
+    std::uint32_t lhs;
+    std::uint32_t rhs;
+    adjoint_op op;
+};
+
+/// Nodes per arena chunk (a power of two, so indexing is shift and mask)
+constexpr std::size_t adjoint_chunk_bits = 12;
+
+} // namespace detail
+
+/**
+ * @brief Value on a tape: a number plus the index of the node that made it
+ * @details Default and T-constructed values are constants (no tape); mixing
+ * a constant into an operation records a single-parent node
+ */
+template<typename T>
+class adjoint {
+    static_assert(std::is_floating_point_v<T>, "adjoint requires floating-point type");
+    friend class tape<T>;
+
+private:
+    T value_;
+    tape<T>* tape_;
+    std::uint32_t index_;
+
+    adjoint(T value, tape<T>* owner, std::uint32_t index)
+        : value_(value), tape_(owner), index_(index) {}
+
+    using op = detail::adjoint_op;
+
+    static adjoint unary(op code, const adjoint& x, T constant = T(0)) {
+        return x.tape_->record(code, x.index_, detail::adjoint_no_parent, constant);
+    }
+
+    static adjoint binary(op code, tape<T>* owner, const adjoint& a, const adjoint& b) {
+        return owner->record(code, a.index_, b.index_);
+    }
+
+    static tape<T>* shared_tape(const adjoint& a, const adjoint& b) {
+        if (a.tape_ && b.tape_ && a.tape_ != b.tape_) {
+            throw std::invalid_argument("adjoint operands belong to different tapes");
+        }
+        return a.tape_ ? a.tape_ : b.tape_;
+    }
+
+public:
+    // Constructors
+    adjoint() : adjoint(T(0)) {}
+    adjoint(T value) : value_(value), tape_(nullptr), index_(0) {}
+
+    // Getters
+    /// @brief Value when recorded; after tape::replay use tape::value
+    T value() const { return value_; }
+    bool is_constant() const { return tape_ == nullptr; }
+    std::uint32_t index() const { return index_; }
+
+    // Arithmetic
+    friend adjoint operator+(const adjoint& a, const adjoint& b) {
+        tape<T>* t = shared_tape(a, b);
+        if (!t) return adjoint(a.value_ + b.value_);
+        if (!b.tape_) return unary(op::add_c, a, b.value_);
+        if (!a.tape_) return unary(op::add_c, b, a.value_);
+        return binary(op::add, t, a, b);
+    }
+
+    friend adjoint operator-(const adjoint& a, const adjoint& b) {
+        tape<T>* t = shared_tape(a, b);
+        if (!t) return adjoint(a.value_ - b.value_);
+        if (!b.tape_) return unary(op::sub_c, a, b.value_);
+        if (!a.tape_) return unary(op::c_sub, b, a.value_);
+        return binary(op::sub, t, a, b);
+    }
+
+    friend adjoint operator*(const adjoint& a, const adjoint& b) {
+        tape<T>* t = shared_tape(a, b);
+        if (!t) return adjoint(a.value_ * b.value_);
+        if (!b.tape_) return unary(op::mul_c, a, b.value_);
+        if (!a.tape_) return unary(op::mul_c, b, a.value_);
+        return binary(op::mul, t, a, b);
+    }
+
+    friend adjoint operator/(const adjoint& a, const adjoint& b) {
+        tape<T>* t = shared_tape(a, b);
+        if (!t) return adjoint(a.value_ / b.value_);
+        if (!b.tape_) return unary(op::div_c, a, b.value_);
+        if (!a.tape_) return unary(op::c_div, b, a.value_);
+        return binary(op::div, t, a, b);
+    }
+
+    adjoint& operator+=(const adjoint& other) { return *this = *this + other; }
+    adjoint& operator-=(const adjoint& other) { return *this = *this - other; }
+    adjoint& operator*=(const adjoint& other) { return *this = *this * other; }
+    adjoint& operator/=(const adjoint& other) { return *this = *this / other; }
+
+    // Unary functions
+    adjoint operator-() const { return tape_ ? unary(op::neg, *this) : adjoint(-value_); }
+
+    // Mathematical functions with derivatives
+    friend adjoint sin(const adjoint& x) {
+        return x.tape_ ? unary(op::sin, x) : adjoint(std::sin(x.value_));
+    }
+
+    friend adjoint cos(const adjoint& x) {
+        return x.tape_ ? unary(op::cos, x) : adjoint(std::cos(x.value_));
+    }
+
+    friend adjoint exp(const adjoint& x) {
+        return x.tape_ ? unary(op::exp, x) : adjoint(std::exp(x.value_));
+    }
+
+    friend adjoint log(const adjoint& x) {
+        return x.tape_ ? unary(op::log, x) : adjoint(std::log(x.value_));
+    }
+
+    friend adjoint pow(const adjoint& x, T n) {
+        return x.tape_ ? unary(op::pow_c, x, n) : adjoint(std::pow(x.value_, n));
+    }
+
+    friend adjoint sqrt(const adjoint& x) {
+        return x.tape_ ? unary(op::sqrt, x) : adjoint(std::sqrt(x.value_));
+    }
+
+    // Comparison (based on value)
+    bool operator==(const adjoint& other) const { return value_ == other.value_; }
+    bool operator<(const adjoint& other) const { return value_ < other.value_; }
+
+    // Output
+    friend std::ostream& operator<<(std::ostream& os, const adjoint& a) {
+        return os << a.value_;
+    }
+};
+
+/**
+ * @brief Arena-backed Wengert list recording adjoint operations
+ * @details Nodes are bump-allocated in fixed-size chunks that are kept on
+ * rewind, so re-recording the same computation allocates nothing. Every
+ * node stores its operation, which lets replay() re-evaluate the whole
+ * list at new input values when the control flow does not change.
+ */
+template<typename T>
+class tape {
+    static_assert(std::is_floating_point_v<T>, "tape requires floating-point type");
+    friend class adjoint<T>;
+
+private:
+    using node = detail::adjoint_node<T>;
+    using op = detail::adjoint_op;
+    static constexpr std::size_t chunk_size = std::size_t(1) << detail::adjoint_chunk_bits;
+
+    std::vector<std::unique_ptr<node[]>> chunks_;
+    std::size_t size_ = 0;
+    std::vector<std::uint32_t> inputs_;
+    std::vector<T> adjoints_;
+    std::vector<T> tangents_;     // ẋ per node (hessian_vector)
+    std::vector<T> tangent_adjoints_;
+    std::vector<std::pair<T, T>> partial_tangents_;  // ∂(d_lhs, d_rhs)/∂v
+
+    node& at(std::size_t i) {
+        return chunks_[i >> detail::adjoint_chunk_bits][i & (chunk_size - 1)];
+    }
+    const node& at(std::size_t i) const {
+        return chunks_[i >> detail::adjoint_chunk_bits][i & (chunk_size - 1)];
+    }
+
+    /// Value and local partials of n from its parents' values
+    void evaluate(node& n) const {
+        if (n.op == op::input) return;
+        const T a = at(n.lhs).value;
+        const T b = n.rhs == detail::adjoint_no_parent ? T(0) : at(n.rhs).value;
+        const T c = n.constant;
+        T d_lhs = 0, d_rhs = 0, value = a;
+        switch (n.op) {
+            case op::input: break;
+            case op::add: value = a + b; d_lhs = 1; d_rhs = 1; break;
+            case op::sub: value = a - b; d_lhs = 1; d_rhs = -1; break;
+            case op::mul: value = a * b; d_lhs = b; d_rhs = a; break;
+            case op::div: value = a / b; d_lhs = 1 / b; d_rhs = -value / b; break;
+            case op::neg: value = -a; d_lhs = -1; break;
+            case op::add_c: value = a + c; d_lhs = 1; break;
+            case op::sub_c: value = a - c; d_lhs = 1; break;
+            case op::c_sub: value = c - a; d_lhs = -1; break;
+            case op::mul_c: value = a * c; d_lhs = c; break;
+            case op::div_c: value = a / c; d_lhs = 1 / c; break;
+            case op::c_div: value = c / a; d_lhs = -value / a; break;
+            case op::sin: value = std::sin(a); d_lhs = std::cos(a); break;
+            case op::cos: value = std::cos(a); d_lhs = -std::sin(a); break;
+            case op::exp: value = std::exp(a); d_lhs = value; break;
+            case op::log: value = std::log(a); d_lhs = 1 / a; break;
+            case op::pow_c: value = std::pow(a, c); d_lhs = c * std::pow(a, c - 1); break;
+            case op::sqrt: value = std::sqrt(a); d_lhs = 1 / (2 * value); break;
+        }
+        n.value = value;
+        n.d_lhs = d_lhs;
+        n.d_rhs = d_rhs;
+    }
+
+    /// Bump-allocate the next node; a new chunk only when the arena is full
+    node& push() {
+        if (size_ >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("tape exceeds 2^32 nodes");
+        }
+        if ((size_ >> detail::adjoint_chunk_bits) == chunks_.size()) {
+            chunks_.emplace_back(new node[chunk_size]);
+        }
+        return at(size_++);
+    }
+
+    adjoint<T> record(op code, std::uint32_t lhs, std::uint32_t rhs, T constant = T(0)) {
+        node& n = push();
+        n.op = code;
+        n.lhs = lhs;
+        n.rhs = rhs;
+        n.constant = constant;
+        evaluate(n);
+        return adjoint<T>(n.value, this, static_cast<std::uint32_t>(size_ - 1));
+    }
+
+    void check(const adjoint<T>& x) const {
+        if (x.tape_ != this || x.index_ >= size_) {
+            throw std::invalid_argument("adjoint is not recorded on this tape");
+        }
+    }
+
+public:
+    tape() = default;
+    tape(const tape&) = delete;
+    tape& operator=(const tape&) = delete;
+
+    // Recording
+    /// @brief Register an independent variable
+    adjoint<T> variable(T value) {
+        node& n = push();
+        const auto index = static_cast<std::uint32_t>(size_ - 1);
+        n = node{value, T(0), T(0), T(0), detail::adjoint_no_parent, detail::adjoint_no_parent, op::input};
+        inputs_.push_back(index);
+        return adjoint<T>(value, this, index);
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t input_count() const { return inputs_.size(); }
+
+    /// @brief Current recording position
+    std::size_t checkpoint() const { return size_; }
+
+    /**
+     * @brief Discard every node recorded after position
+     * @details Arena chunks are kept, so re-recording does not allocate;
+     * handles to discarded nodes must not be used again
+     */
+    void rewind(std::size_t position) {
+        if (position > size_) {
+            throw std::invalid_argument("checkpoint is ahead of the tape");
+        }
+        size_ = position;
+        while (!inputs_.empty() && inputs_.back() >= position) inputs_.pop_back();
+    }
+
+    /// @brief Empty the tape, keeping its memory
+    void clear() { rewind(0); }
+
+    // Replay
+    /// @brief Change an input's value; takes effect at the next replay()
+    void set_value(const adjoint<T>& input, T value) {
+        check(input);
+        node& n = at(input.index_);
+        if (n.op != op::input) {
+            throw std::invalid_argument("only inputs can be set");
+        }
+        n.value = value;
+    }
+
+    /// @brief Re-evaluate every recorded node in order at the current inputs
+    /// @warning Valid only if the function's control flow does not depend on
+    /// the changed values
+    void replay() {
+        for (std::size_t i = 0; i < size_; ++i) evaluate(at(i));
+    }
+
+    /// @brief Value of a recorded node (reflects replay)
+    T value(const adjoint<T>& x) const {
+        if (x.is_constant()) return x.value();
+        check(x);
+        return at(x.index_).value;
+    }
+
+    // Reverse sweep
+    /**
+     * @brief Propagate ∂output/∂node to every node recorded up to output
+     * @details One pass in reverse order; each node scatters into its two
+     * parent slots, missing parents being redirected to a scratch slot past
+     * the output so the loop has no branches
+     */
+    void backward(const adjoint<T>& output) {
+        check(output);
+        const std::uint32_t sink = output.index_ + 1;
+        adjoints_.assign(std::size_t(sink) + 1, T(0));
+        adjoints_[output.index_] = T(1);
+        for (std::size_t i = output.index_ + 1; i-- > 0;) {
+            const node& n = at(i);
+            const T bar = adjoints_[i];
+            adjoints_[std::min(n.lhs, sink)] += bar * n.d_lhs;
+            adjoints_[std::min(n.rhs, sink)] += bar * n.d_rhs;
+        }
+    }
+
+    /// @brief ∂output/∂x from the last backward(); 0 for later or constant x
+    T adjoint_of(const adjoint<T>& x) const {
+        if (x.is_constant() || x.tape_ != this || std::size_t(x.index_) + 1 >= adjoints_.size()) {
+            return T(0);
+        }
+        return adjoints_[x.index_];
+    }
+
+    /// @brief ∇output with respect to every input, in registration order
+    std::vector<T> gradient(const adjoint<T>& output) {
+        backward(output);
+        std::vector<T> grad(inputs_.size());
+        for (std::size_t k = 0; k < inputs_.size(); ++k) {
+            grad[k] = std::size_t(inputs_[k]) + 1 < adjoints_.size() ? adjoints_[inputs_[k]] : T(0);
+        }
+        return grad;
+    }
+
+    /**
+     * @brief Hessian-vector product H·v of output at the recorded point
+     * @param direction v, one entry per input in registration order
+     * @return H·v, one entry per input; the gradient is left in adjoint_of
+     * @details Forward-over-reverse: a tangent sweep carries ẋ = ∂x/∂v and
+     * the derivative of each local partial, then one reverse sweep
+     * propagates the adjoints and their tangents together. Cost is about
+     * three sweeps of the tape, independent of the number of inputs.
+     */
+    std::vector<T> hessian_vector(const adjoint<T>& output, span<const T> direction) {
+        check(output);
+        if (direction.size() != inputs_.size()) {
+            throw std::invalid_argument("direction must have one entry per input");
+        }
+        const std::uint32_t sink = output.index_ + 1;
+        const std::size_t n = std::size_t(sink) + 1;
+        tangents_.assign(n, T(0));
+        for (std::size_t k = 0; k < inputs_.size(); ++k) {
+            if (inputs_[k] < sink) tangents_[inputs_[k]] = direction[k];
+        }
+        // Tangent sweep; tangents_ of the sink slot stays 0 for missing parents
+        auto dot = [this, sink](std::uint32_t i) { return tangents_[std::min(i, sink)]; };
+        adjoints_.assign(n, T(0));
+        tangent_adjoints_.assign(n, T(0));
+        partial_tangents_.assign(sink, {T(0), T(0)});
+        for (std::size_t i = 0; i < sink; ++i) {
+            const node& nd = at(i);
+            if (nd.op == op::input) continue;
+            const T da = dot(nd.lhs), db = dot(nd.rhs);
+            const T a = at(nd.lhs).value;
+            const T b = nd.rhs == detail::adjoint_no_parent ? T(0) : at(nd.rhs).value;
+            const T c = nd.constant;
+            T dd_lhs = 0, dd_rhs = 0;
+            switch (nd.op) {
+                case op::mul: dd_lhs = db; dd_rhs = da; break;
+                case op::div: dd_lhs = -db / (b * b); dd_rhs = (-da + 2 * nd.value * db) / (b * b); break;
+                case op::c_div: dd_lhs = -2 * nd.d_lhs * da / a; break;
+                case op::sin: dd_lhs = -nd.value * da; break;
+                case op::cos: dd_lhs = -nd.value * da; break;
+                case op::exp: dd_lhs = nd.value * da; break;
+                case op::log: dd_lhs = -da / (a * a); break;
+                case op::pow_c: dd_lhs = (c - 1) * nd.d_lhs / a * da; break;
+                case op::sqrt: dd_lhs = -nd.d_lhs / (2 * a) * da; break;
+                default: break;  // linear operations: constant partials
+            }
+            partial_tangents_[i] = {dd_lhs, dd_rhs};
+            tangents_[i] = nd.d_lhs * da + nd.d_rhs * db;
+        }
+        // Reverse sweep of adjoints and adjoint tangents together
+        adjoints_[output.index_] = T(1);
+        for (std::size_t i = sink; i-- > 0;) {
+            const node& nd = at(i);
+            const T bar = adjoints_[i];
+            const T bar_dot = tangent_adjoints_[i];
+            const std::uint32_t l = std::min(nd.lhs, sink), r = std::min(nd.rhs, sink);
+            adjoints_[l] += bar * nd.d_lhs;
+            adjoints_[r] += bar * nd.d_rhs;
+            tangent_adjoints_[l] += bar_dot * nd.d_lhs + bar * partial_tangents_[i].first;
+            tangent_adjoints_[r] += bar_dot * nd.d_rhs + bar * partial_tangents_[i].second;
+        }
+        std::vector<T> product(inputs_.size());
+        for (std::size_t k = 0; k < inputs_.size(); ++k) {
+            product[k] = inputs_[k] < sink ? tangent_adjoints_[inputs_[k]] : T(0);
+        }
+        return product;
+    }
+
+    std::vector<T> hessian_vector(const adjoint<T>& output, const std::vector<T>& direction) {
+        return hessian_vector(output, span<const T>(direction));
+    }
+};
+
+// Type alias
+using adjointf = adjoint<float>;
+using adjointd = adjoint<double>;
+
+} // namespace cbt
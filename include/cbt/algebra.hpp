@@ -0,0 +1,158 @@
+/**
+ * Algebraic Traits - The Monoid Each Transform's Operation Forms
+ *
+ * Transform: (T, op) → declared identity, associativity, commutativity
+ *
+ * Most transforms exist to turn an expensive operation into a cheap one
+ * that forms a monoid: lg under ×, tropical_min under min (+) and + (×),
+ * log_odds under +, modular, quaternion products. monoid_traits<T, Op>
+ * records that fact once, so generic algorithms (parallel_reduce,
+ * parallel_inclusive_scan) can regroup the operation without each call site
+ * restating its identity or assuming commutativity. Op is the std::plus<>
+ * or std::multiplies<> that invokes the type's operator.
+ *
+ * "associative" is algebraic: floating-point types regroup with rounding
+ * differences, so the algorithms fix the grouping for reproducibility.
+ * Declare a monoid for your own type by specializing monoid_traits.
+ *
+ * Trade-off:
+ *   Gain: Parallel and tree-shaped algorithms apply to any declared monoid,
+ *         and non-commutative ones (quaternion ×) are never reordered
+ *   Loss: A specialization per (type, operation); undeclared pairs are
+ *         rejected at compile time rather than assumed associative
+ *
+ * Applications:
+ *   - Parallel products, sums and prefix scans over transformed values
+ *   - Prefix products of rotations and tropical transfer matrices (DP)
+ */
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "logarithmic.hpp"
+#include "modular.hpp"
+#include "odds_ratio.hpp"
+#include "quaternion.hpp"
+#include "stern_brocot.hpp"
+#include "tropical.hpp"
+
+namespace cbt {
+
+/**
+ * @brief (T, Op) is a monoid when specialized with is_monoid = true,
+ * identity() and the associative / commutative flags
+ */
+template<typename T, typename Op, typename = void>
+struct monoid_traits {
+    static constexpr bool is_monoid = false;
+};
+
+template<typename T, typename Op>
+constexpr bool is_monoid_v = monoid_traits<T, Op>::is_monoid;
+
+namespace detail {
+
+template<bool Commutative>
+struct monoid_flags {
+    static constexpr bool is_monoid = true;
+    static constexpr bool associative = true;
+    static constexpr bool commutative = Commutative;
+};
+
+} // namespace detail
+
+// Builtin arithmetic (floating-point associativity is up to rounding)
+template<typename T>
+struct monoid_traits<T, std::plus<>, std::enable_if_t<std::is_arithmetic_v<T>>> : detail::monoid_flags<true> {
+    static constexpr T identity() { return T(0); }
+};
+
+template<typename T>
+struct monoid_traits<T, std::multiplies<>, std::enable_if_t<std::is_arithmetic_v<T>>> : detail::monoid_flags<true> {
+    static constexpr T identity() { return T(1); }
+};
+
+// lg: × is log addition, + is log-sum-exp
+template<typename T>
+struct monoid_traits<lg<T>, std::multiplies<>> : detail::monoid_flags<true> {
+    static constexpr lg<T> identity() { return lg<T>::from_log(0); }
+};
+
+template<typename T>
+struct monoid_traits<lg<T>, std::plus<>> : detail::monoid_flags<true> {
+    static constexpr lg<T> identity() { return lg<T>(); }
+};
+
+// Bayesian evidence: odds multiply, log-odds add
+template<typename T>
+struct monoid_traits<odds_ratio<T>, std::multiplies<>> : detail::monoid_flags<true> {
+    static constexpr odds_ratio<T> identity() { return odds_ratio<T>(1); }
+};
+
+template<typename T>
+struct monoid_traits<log_odds<T>, std::plus<>> : detail::monoid_flags<true> {
+    static constexpr log_odds<T> identity() { return log_odds<T>(0); }
+};
+
+// Tropical semirings: + is min / max (exactly associative), × is +
+template<typename T>
+struct monoid_traits<tropical_min<T>, std::plus<>> : detail::monoid_flags<true> {
+    static tropical_min<T> identity() { return tropical_min<T>::zero(); }
+};
+
+template<typename T>
+struct monoid_traits<tropical_min<T>, std::multiplies<>> : detail::monoid_flags<true> {
+    static tropical_min<T> identity() { return tropical_min<T>::one(); }
+};
+
+template<typename T>
+struct monoid_traits<tropical_max<T>, std::plus<>> : detail::monoid_flags<true> {
+    static tropical_max<T> identity() { return tropical_max<T>::zero(); }
+};
+
+template<typename T>
+struct monoid_traits<tropical_max<T>, std::multiplies<>> : detail::monoid_flags<true> {
+    static tropical_max<T> identity() { return tropical_max<T>::one(); }
+};
+
+/// Min-plus matrix products compose DP transitions; not commutative
+template<typename T, std::size_t N>
+struct monoid_traits<tropical_matrix<T, N>, std::multiplies<>> : detail::monoid_flags<false> {
+    static tropical_matrix<T, N> identity() { return tropical_matrix<T, N>::identity(); }
+};
+
+// Residues: exact ring operations
+template<typename T, T Modulus>
+struct monoid_traits<modular<T, Modulus>, std::plus<>> : detail::monoid_flags<true> {
+    static constexpr modular<T, Modulus> identity() { return modular<T, Modulus>(); }
+};
+
+template<typename T, T Modulus>
+struct monoid_traits<modular<T, Modulus>, std::multiplies<>> : detail::monoid_flags<true> {
+    static constexpr modular<T, Modulus> identity() { return modular<T, Modulus>(T(1)); }
+};
+
+// Exact rationals
+template<typename T>
+struct monoid_traits<stern_brocot<T>, std::plus<>> : detail::monoid_flags<true> {
+    static stern_brocot<T> identity() { return stern_brocot<T>(); }
+};
+
+template<typename T>
+struct monoid_traits<stern_brocot<T>, std::multiplies<>> : detail::monoid_flags<true> {
+    static stern_brocot<T> identity() { return stern_brocot<T>(T(1)); }
+};
+
+// Quaternions: the Hamilton product composes rotations and is not commutative
+template<typename T>
+struct monoid_traits<quaternion<T>, std::plus<>> : detail::monoid_flags<true> {
+    static quaternion<T> identity() { return quaternion<T>(0, 0, 0, 0); }
+};
+
+template<typename T>
+struct monoid_traits<quaternion<T>, std::multiplies<>> : detail::monoid_flags<false> {
+    static quaternion<T> identity() { return quaternion<T>::identity(); }
+};
+
+} // namespace cbt
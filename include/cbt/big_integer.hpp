@@ -0,0 +1,503 @@
+/**
+ * Big Integer - Arbitrary-Precision Integers with an Inline Small Path
+ *
+ * Representation: an int64_t while the value fits, otherwise sign and
+ * magnitude in little-endian 32-bit limbs. The form is canonical: a value
+ * that fits in 64 bits is always stored inline, so small operands never
+ * touch the heap.
+ *
+ * Trade-off:
+ *   Gain: Exact integers of any size; operations on small values are one
+ *         overflow-checked machine instruction plus a branch
+ *   Loss: Schoolbook multiplication and Knuth division - quadratic in the
+ *         limb count, so not a replacement for a tuned bignum library on
+ *         numbers of thousands of digits
+ *
+ * Applications:
+ *   - Backend for stern_brocot<big_integer> exact rationals
+ *   - Exact accumulation of products that overflow 64 bits
+ */
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cbt {
+
+namespace detail {
+
+/// a + b, a - b, a * b, -a; throw std::overflow_error instead of wrapping
+template<typename T>
+T checked_add(T a, T b) {
+    T r;
+    if (__builtin_add_overflow(a, b, &r)) throw std::overflow_error("integer overflow in addition");
+    return r;
+}
+
+template<typename T>
+T checked_sub(T a, T b) {
+    T r;
+    if (__builtin_sub_overflow(a, b, &r)) throw std::overflow_error("integer overflow in subtraction");
+    return r;
+}
+
+template<typename T>
+T checked_mul(T a, T b) {
+    T r;
+    if (__builtin_mul_overflow(a, b, &r)) throw std::overflow_error("integer overflow in multiplication");
+    return r;
+}
+
+template<typename T>
+T checked_neg(T a) { return checked_sub(T(0), a); }
+
+} // namespace detail
+
+class big_integer {
+public:
+    using limb = std::uint32_t;
+
+private:
+    using magnitude = std::vector<limb>;
+    static constexpr int limb_bits = 32;
+
+    std::int64_t small_ = 0;   // the value, while mag_ is empty
+    magnitude mag_;            // |value| when it does not fit in int64_t
+    bool negative_ = false;    // sign of a non-inline value
+
+    struct raw_tag {};
+    big_integer(magnitude mag, bool negative, raw_tag) : mag_(std::move(mag)), negative_(negative) {}
+
+    // ---- magnitude kernels ----
+
+    static void trim(magnitude& m) {
+        while (!m.empty() && m.back() == 0) m.pop_back();
+    }
+
+    static magnitude from_u64(std::uint64_t v) {
+        magnitude m;
+        while (v != 0) {
+            m.push_back(static_cast<limb>(v));
+            v >>= limb_bits;
+        }
+        return m;
+    }
+
+    static std::uint64_t small_magnitude(std::int64_t v) {
+        return v < 0 ? std::uint64_t(0) - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v);
+    }
+
+    magnitude magnitude_of() const { return is_inline() ? from_u64(small_magnitude(small_)) : mag_; }
+
+    /// Canonical value of ±m: inline whenever it fits
+    static big_integer from_magnitude(magnitude m, bool negative) {
+        trim(m);
+        if (m.size() <= 2) {
+            std::uint64_t v = 0;
+            for (std::size_t i = m.size(); i-- > 0;) v = (v << limb_bits) | m[i];
+            constexpr std::uint64_t max = std::numeric_limits<std::int64_t>::max();
+            if (v <= max) return big_integer(negative ? -static_cast<std::int64_t>(v) : static_cast<std::int64_t>(v));
+            if (negative && v == max + 1) return big_integer(std::numeric_limits<std::int64_t>::min());
+        }
+        return big_integer(std::move(m), negative, raw_tag{});
+    }
+
+    static int compare_magnitude(const magnitude& a, const magnitude& b) {
+        if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+        for (std::size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static magnitude add_magnitude(const magnitude& a, const magnitude& b) {
+        const magnitude& longer = a.size() >= b.size() ? a : b;
+        const magnitude& shorter = a.size() >= b.size() ? b : a;
+        magnitude r(longer.size() + 1);
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < longer.size(); ++i) {
+            std::uint64_t s = std::uint64_t(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+            r[i] = static_cast<limb>(s);
+            carry = s >> limb_bits;
+        }
+        r[longer.size()] = static_cast<limb>(carry);
+        trim(r);
+        return r;
+    }
+
+    /// a - b for a ≥ b
+    static magnitude sub_magnitude(const magnitude& a, const magnitude& b) {
+        magnitude r(a.size());
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            std::int64_t d = std::int64_t(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+            borrow = d < 0;
+            r[i] = static_cast<limb>(d + (borrow << limb_bits));
+        }
+        trim(r);
+        return r;
+    }
+
+    static magnitude mul_magnitude(const magnitude& a, const magnitude& b) {
+        if (a.empty() || b.empty()) return {};
+        magnitude r(a.size() + b.size(), 0);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < b.size(); ++j) {
+                // (2³² - 1)² + 2·(2³² - 1) = 2⁶⁴ - 1: never overflows
+                std::uint64_t t = std::uint64_t(a[i]) * b[j] + r[i + j] + carry;
+                r[i + j] = static_cast<limb>(t);
+                carry = t >> limb_bits;
+            }
+            r[i + b.size()] = static_cast<limb>(carry);
+        }
+        trim(r);
+        return r;
+    }
+
+    /// m /= d in place; returns the remainder
+    static limb div_limb(magnitude& m, limb d) {
+        std::uint64_t rem = 0;
+        for (std::size_t i = m.size(); i-- > 0;) {
+            std::uint64_t cur = (rem << limb_bits) | m[i];
+            m[i] = static_cast<limb>(cur / d);
+            rem = cur % d;
+        }
+        trim(m);
+        return static_cast<limb>(rem);
+    }
+
+    /// Knuth's Algorithm D (TAOCP 4.3.1): q = u / v, r = u % v, v ≠ 0
+    static void divmod_magnitude(const magnitude& u, const magnitude& v, magnitude& q, magnitude& r) {
+        if (compare_magnitude(u, v) < 0) {
+            q.clear();
+            r = u;
+            return;
+        }
+        if (v.size() == 1) {
+            q = u;
+            limb rem = div_limb(q, v[0]);
+            r = rem ? magnitude{rem} : magnitude{};
+            return;
+        }
+
+        // Normalize so the divisor's top limb has its high bit set
+        const std::size_t n = v.size(), m = u.size();
+        int s = 0;
+        for (limb top = v.back(); !(top & 0x80000000u); top <<= 1) ++s;
+        auto shifted = [s](const magnitude& x, std::size_t size) {
+            magnitude out(size, 0);
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                out[i] |= x[i] << s;
+                if (s && i + 1 < size) out[i + 1] = x[i] >> (limb_bits - s);
+            }
+            return out;
+        };
+        magnitude vn = shifted(v, n);
+        magnitude un = shifted(u, m + 1);
+
+        q.assign(m - n + 1, 0);
+        constexpr std::uint64_t base = std::uint64_t(1) << limb_bits;
+        for (std::size_t j = m - n + 1; j-- > 0;) {
+            std::uint64_t top = (std::uint64_t(un[j + n]) << limb_bits) | un[j + n - 1];
+            std::uint64_t qhat = top / vn[n - 1];
+            std::uint64_t rhat = top % vn[n - 1];
+            while (qhat >= base || qhat * vn[n - 2] > ((rhat << limb_bits) | un[j + n - 2])) {
+                --qhat;
+                rhat += vn[n - 1];
+                if (rhat >= base) break;
+            }
+
+            // un[j..j+n] -= qhat · vn
+            std::int64_t borrow = 0;
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint64_t p = qhat * vn[i] + carry;
+                carry = p >> limb_bits;
+                std::int64_t t = std::int64_t(un[i + j]) - borrow - std::int64_t(p & (base - 1));
+                borrow = t < 0;
+                un[i + j] = static_cast<limb>(t + (borrow << limb_bits));
+            }
+            std::int64_t t = std::int64_t(un[j + n]) - borrow - std::int64_t(carry);
+            un[j + n] = static_cast<limb>(t);
+
+            // qhat was one too large (rare): add vn back
+            if (t < 0) {
+                --qhat;
+                std::uint64_t c = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::uint64_t sum = std::uint64_t(un[i + j]) + vn[i] + c;
+                    un[i + j] = static_cast<limb>(sum);
+                    c = sum >> limb_bits;
+                }
+                un[j + n] = static_cast<limb>(un[j + n] + c);
+            }
+            q[j] = static_cast<limb>(qhat);
+        }
+        trim(q);
+
+        r.assign(n, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            r[i] = un[i] >> s;
+            if (s) r[i] |= un[i + 1] << (limb_bits - s);
+        }
+        trim(r);
+    }
+
+    static magnitude shift_left(magnitude m, int bits) {
+        if (m.empty() || bits == 0) return m;
+        const std::size_t limbs = static_cast<std::size_t>(bits) / limb_bits;
+        const int rest = bits % limb_bits;
+        magnitude r(m.size() + limbs + 1, 0);
+        for (std::size_t i = 0; i < m.size(); ++i) {
+            r[i + limbs] |= m[i] << rest;
+            if (rest) r[i + limbs + 1] = m[i] >> (limb_bits - rest);
+        }
+        trim(r);
+        return r;
+    }
+
+    static big_integer add_slow(const big_integer& a, const big_integer& b, bool subtract) {
+        bool sign_a = a.is_negative();
+        bool sign_b = b.is_negative() != subtract;
+        magnitude ma = a.magnitude_of(), mb = b.magnitude_of();
+        if (sign_a == sign_b) return from_magnitude(add_magnitude(ma, mb), sign_a);
+        if (compare_magnitude(ma, mb) >= 0) return from_magnitude(sub_magnitude(ma, mb), sign_a);
+        return from_magnitude(sub_magnitude(mb, ma), sign_b);
+    }
+
+    /// Truncating division (like the builtin operators): q rounds toward 0,
+    /// r takes the sign of the dividend
+    /// Both inline and the machine division neither traps nor overflows
+    bool inline_division(const big_integer& divisor) const {
+        return is_inline() && divisor.is_inline() && divisor.small_ != 0 &&
+               !(small_ == std::numeric_limits<std::int64_t>::min() && divisor.small_ == -1);
+    }
+
+    static void divmod(const big_integer& a, const big_integer& b, big_integer& q, big_integer& r) {
+        if (b.is_zero()) throw std::invalid_argument("Division by zero");
+        magnitude mq, mr;
+        divmod_magnitude(a.magnitude_of(), b.magnitude_of(), mq, mr);
+        q = from_magnitude(std::move(mq), a.is_negative() != b.is_negative());
+        r = from_magnitude(std::move(mr), a.is_negative());
+    }
+
+    /// -1, 0, 1
+    static int compare(const big_integer& a, const big_integer& b) {
+        if (a.is_inline() && b.is_inline()) return (a.small_ > b.small_) - (a.small_ < b.small_);
+        bool na = a.is_negative(), nb = b.is_negative();
+        if (na != nb) return na ? -1 : 1;
+        // Canonical form: an inline value is smaller in magnitude than any other
+        int c = a.is_inline() ? -1 : b.is_inline() ? 1 : compare_magnitude(a.mag_, b.mag_);
+        return na ? -c : c;
+    }
+
+public:
+    // Constructors
+    big_integer() = default;
+
+    template<typename I, std::enable_if_t<std::is_integral_v<I>, int> = 0>
+    big_integer(I value) {
+        if constexpr (std::is_unsigned_v<I> && sizeof(I) >= sizeof(std::int64_t)) {
+            if (value > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                mag_ = from_u64(value);
+                return;
+            }
+        }
+        small_ = static_cast<std::int64_t>(value);
+    }
+
+    /// @brief The integer part of a finite floating-point value (truncated)
+    /// @throws std::invalid_argument for NaN or infinity
+    template<typename F, std::enable_if_t<std::is_floating_point_v<F>, int> = 0>
+    explicit big_integer(F value) {
+        if (!std::isfinite(value)) throw std::invalid_argument("Cannot convert NaN or infinity to big_integer");
+        long double v = std::trunc(static_cast<long double>(value));
+        if (std::fabs(v) < 0x1p63L) {
+            small_ = static_cast<std::int64_t>(v);
+            return;
+        }
+        // |v| = mantissa · 2^(exponent - 64) with a 64-bit integer mantissa
+        int exponent;
+        long double fraction = std::frexp(std::fabs(v), &exponent);
+        auto mantissa = static_cast<std::uint64_t>(std::ldexp(fraction, 64));
+        *this = from_magnitude(shift_left(from_u64(mantissa), exponent - 64), v < 0);
+    }
+
+    /// @brief Parse an optionally signed decimal string
+    /// @throws std::invalid_argument on an empty string or non-digit characters
+    static big_integer from_string(const std::string& text) {
+        std::size_t i = 0;
+        bool negative = false;
+        if (i < text.size() && (text[i] == '-' || text[i] == '+')) negative = text[i++] == '-';
+        if (i == text.size()) throw std::invalid_argument("big_integer::from_string: no digits");
+        magnitude m;
+        for (; i < text.size(); ++i) {
+            if (text[i] < '0' || text[i] > '9') {
+                throw std::invalid_argument("big_integer::from_string: invalid digit");
+            }
+            // m = 10·m + digit
+            std::uint64_t carry = static_cast<std::uint64_t>(text[i] - '0');
+            for (auto& l : m) {
+                std::uint64_t t = std::uint64_t(l) * 10 + carry;
+                l = static_cast<limb>(t);
+                carry = t >> limb_bits;
+            }
+            if (carry) m.push_back(static_cast<limb>(carry));
+        }
+        return from_magnitude(std::move(m), negative);
+    }
+
+    // Queries
+    bool is_inline() const { return mag_.empty(); }   ///< true: no heap storage
+    bool is_zero() const { return is_inline() && small_ == 0; }
+    bool is_negative() const { return is_inline() ? small_ < 0 : negative_; }
+
+    bool fits_int64() const { return is_inline(); }
+
+    /// @throws std::overflow_error if the value needs more than 64 bits
+    std::int64_t to_int64() const {
+        if (!is_inline()) throw std::overflow_error("big_integer does not fit in int64_t");
+        return small_;
+    }
+
+    /// Nearest long double (±inf beyond its range)
+    long double to_long_double() const {
+        if (is_inline()) return static_cast<long double>(small_);
+        long double r = 0;
+        for (std::size_t i = mag_.size(); i-- > 0;) r = r * 0x1p32L + mag_[i];
+        return negative_ ? -r : r;
+    }
+
+    double to_double() const { return static_cast<double>(to_long_double()); }
+
+    explicit operator long double() const { return to_long_double(); }
+    explicit operator double() const { return to_double(); }
+    explicit operator bool() const { return !is_zero(); }
+
+    std::string to_string() const {
+        if (is_inline()) return std::to_string(small_);
+        // Peel off nine decimal digits per limb division
+        magnitude m = mag_;
+        std::string digits;
+        while (!m.empty()) {
+            limb chunk = div_limb(m, 1000000000u);
+            for (int k = 0; k < 9; ++k) {
+                digits.push_back(static_cast<char>('0' + chunk % 10));
+                chunk /= 10;
+                if (m.empty() && chunk == 0) break;
+            }
+        }
+        if (negative_) digits.push_back('-');
+        return std::string(digits.rbegin(), digits.rend());
+    }
+
+    // Arithmetic
+    friend big_integer operator+(const big_integer& a, const big_integer& b) {
+        std::int64_t r;
+        if (a.is_inline() && b.is_inline() && !__builtin_add_overflow(a.small_, b.small_, &r)) return big_integer(r);
+        return add_slow(a, b, false);
+    }
+
+    friend big_integer operator-(const big_integer& a, const big_integer& b) {
+        std::int64_t r;
+        if (a.is_inline() && b.is_inline() && !__builtin_sub_overflow(a.small_, b.small_, &r)) return big_integer(r);
+        return add_slow(a, b, true);
+    }
+
+    friend big_integer operator*(const big_integer& a, const big_integer& b) {
+        std::int64_t r;
+        if (a.is_inline() && b.is_inline() && !__builtin_mul_overflow(a.small_, b.small_, &r)) return big_integer(r);
+        return from_magnitude(mul_magnitude(a.magnitude_of(), b.magnitude_of()), a.is_negative() != b.is_negative());
+    }
+
+    /// @throws std::invalid_argument on division by zero
+    friend big_integer operator/(const big_integer& a, const big_integer& b) {
+        if (a.inline_division(b)) return big_integer(a.small_ / b.small_);
+        big_integer q, r;
+        divmod(a, b, q, r);
+        return q;
+    }
+
+    /// @throws std::invalid_argument on division by zero
+    friend big_integer operator%(const big_integer& a, const big_integer& b) {
+        if (a.inline_division(b)) return big_integer(a.small_ % b.small_);
+        big_integer q, r;
+        divmod(a, b, q, r);
+        return r;
+    }
+
+    big_integer operator-() const {
+        if (is_inline() && small_ != std::numeric_limits<std::int64_t>::min()) return big_integer(-small_);
+        return from_magnitude(magnitude_of(), !is_negative());
+    }
+
+    big_integer& operator+=(const big_integer& other) { return *this = *this + other; }
+    big_integer& operator-=(const big_integer& other) { return *this = *this - other; }
+    big_integer& operator*=(const big_integer& other) { return *this = *this * other; }
+    big_integer& operator/=(const big_integer& other) { return *this = *this / other; }
+    big_integer& operator%=(const big_integer& other) { return *this = *this % other; }
+
+    friend big_integer abs(const big_integer& x) { return x.is_negative() ? -x : x; }
+
+    /// Non-negative greatest common divisor; gcd(0, 0) = 0
+    friend big_integer gcd(const big_integer& x, const big_integer& y) {
+        if (x.is_inline() && y.is_inline()) return inline_gcd(x.small_, y.small_);
+        big_integer a = x, b = y;
+        while (!(a.is_inline() && b.is_inline())) {
+            if (b.is_zero()) return abs(a);
+            a = a % b;
+            std::swap(a, b);
+        }
+        return inline_gcd(a.small_, b.small_);
+    }
+
+private:
+    static big_integer inline_gcd(std::int64_t a, std::int64_t b) {
+        std::uint64_t g = std::gcd(small_magnitude(a), small_magnitude(b));
+        if (g <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            return big_integer(static_cast<std::int64_t>(g));
+        }
+        return from_magnitude(from_u64(g), false);   // gcd(min, 0) and gcd(min, min)
+    }
+
+public:
+
+    // Comparison
+    friend bool operator==(const big_integer& a, const big_integer& b) {
+        if (a.is_inline() != b.is_inline()) return false;
+        return a.is_inline() ? a.small_ == b.small_ : a.negative_ == b.negative_ && a.mag_ == b.mag_;
+    }
+    friend bool operator!=(const big_integer& a, const big_integer& b) { return !(a == b); }
+    friend bool operator<(const big_integer& a, const big_integer& b) { return compare(a, b) < 0; }
+    friend bool operator>(const big_integer& a, const big_integer& b) { return compare(a, b) > 0; }
+    friend bool operator<=(const big_integer& a, const big_integer& b) { return compare(a, b) <= 0; }
+    friend bool operator>=(const big_integer& a, const big_integer& b) { return compare(a, b) >= 0; }
+
+    // Output
+    friend std::ostream& operator<<(std::ostream& os, const big_integer& x) { return os << x.to_string(); }
+};
+
+/// Integer types usable as the numerator/denominator of stern_brocot<T>:
+/// the builtin integers and big_integer. Another backend opts in by
+/// specializing this and providing + - * / % (truncating), comparisons,
+/// construction from int and long double, an explicit conversion to
+/// long double, and gcd(a, b) found by argument-dependent lookup.
+template<typename T>
+struct is_exact_integer : std::is_integral<T> {};
+
+template<>
+struct is_exact_integer<big_integer> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_exact_integer_v = is_exact_integer<T>::value;
+
+} // namespace cbt
@@ -17,25 +17,58 @@
 
 #pragma once
 
+// Utilities
+#include "cbt/cmath.hpp"
+#include "cbt/instrumentation.hpp"
+#include "cbt/span.hpp"
+
 // Core transforms
 #include "cbt/logarithmic.hpp"
 #include "cbt/odds_ratio.hpp"
+#include "cbt/big_integer.hpp"
 #include "cbt/stern_brocot.hpp"
+#include "cbt/stern_brocot_lazy.hpp"
 #include "cbt/residue_number_system.hpp"
 #include "cbt/multiscale.hpp"
 
 // Additional transforms
 #include "cbt/dual.hpp"
+#include "cbt/dual_vec.hpp"
+#include "cbt/adjoint.hpp"
+#include "cbt/hyper_dual.hpp"
 #include "cbt/interval.hpp"
 #include "cbt/tropical.hpp"
 #include "cbt/modular.hpp"
 #include "cbt/quaternion.hpp"
 
+// Batched (structure-of-arrays) containers
+#include "cbt/lg_vector.hpp"
+#include "cbt/rns_array.hpp"
+#include "cbt/multiscale_array.hpp"
+#include "cbt/interval_array.hpp"
+#include "cbt/quaternion_array.hpp"
+
+// Transform-domain algorithms
+#include "cbt/ntt.hpp"
+#include "cbt/tropical_matrix.hpp"
+#include "cbt/tropical_sparse.hpp"
+#include "cbt/interval_bnb.hpp"
+#include "cbt/hmm.hpp"
+
 // Composed transforms
 #include "cbt/composed.hpp"
+#include "cbt/log_odds_scorer.hpp"
 
 // Inter-CBT mappings
 #include "cbt/mappings.hpp"
+#include "cbt/adaptive.hpp"
+
+// Algebraic traits and parallel algorithms
+#include "cbt/algebra.hpp"
+#include "cbt/parallel.hpp"
+
+// Serialization
+#include "cbt/serialization.hpp"
 
 namespace cbt {
 
@@ -92,6 +125,10 @@ namespace cbt {
  *   - Avoiding gimbal lock
  *   - Smooth interpolation
  * 
+ * Use adaptive_array when:
+ *   - The range of the data is unknown until run time
+ *   - Plain T should be used while it is safe, lg or multiscale otherwise
+ * 
  * Compose transforms when:
  *   - Need benefits of multiple transforms
  *   - Example: multiscale<lg<T>> for extreme-scale multiplication
@@ -0,0 +1,221 @@
+/**
+ * Constexpr Math - log, exp, log1p, expm1 and pow in Constant Expressions
+ *
+ * Transform: std::log(x) → series evaluation the compiler can run
+ *
+ * std::log and friends are not constexpr in C++17 (GCC folds them as
+ * builtins, other compilers reject them), so "constexpr" transforms that
+ * call them are not portably constant-evaluable. cbt::cmath dispatches:
+ * during constant evaluation it runs the kernels below, at run time it
+ * calls <cmath>. Constants and tables computed from transcendental values
+ * - priors, scale ladders, log tables - are then baked into the binary.
+ *
+ * Kernels work in long double: exp reduces by k·ln 2 (Cody-Waite split)
+ * and sums a Taylor series; log splits off the binary exponent and sums
+ * 2·atanh((m - 1)/(m + 1)); log1p and expm1 use Kahan's correction. For
+ * float and double results are within one ulp of the correctly rounded
+ * value on targets with an 80-bit long double (a few ulps where long
+ * double is double). Signed zeros are not distinguished.
+ *
+ * Trade-off:
+ *   Gain: Compile-time constants and tables cost nothing at startup; the
+ *         runtime path is unchanged (the dispatch folds away)
+ *   Loss: Constant-evaluated results may differ from the runtime libm in
+ *         the last bit; without a constant-evaluation query (pre-GCC 9,
+ *         pre-Clang 9) every call takes the runtime path
+ *
+ * Applications:
+ *   - constexpr lg, odds_ratio and log_odds constants
+ *   - Lookup tables of logarithms or powers in static storage
+ */
+
+#pragma once
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#if defined(__cpp_lib_is_constant_evaluated)
+#define CBT_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__clang__)
+#if __clang_major__ >= 9
+#define CBT_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+#define CBT_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define CBT_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#ifndef CBT_CONSTANT_EVALUATED
+#define CBT_CONSTANT_EVALUATED() false
+#endif
+
+namespace cbt {
+
+namespace detail {
+
+using cmath_wide = long double;
+
+constexpr cmath_wide cmath_ln2 = 0.693147180559945309417232121458176568L;
+constexpr cmath_wide cmath_ln2_hi = 0xb17217f7d1cp-44L;   // 44 bits: k·hi exact for |k| < 2²⁰
+constexpr cmath_wide cmath_ln2_lo = 5.49792301870837117471247161251343603e-14L;
+
+template<typename T>
+constexpr bool constexpr_isnan(T x) { return x != x; }
+
+template<typename T>
+constexpr bool constexpr_isinf(T x) {
+    return x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity();
+}
+
+/// 2ᵏ, exact for every representable power
+constexpr cmath_wide constexpr_power_of_two(int k) {
+    cmath_wide result = 1;
+    for (; k >= 64; k -= 64) result *= 0x1p64L;
+    for (; k <= -64; k += 64) result *= 0x1p-64L;
+    for (; k > 0; --k) result *= 2;
+    for (; k < 0; ++k) result /= 2;
+    return result;
+}
+
+/// e^x for finite x
+constexpr cmath_wide constexpr_exp(cmath_wide x) {
+    using limits = std::numeric_limits<cmath_wide>;
+    if (x >= limits::max_exponent * cmath_ln2) return limits::infinity();
+    if (x < (limits::min_exponent - limits::digits - 2) * cmath_ln2) return 0;
+    const cmath_wide q = x / cmath_ln2;
+    const int k = static_cast<int>(q + (q >= 0 ? 0.5L : -0.5L));
+    const cmath_wide r = (x - k * cmath_ln2_hi) - k * cmath_ln2_lo;   // |r| ≤ ln 2 / 2
+    // Taylor series to r²⁷/27! < 10⁻⁴⁰, Horner from the smallest term
+    cmath_wide p = 1;
+    for (int n = 27; n >= 1; --n) p = 1 + p * r / n;
+    // Scale in two steps so 2^(k-1) stays finite when the result is near the top
+    return k > 0 ? (2 * p) * constexpr_power_of_two(k - 1) : p * constexpr_power_of_two(k);
+}
+
+/// ln x for finite x > 0
+constexpr cmath_wide constexpr_log(cmath_wide x) {
+    int e = 0;
+    for (; x >= 0x1p64L; x *= 0x1p-64L) e += 64;
+    for (; x < 0x1p-64L; x *= 0x1p64L) e -= 64;
+    for (; x >= 1.41421356237309504880168872420969808L; x /= 2) ++e;
+    for (; x < 0.707106781186547524400844362104849039L; x *= 2) --e;
+    // ln m = 2·atanh(s) = 2(s + s³/3 + s⁵/5 + ...), |s| ≤ 0.172: 24 terms reach 10⁻³⁷
+    const cmath_wide s = (x - 1) / (x + 1), s2 = s * s;
+    cmath_wide p = cmath_wide(1) / 47;
+    for (int n = 45; n >= 1; n -= 2) p = p * s2 + cmath_wide(1) / n;
+    return (e * cmath_ln2_hi + 2 * s * p) + e * cmath_ln2_lo;
+}
+
+/// Narrow a wide result, saturating instead of converting out of range
+template<typename T>
+constexpr T cmath_narrow(cmath_wide w) {
+    using limits = std::numeric_limits<T>;
+    if (w > cmath_wide(limits::max())) return limits::infinity();
+    if (w < cmath_wide(limits::lowest())) return -limits::infinity();
+    return static_cast<T>(w);
+}
+
+} // namespace detail
+
+namespace cmath {
+
+template<typename T>
+constexpr bool isnan(T x) { return detail::constexpr_isnan(x); }
+
+template<typename T>
+constexpr bool isinf(T x) { return detail::constexpr_isinf(x); }
+
+template<typename T>
+constexpr T exp(T x) {
+    static_assert(std::is_floating_point_v<T>, "cmath::exp requires floating-point type");
+    if (CBT_CONSTANT_EVALUATED()) {
+        if (detail::constexpr_isnan(x)) return x;
+        return detail::cmath_narrow<T>(detail::constexpr_exp(x));
+    }
+    return std::exp(x);
+}
+
+template<typename T>
+constexpr T log(T x) {
+    static_assert(std::is_floating_point_v<T>, "cmath::log requires floating-point type");
+    if (CBT_CONSTANT_EVALUATED()) {
+        using limits = std::numeric_limits<T>;
+        if (detail::constexpr_isnan(x) || x < 0) return limits::quiet_NaN();
+        if (x == 0) return -limits::infinity();
+        if (x == limits::infinity()) return x;
+        return static_cast<T>(detail::constexpr_log(x));
+    }
+    return std::log(x);
+}
+
+/// ln(1 + x), accurate for small |x|
+template<typename T>
+constexpr T log1p(T x) {
+    static_assert(std::is_floating_point_v<T>, "cmath::log1p requires floating-point type");
+    if (CBT_CONSTANT_EVALUATED()) {
+        using limits = std::numeric_limits<T>;
+        if (detail::constexpr_isnan(x) || x < -1) return limits::quiet_NaN();
+        if (x == -1) return -limits::infinity();
+        if (x == limits::infinity()) return x;
+        // Kahan: the rounding in u = 1 + x cancels in x / (u - 1)
+        const detail::cmath_wide u = 1 + detail::cmath_wide(x);
+        if (u == 1) return x;
+        return static_cast<T>(detail::constexpr_log(u) * x / (u - 1));
+    }
+    return std::log1p(x);
+}
+
+/// e^x - 1, accurate for small |x|
+template<typename T>
+constexpr T expm1(T x) {
+    static_assert(std::is_floating_point_v<T>, "cmath::expm1 requires floating-point type");
+    if (CBT_CONSTANT_EVALUATED()) {
+        if (detail::constexpr_isnan(x)) return x;
+        if (x == -std::numeric_limits<T>::infinity()) return -1;
+        const detail::cmath_wide u = detail::constexpr_exp(x);
+        if (u == 1) return x;
+        if (detail::constexpr_isinf(u)) return detail::cmath_narrow<T>(u);
+        const detail::cmath_wide um1 = u - 1;
+        if (um1 == -1) return -1;
+        return detail::cmath_narrow<T>(um1 * x / detail::constexpr_log(u));
+    }
+    return std::expm1(x);
+}
+
+template<typename T>
+constexpr T pow(T x, T y) {
+    static_assert(std::is_floating_point_v<T>, "cmath::pow requires floating-point type");
+    if (CBT_CONSTANT_EVALUATED()) {
+        using limits = std::numeric_limits<T>;
+        if (y == 0 || x == 1) return 1;
+        if (detail::constexpr_isnan(x) || detail::constexpr_isnan(y)) return limits::quiet_NaN();
+        if (x == -1 && detail::constexpr_isinf(y)) return 1;
+        // Every float of magnitude ≥ 2⁶² is an even integer
+        const bool integral = (y >= T(0x1p62) || y <= -T(0x1p62)) ||
+                              y == T(static_cast<long long>(y));
+        const bool odd = integral && y < T(0x1p62) && y > -T(0x1p62) &&
+                         (static_cast<long long>(y) & 1) != 0;
+        if (x < 0 && !integral) return limits::quiet_NaN();
+        const T magnitude = x < 0 ? -x : x;
+        T result = 0;
+        if (magnitude == 0) {
+            result = y > 0 ? T(0) : limits::infinity();
+        } else if (magnitude == limits::infinity()) {
+            result = y > 0 ? limits::infinity() : T(0);
+        } else {
+            const detail::cmath_wide exponent = y * detail::constexpr_log(magnitude);
+            if (detail::constexpr_isinf(exponent)) {
+                result = exponent > 0 ? limits::infinity() : T(0);
+            } else {
+                result = detail::cmath_narrow<T>(detail::constexpr_exp(exponent));
+            }
+        }
+        return x < 0 && odd ? -result : result;
+    }
+    return std::pow(x, y);
+}
+
+} // namespace cmath
+
+} // namespace cbt
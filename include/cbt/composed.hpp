@@ -3,76 +3,505 @@
  * 
  * Principle: CBTs can be composed to combine their strengths
  * Examples:
- *   - multiscale<lg<T>>: Handle extreme scales with multiplication efficiency
+ *   - multiscale_log<T>: Handle extreme scales with multiplication efficiency
  *   - lg<odds_ratio<T>>: Log-odds for numerical stability in Bayesian inference
  *   - rns<stern_brocot<T>>: Parallel exact rational arithmetic
  */
 
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include "logarithmic.hpp"
 #include "multiscale.hpp"
 #include "odds_ratio.hpp"
+#include "span.hpp"
 
 namespace cbt {
 
-// Example: Multiscale logarithmic for physics simulations
-// Handles both extreme scales (quantum to cosmic) and efficient multiplication
+/**
+ * Multiscale logarithmic value: x = exp(scale·W + log_mantissa)
+ *
+ * Transform: x → (⌊log x / W⌋, log x mod W) with window W = 64 nats
+ *
+ * The integer carries the magnitude and the float only a log-mantissa in
+ * [0, W), so the absolute error of the log - hence the relative error of
+ * x - stays at ulp(W) however far x is from 1, where a plain lg loses digits
+ * as |log x| grows. W is a power of two, so scale·W and the split are exact.
+ *
+ * Trade-off:
+ *   Gain: × and ÷ are an integer add and a float add with one carry select;
+ *         + is log-sum-exp on the mantissas, never leaving the log domain
+ *   Loss: Positive values only (like lg); one extra integer per value
+ */
 template<typename T>
 class multiscale_log {
-    multiscale<lg<T>> value_;
-    
+    static_assert(std::is_floating_point_v<T>, "multiscale_log requires floating-point type");
+
 public:
-    multiscale_log() = default;
-    
-    explicit multiscale_log(T val) : value_(lg<T>(val)) {}
-    
-    // Multiplication is highly efficient
-    multiscale_log operator*(const multiscale_log& other) const {
+    using value_type = T;
+    using scale_type = std::int32_t;
+
+    /// Log-domain width of one scale level
+    static constexpr T window = T(64);
+
+private:
+    scale_type scale_;
+    T log_mantissa_;  ///< In [0, window); -∞ for zero, +∞ for infinity
+
+    static constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+
+    static multiscale_log make(scale_type scale, T log_mantissa) {
         multiscale_log result;
-        result.value_ = value_ * other.value_;
+        result.scale_ = scale;
+        result.log_mantissa_ = log_mantissa;
         return result;
     }
-    
-    T to_value() const {
-        return value_.to_value().value();
+
+    /// Split scale·W + log_mantissa into canonical form; scales saturate
+    static multiscale_log normalize(long long scale, T log_mantissa) {
+        if (!std::isfinite(log_mantissa)) return make(0, log_mantissa);
+        T k = std::floor(log_mantissa / window);
+        log_mantissa -= k * window;
+        long double total = static_cast<long double>(scale) + k;
+        constexpr long double lo = std::numeric_limits<scale_type>::min();
+        constexpr long double hi = std::numeric_limits<scale_type>::max();
+        total = total < lo ? lo : (total > hi ? hi : total);
+        return make(static_cast<scale_type>(total), log_mantissa);
+    }
+
+    /// Strict order of (scale, mantissa) pairs with zero below everything
+    bool less(const multiscale_log& other) const {
+        if (other.is_zero()) return false;
+        if (is_zero()) return true;
+        return scale_ < other.scale_ ||
+               (scale_ == other.scale_ && log_mantissa_ < other.log_mantissa_);
+    }
+
+public:
+    // Constructors
+    /// @brief Zero
+    multiscale_log() : scale_(0), log_mantissa_(neg_inf) {}
+
+    /// @brief Construct from a real value; values ≤ 0 map to zero
+    explicit multiscale_log(T value)
+        : multiscale_log(value > 0 ? from_log(std::log(value)) : multiscale_log()) {}
+
+    /// @brief From a log-domain value without an exp round trip
+    explicit multiscale_log(const lg<T>& value) : multiscale_log(from_log(value.log())) {}
+
+    // Factory methods
+    /// @brief x = exp(log_value)
+    static multiscale_log from_log(T log_value) { return normalize(0, log_value); }
+
+    /// @brief x = exp(scale·W + log_mantissa) for any finite log_mantissa
+    static multiscale_log from_parts(long long scale, T log_mantissa) {
+        return normalize(scale, log_mantissa);
+    }
+
+    /// @brief Trusted parts, log_mantissa already in [0, window)
+    static multiscale_log from_normalized(T log_mantissa, scale_type scale) {
+        return make(std::isfinite(log_mantissa) ? scale : 0, log_mantissa);
+    }
+
+    // Getters
+    scale_type scale_level() const { return scale_; }
+    T log_mantissa() const { return log_mantissa_; }
+    bool is_zero() const { return log_mantissa_ == neg_inf; }
+
+    /// @brief Natural log of the value (rounds once for huge scales)
+    T log() const { return static_cast<T>(scale_) * window + log_mantissa_; }
+
+    lg<T> to_lg() const { return lg<T>::from_log(log()); }
+
+    /// @brief Inverse transform
+    /// @warning May overflow or underflow in the real domain
+    T to_value() const { return std::exp(log()); }
+
+    // Arithmetic
+    /// @brief Product: scales add, mantissas add, one carry
+    multiscale_log operator*(const multiscale_log& other) const {
+        T m = log_mantissa_ + other.log_mantissa_;
+        long long s = static_cast<long long>(scale_) + other.scale_;
+        bool carry = m >= window;
+        m = carry ? m - window : m;
+        s = carry ? s + 1 : s;
+        if (!std::isfinite(m) || s != static_cast<scale_type>(s)) return normalize(s, m);
+        return make(static_cast<scale_type>(s), m);
+    }
+
+    /// @brief Quotient: scales subtract, mantissas subtract, one borrow
+    multiscale_log operator/(const multiscale_log& other) const {
+        T m = log_mantissa_ - other.log_mantissa_;
+        long long s = static_cast<long long>(scale_) - other.scale_;
+        bool borrow = m < 0;
+        m = borrow ? m + window : m;
+        s = borrow ? s - 1 : s;
+        if (!std::isfinite(m) || s != static_cast<scale_type>(s)) return normalize(s, m);
+        return make(static_cast<scale_type>(s), m);
     }
+
+    /// @brief Sum by log-sum-exp on the mantissas, aligned to the larger scale
+    multiscale_log operator+(const multiscale_log& other) const {
+        const multiscale_log& hi = less(other) ? other : *this;
+        const multiscale_log& lo = less(other) ? *this : other;
+        if (lo.is_zero() || !std::isfinite(hi.log_mantissa_)) return hi;
+        T diff = static_cast<T>(static_cast<long long>(lo.scale_) - hi.scale_) * window +
+                 (lo.log_mantissa_ - hi.log_mantissa_);
+        // log1p(e^diff) ≤ ln 2 < window, so at most one carry
+        T m = hi.log_mantissa_ + std::log1p(std::exp(diff));
+        return m >= window ? normalize(hi.scale_, m) : make(hi.scale_, m);
+    }
+
+    /// @brief xᵗ; the scale contributes exactly before the final split
+    multiscale_log pow(T exponent) const {
+        if (is_zero()) {
+            if (exponent == 0) return multiscale_log(T(1));
+            return exponent > 0 ? *this : make(0, -neg_inf);
+        }
+        T scaled = static_cast<T>(scale_) * exponent;
+        T whole = std::floor(scaled);
+        T m = (scaled - whole) * window + log_mantissa_ * exponent;
+        if (!std::isfinite(whole) || std::abs(whole) > T(std::numeric_limits<long long>::max() / 2)) {
+            return from_log(log() * exponent);
+        }
+        return normalize(static_cast<long long>(whole), m);
+    }
+
+    // Comparison
+    bool operator==(const multiscale_log& other) const {
+        return scale_ == other.scale_ && log_mantissa_ == other.log_mantissa_;
+    }
+    bool operator!=(const multiscale_log& other) const { return !(*this == other); }
+    bool operator<(const multiscale_log& other) const { return less(other); }
+    bool operator>(const multiscale_log& other) const { return other.less(*this); }
+    bool operator<=(const multiscale_log& other) const { return !other.less(*this); }
+    bool operator>=(const multiscale_log& other) const { return !less(other); }
 };
 
-// Example: Bayesian inference across scales
+/**
+ * Structure-of-arrays batch of multiscale_log values
+ *
+ * Log-mantissas and int32 scales live in separate arrays like lg_vector's
+ * logs; elementwise kernels are written with selects so the compiler can
+ * vectorize them, and reductions reuse the lane-blocked log-sum-exp.
+ */
+template<typename T>
+class multiscale_log_array {
+public:
+    using value_type = multiscale_log<T>;
+    using scale_type = typename value_type::scale_type;
+    static constexpr T window = value_type::window;
+
+private:
+    std::vector<T> log_mantissas_;
+    std::vector<scale_type> scales_;
+
+    void check_size(const multiscale_log_array& other) const {
+        if (size() != other.size()) {
+            throw std::invalid_argument("multiscale_log_array sizes must match");
+        }
+    }
+
+public:
+    // Constructors
+    multiscale_log_array() = default;
+
+    /// @brief n zeros
+    explicit multiscale_log_array(std::size_t n)
+        : log_mantissas_(n, -std::numeric_limits<T>::infinity()), scales_(n, 0) {}
+
+    /// @brief Batched forward transform, branch-free; values ≤ 0 map to zero
+    static multiscale_log_array from_values(span<const T> values) {
+        constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+        multiscale_log_array result(values.size());
+        const T* src = values.data();
+        T* dst = result.log_mantissas_.data();
+        scale_type* scales = result.scales_.data();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            T v = src[i];
+            T l = std::log(v);
+            bool positive = v > 0 && v < std::numeric_limits<T>::infinity();
+            // log of a finite T is far inside int32 levels, so no clamp
+            T k = positive ? std::floor(l / window) : T(0);
+            dst[i] = positive ? l - k * window : (v > 0 ? l : neg_inf);
+            scales[i] = static_cast<scale_type>(k);
+        }
+        return result;
+    }
+
+    static multiscale_log_array from_values(const std::vector<T>& values) {
+        return from_values(span<const T>(values));
+    }
+
+    /// @brief Batched inverse transform
+    /// @warning Elements may overflow or underflow in the real domain
+    std::vector<T> to_values() const {
+        std::vector<T> values(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            values[i] = std::exp(static_cast<T>(scales_[i]) * window + log_mantissas_[i]);
+        }
+        return values;
+    }
+
+    // Element access
+    std::size_t size() const { return log_mantissas_.size(); }
+    bool empty() const { return log_mantissas_.empty(); }
+
+    value_type get(std::size_t i) const {
+        return value_type::from_normalized(log_mantissas_[i], scales_[i]);
+    }
+
+    void set(std::size_t i, const value_type& value) {
+        log_mantissas_[i] = value.log_mantissa();
+        scales_[i] = value.scale_level();
+    }
+
+    span<const T> log_mantissas() const { return span<const T>(log_mantissas_); }
+    span<const scale_type> scales() const { return span<const scale_type>(scales_); }
+
+    // Batched arithmetic
+    /// @brief Elementwise product with one carry select per element
+    /// @note Scale sums beyond int32 wrap; the scalar operator saturates
+    multiscale_log_array operator*(const multiscale_log_array& other) const {
+        check_size(other);
+        multiscale_log_array result(size());
+        const T* a = log_mantissas_.data();
+        const T* b = other.log_mantissas_.data();
+        const scale_type* sa = scales_.data();
+        const scale_type* sb = other.scales_.data();
+        T* out = result.log_mantissas_.data();
+        scale_type* out_s = result.scales_.data();
+        for (std::size_t i = 0; i < size(); ++i) {
+            T m = a[i] + b[i];
+            bool carry = m >= window && m < std::numeric_limits<T>::infinity();
+            out[i] = carry ? m - window : m;
+            out_s[i] = m > -std::numeric_limits<T>::infinity()
+                           ? static_cast<scale_type>(static_cast<long long>(sa[i]) + sb[i] + carry)
+                           : 0;
+        }
+        return result;
+    }
+
+    /// @brief Elementwise sum, see multiscale_log::operator+
+    multiscale_log_array operator+(const multiscale_log_array& other) const {
+        check_size(other);
+        multiscale_log_array result(size());
+        for (std::size_t i = 0; i < size(); ++i) result.set(i, get(i) + other.get(i));
+        return result;
+    }
+
+    /// @brief Π of all elements: integer sum of scales, lane-summed mantissas
+    value_type product() const {
+        T lanes[detail::lg_lanes] = {};
+        long long scale = 0;
+        const std::size_t n = size();
+        std::size_t i = 0;
+        for (; i + detail::lg_lanes <= n; i += detail::lg_lanes) {
+            for (std::size_t l = 0; l < detail::lg_lanes; ++l) {
+                lanes[l] += log_mantissas_[i + l];
+                scale += scales_[i + l];
+            }
+        }
+        for (; i < n; ++i) {
+            lanes[0] += log_mantissas_[i];
+            scale += scales_[i];
+        }
+        T total = 0;
+        for (std::size_t l = 0; l < detail::lg_lanes; ++l) total += lanes[l];
+        return value_type::from_parts(scale, total);
+    }
+
+    /// @brief Σ of all elements: log-sum-exp relative to the maximum scale
+    value_type sum() const {
+        if (empty()) return value_type();
+        constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+        scale_type top = std::numeric_limits<scale_type>::min();
+        bool any = false;
+        for (std::size_t i = 0; i < size(); ++i) {
+            bool live = log_mantissas_[i] > neg_inf;
+            any = any || live;
+            top = live && scales_[i] > top ? scales_[i] : top;
+        }
+        if (!any) return value_type();
+        const T* m = log_mantissas_.data();
+        const scale_type* s = scales_.data();
+        T lse = detail::log_sum_exp<T>(size(), [m, s, top](std::size_t k) {
+            return m[k] + static_cast<T>(static_cast<long long>(s[k]) - top) * window;
+        });
+        return value_type::from_parts(top, lse);
+    }
+};
+
+namespace detail {
+
+inline int popcount64(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word; word &= word - 1) ++count;
+    return count;
+#endif
+}
+
+inline int countr_zero64(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int count = 0;
+    for (; !(word & 1); word >>= 1) ++count;
+    return count;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * Sequential Bayes over log-odds: prior + Σ log-likelihood ratios
+ *
+ * Each test's log LR for a positive and a negative outcome is computed once
+ * in add_test. With base = prior + Σ neg_i and delta_i = pos_i - neg_i, a
+ * result pattern scores base + Σ_{i positive} delta_i, so an update is pure
+ * adds over the set (or, for dense words, clear) bits of packed result
+ * words - no log, no probability round trip. A perfect test (a rate of 0
+ * or 1) has an infinite LLR, which base + delta would turn into ∞ - ∞; such
+ * tests are kept out of base and delta and add their observed outcome's
+ * LLR directly.
+ *
+ * Results are packed 64 tests per std::uint64_t word, test i in bit i % 64
+ * of word i / 64; batches store records_per_call × words_per_record() words
+ * row-major.
+ */
 template<typename T>
 class bayesian_diagnostic {
+    static_assert(std::is_floating_point_v<T>, "bayesian_diagnostic requires floating-point type");
+
 private:
     log_odds<T> prior_;
     std::vector<std::pair<T, T>> tests_;  // (sensitivity, specificity)
-    
+    std::vector<T> positive_llr_;
+    std::vector<T> negative_llr_;
+    std::vector<T> delta_;                // positive_llr - negative_llr
+    std::vector<T> word_total_;           // Σ delta per packed word
+    std::vector<std::size_t> definitive_; // tests with an infinite LLR
+    T base_;                              // prior + Σ finite negative_llr
+
+    /// Σ delta over the set bits of one word, tests [first, first + 64)
+    /// @details popcount picks the shorter walk: the set bits, or the clear
+    /// bits subtracted from the word's precomputed total, so a word costs
+    /// at most 32 adds. (A branch-free 64-lane mask select measured slower.)
+    T word_delta(std::uint64_t word, std::size_t w) const {
+        const std::size_t first = w * 64;
+        const std::size_t count = std::min<std::size_t>(64, tests_.size() - first);
+        const std::uint64_t valid = count < 64 ? (std::uint64_t(1) << count) - 1 : ~std::uint64_t(0);
+        word &= valid;
+        const T* d = delta_.data() + first;
+        T sum = 0;
+        if (2 * detail::popcount64(word) <= static_cast<int>(count)) {
+            for (; word; word &= word - 1) sum += d[detail::countr_zero64(word)];
+            return sum;
+        }
+        for (word = ~word & valid; word; word &= word - 1) sum += d[detail::countr_zero64(word)];
+        return word_total_[w] - sum;
+    }
+
 public:
     explicit bayesian_diagnostic(T prior_probability)
-        : prior_(log_odds<T>::from_probability(prior_probability)) {}
-    
+        : prior_(log_odds<T>::from_probability(prior_probability)),
+          base_(prior_.value()) {}
+
+    /// @brief Register a test and precompute its log-likelihood ratios
+    /// @throws std::invalid_argument unless both rates lie in [0, 1]
     void add_test(T sensitivity, T specificity) {
+        if (!(sensitivity >= 0 && sensitivity <= 1 && specificity >= 0 && specificity <= 1)) {
+            throw std::invalid_argument("Sensitivity and specificity must lie in [0, 1]");
+        }
         tests_.emplace_back(sensitivity, specificity);
+        // LR+ = sens / (1 - spec), LR- = (1 - sens) / spec
+        T positive = std::log(sensitivity) - std::log1p(-specificity);
+        T negative = std::log1p(-sensitivity) - std::log(specificity);
+        positive_llr_.push_back(positive);
+        negative_llr_.push_back(negative);
+        const bool finite = std::isfinite(positive) && std::isfinite(negative);
+        if (!finite) definitive_.push_back(tests_.size() - 1);
+        delta_.push_back(finite ? positive - negative : T(0));
+        if (tests_.size() % 64 == 1) word_total_.push_back(0);
+        word_total_.back() += delta_.back();
+        if (finite) base_ += negative;
     }
-    
-    // Update with test results
-    odds_ratio<T> update(const std::vector<bool>& results) const {
+
+    // Getters
+    std::size_t test_count() const { return tests_.size(); }
+    log_odds<T> prior() const { return prior_; }
+    T positive_llr(std::size_t test) const { return positive_llr_[test]; }
+    T negative_llr(std::size_t test) const { return negative_llr_[test]; }
+
+    /// @brief Packed words needed for one record of results
+    std::size_t words_per_record() const { return (tests_.size() + 63) / 64; }
+
+    /// @brief One streaming step: fold a single test outcome into current
+    log_odds<T> posterior(log_odds<T> current, std::size_t test, bool positive) const {
+        return current + log_odds<T>(positive ? positive_llr_[test] : negative_llr_[test]);
+    }
+
+    /// @brief Posterior for one record of packed results
+    log_odds<T> posterior(span<const std::uint64_t> words) const {
+        if (words.size() != words_per_record()) {
+            throw std::invalid_argument("Results must match number of tests");
+        }
+        T log_posterior = base_;
+        for (std::size_t w = 0; w < words.size(); ++w) {
+            log_posterior += word_delta(words[w], w);
+        }
+        for (std::size_t i : definitive_) {
+            log_posterior += (words[i / 64] >> (i % 64)) & 1 ? positive_llr_[i] : negative_llr_[i];
+        }
+        return log_odds<T>(log_posterior);
+    }
+
+    /// @brief Posterior for unpacked results; packs, then scores
+    log_odds<T> posterior(const std::vector<bool>& results) const {
         if (results.size() != tests_.size()) {
             throw std::invalid_argument("Results must match number of tests");
         }
-        
-        T log_posterior = prior_.value();
-        
-        for (size_t i = 0; i < results.size(); ++i) {
-            T likelihood_ratio;
-            if (results[i]) {  // Positive test
-                likelihood_ratio = tests_[i].first / (1 - tests_[i].second);
-            } else {  // Negative test
-                likelihood_ratio = (1 - tests_[i].first) / tests_[i].second;
-            }
-            log_posterior += std::log(likelihood_ratio);
+        std::vector<std::uint64_t> words(words_per_record(), 0);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            words[i / 64] |= std::uint64_t(results[i]) << (i % 64);
+        }
+        return posterior(span<const std::uint64_t>(words));
+    }
+
+    /// @brief posterior(results) as posterior odds, exp of the log-odds
+    odds_ratio<T> update(const std::vector<bool>& results) const {
+        return odds_ratio<T>(std::exp(posterior(results).value()));
+    }
+
+    /**
+     * @brief Score many records at once
+     * @param words records × words_per_record() packed results, row-major
+     * @return One posterior per record
+     */
+    std::vector<log_odds<T>> update_batch(span<const std::uint64_t> words) const {
+        const std::size_t stride = words_per_record();
+        if (stride == 0 || words.size() % stride != 0) {
+            throw std::invalid_argument("Batch size must be a multiple of words_per_record()");
         }
-        
-        return odds_ratio<T>::from_probability(
-            1.0 / (1.0 + std::exp(-log_posterior)));
+        const std::size_t records = words.size() / stride;
+        std::vector<log_odds<T>> posteriors(records);
+        for (std::size_t r = 0; r < records; ++r) {
+            posteriors[r] = posterior(words.subspan(r * stride, stride));
+        }
+        return posteriors;
+    }
+
+    std::vector<log_odds<T>> update_batch(const std::vector<std::uint64_t>& words) const {
+        return update_batch(span<const std::uint64_t>(words));
     }
 };
 
@@ -0,0 +1,277 @@
+/**
+ * Multi-Directional Dual Numbers - Forward-Mode AD over K Tangents
+ *
+ * Transform: f(x) → (f(x), ∇f(x)·[d₁ … d_K])
+ * Representation: a + Σ bᵢεᵢ where εᵢεⱼ = 0
+ *
+ * dual<T> (dual.hpp) carries one derivative, so a K-parameter gradient
+ * takes K evaluations. dual_vec<T, K> carries K tangents: one evaluation
+ * yields K directional derivatives, and every rule is the scalar chain-rule
+ * factor times a contiguous, aligned tangent array - a loop the compiler
+ * vectorizes.
+ *
+ * Trade-off:
+ *   Gain: One pass instead of K; the function value and every transcendental
+ *         are computed once and shared by all K lanes
+ *   Loss: Storage and arithmetic grow with K, and are spent on zero
+ *         tangents when fewer than K directions are live
+ *
+ * Applications:
+ *   - Gradients and Jacobians of models with tens of parameters
+ *   - Calibration and sensitivity analysis
+ *   - Newton solvers needing full Jacobians
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "span.hpp"
+
+namespace cbt {
+
+namespace detail {
+
+/// Widest SIMD-friendly alignment (≤ 64 bytes) that the tangent size allows
+template<typename T, std::size_t K>
+constexpr std::size_t dual_vec_alignment() {
+    constexpr std::size_t bytes = sizeof(T) * K;
+    if (bytes % 64 == 0) return 64;
+    if (bytes % 32 == 0) return 32;
+    if (bytes % 16 == 0) return 16;
+    return alignof(T);
+}
+
+} // namespace detail
+
+template<typename T, std::size_t K>
+class dual_vec {
+    static_assert(std::is_floating_point_v<T>, "dual_vec requires floating-point type");
+    static_assert(K > 0, "dual_vec needs at least one tangent direction");
+
+public:
+    using value_type = T;
+    using tangent_type = std::array<T, K>;
+    static constexpr std::size_t directions = K;
+
+private:
+    alignas(detail::dual_vec_alignment<T, K>()) tangent_type tangent_;
+    T real_;
+
+    /// Chain rule: (f(x), f'(x)·ẋ)
+    static dual_vec chain(T value, T slope, const dual_vec& x) {
+        dual_vec result(value);
+        for (std::size_t i = 0; i < K; ++i) result.tangent_[i] = slope * x.tangent_[i];
+        return result;
+    }
+
+public:
+    // Constructors
+    dual_vec() : dual_vec(T(0)) {}
+
+    dual_vec(T real) : tangent_{}, real_(real) {}
+
+    dual_vec(T real, const tangent_type& tangent) : tangent_(tangent), real_(real) {}
+
+    /// @brief Independent variable seeded along direction (tangent e_direction)
+    static dual_vec variable(T value, std::size_t direction) {
+        if (direction >= K) {
+            throw std::invalid_argument("dual_vec direction exceeds K");
+        }
+        dual_vec result(value);
+        result.tangent_[direction] = 1;
+        return result;
+    }
+
+    // Getters
+    T value() const { return real_; }
+    T derivative(std::size_t direction) const { return tangent_[direction]; }
+    const tangent_type& tangent() const { return tangent_; }
+
+    // Arithmetic
+    dual_vec& operator+=(const dual_vec& other) {
+        real_ += other.real_;
+        for (std::size_t i = 0; i < K; ++i) tangent_[i] += other.tangent_[i];
+        return *this;
+    }
+
+    dual_vec& operator-=(const dual_vec& other) {
+        real_ -= other.real_;
+        for (std::size_t i = 0; i < K; ++i) tangent_[i] -= other.tangent_[i];
+        return *this;
+    }
+
+    dual_vec& operator*=(const dual_vec& other) {
+        // Product rule: (fg)' = f'g + fg'
+        for (std::size_t i = 0; i < K; ++i) {
+            tangent_[i] = tangent_[i] * other.real_ + real_ * other.tangent_[i];
+        }
+        real_ *= other.real_;
+        return *this;
+    }
+
+    dual_vec& operator/=(const dual_vec& other) {
+        // Quotient rule as (f' - (f/g)·g')/g: one division for all lanes
+        T inv = 1 / other.real_;
+        T quotient = real_ * inv;
+        for (std::size_t i = 0; i < K; ++i) {
+            tangent_[i] = (tangent_[i] - quotient * other.tangent_[i]) * inv;
+        }
+        real_ = quotient;
+        return *this;
+    }
+
+    friend dual_vec operator+(dual_vec a, const dual_vec& b) { return a += b; }
+    friend dual_vec operator-(dual_vec a, const dual_vec& b) { return a -= b; }
+    friend dual_vec operator*(dual_vec a, const dual_vec& b) { return a *= b; }
+    friend dual_vec operator/(dual_vec a, const dual_vec& b) { return a /= b; }
+
+    // Scalar operands touch the tangent with one multiply, or not at all
+    friend dual_vec operator+(dual_vec a, T b) { a.real_ += b; return a; }
+    friend dual_vec operator+(T a, dual_vec b) { b.real_ += a; return b; }
+    friend dual_vec operator-(dual_vec a, T b) { a.real_ -= b; return a; }
+    friend dual_vec operator-(T a, const dual_vec& b) { return chain(a - b.real_, T(-1), b); }
+    friend dual_vec operator*(const dual_vec& a, T b) { return chain(a.real_ * b, b, a); }
+    friend dual_vec operator*(T a, const dual_vec& b) { return chain(a * b.real_, a, b); }
+    friend dual_vec operator/(const dual_vec& a, T b) { return a * (1 / b); }
+    friend dual_vec operator/(T a, const dual_vec& b) {
+        T inv = 1 / b.real_;
+        return chain(a * inv, -a * inv * inv, b);
+    }
+
+    // Unary functions
+    dual_vec operator-() const { return chain(-real_, T(-1), *this); }
+
+    // Mathematical functions with derivatives
+    friend dual_vec sin(const dual_vec& x) {
+        return chain(std::sin(x.real_), std::cos(x.real_), x);
+    }
+
+    friend dual_vec cos(const dual_vec& x) {
+        return chain(std::cos(x.real_), -std::sin(x.real_), x);
+    }
+
+    friend dual_vec exp(const dual_vec& x) {
+        T exp_val = std::exp(x.real_);
+        return chain(exp_val, exp_val, x);
+    }
+
+    friend dual_vec log(const dual_vec& x) {
+        return chain(std::log(x.real_), 1 / x.real_, x);
+    }
+
+    friend dual_vec pow(const dual_vec& x, T n) {
+        return chain(std::pow(x.real_, n), n * std::pow(x.real_, n - 1), x);
+    }
+
+    /// @brief xʸ = exp(y·log x); requires x > 0
+    friend dual_vec pow(const dual_vec& x, const dual_vec& y) {
+        T log_x = std::log(x.real_);
+        T pow_val = std::exp(y.real_ * log_x);
+        T dx = pow_val * y.real_ / x.real_;
+        T dy = pow_val * log_x;
+        dual_vec result(pow_val);
+        for (std::size_t i = 0; i < K; ++i) {
+            result.tangent_[i] = dx * x.tangent_[i] + dy * y.tangent_[i];
+        }
+        return result;
+    }
+
+    friend dual_vec sqrt(const dual_vec& x) {
+        T sqrt_val = std::sqrt(x.real_);
+        return chain(sqrt_val, 1 / (2 * sqrt_val), x);
+    }
+
+    // Comparison (based on real part)
+    bool operator==(const dual_vec& other) const { return real_ == other.real_; }
+    bool operator!=(const dual_vec& other) const { return real_ != other.real_; }
+    bool operator<(const dual_vec& other) const { return real_ < other.real_; }
+    bool operator>(const dual_vec& other) const { return real_ > other.real_; }
+
+    // Output
+    friend std::ostream& operator<<(std::ostream& os, const dual_vec& d) {
+        os << d.real_ << " + [";
+        for (std::size_t i = 0; i < K; ++i) os << (i ? ", " : "") << d.tangent_[i];
+        return os << "]ε";
+    }
+};
+
+/// @brief Dense m × n Jacobian with the function value it was taken at
+template<typename T>
+struct jacobian_result {
+    std::vector<T> values;  ///< f(x), length rows
+    std::vector<T> matrix;  ///< ∂fᵢ/∂xⱼ, row-major rows × cols
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+
+    T operator()(std::size_t i, std::size_t j) const { return matrix[i * cols + j]; }
+};
+
+/**
+ * @brief Jacobian of f: ℝⁿ → ℝᵐ in ⌈n/K⌉ forward sweeps
+ * @tparam K Tangent lanes per sweep
+ * @param f Callable taking const std::vector<dual_vec<T, K>>& and returning
+ *          std::vector<dual_vec<T, K>>
+ * @details Sweep s seeds inputs [sK, sK + K) with unit tangents; the other
+ * inputs are constants, so each output's tangent is one block of its row
+ */
+template<std::size_t K, typename T, typename F>
+jacobian_result<T> jacobian(F&& f, span<const T> x) {
+    using D = dual_vec<T, K>;
+    jacobian_result<T> result;
+    result.cols = x.size();
+    std::vector<D> inputs(x.size());
+    const std::size_t sweeps = x.empty() ? 1 : (x.size() + K - 1) / K;
+    for (std::size_t s = 0; s < sweeps; ++s) {
+        const std::size_t first = s * K;
+        for (std::size_t j = 0; j < x.size(); ++j) {
+            inputs[j] = j >= first && j < first + K ? D::variable(x[j], j - first) : D(x[j]);
+        }
+        std::vector<D> outputs = f(static_cast<const std::vector<D>&>(inputs));
+        if (s == 0) {
+            result.rows = outputs.size();
+            result.values.resize(outputs.size());
+            result.matrix.resize(outputs.size() * x.size());
+            for (std::size_t i = 0; i < outputs.size(); ++i) result.values[i] = outputs[i].value();
+        } else if (outputs.size() != result.rows) {
+            throw std::invalid_argument("jacobian: output size changed between sweeps");
+        }
+        const std::size_t width = std::min(K, x.size() - std::min(first, x.size()));
+        for (std::size_t i = 0; i < outputs.size(); ++i) {
+            for (std::size_t d = 0; d < width; ++d) {
+                result.matrix[i * x.size() + first + d] = outputs[i].derivative(d);
+            }
+        }
+    }
+    return result;
+}
+
+template<std::size_t K, typename T, typename F>
+jacobian_result<T> jacobian(F&& f, const std::vector<T>& x) {
+    return jacobian<K>(std::forward<F>(f), span<const T>(x));
+}
+
+/**
+ * @brief Gradient of f: ℝⁿ → ℝ in ⌈n/K⌉ forward sweeps
+ * @param f Callable taking const std::vector<dual_vec<T, K>>& and returning
+ *          dual_vec<T, K>
+ */
+template<std::size_t K, typename T, typename F>
+std::vector<T> gradient(F&& f, span<const T> x) {
+    using D = dual_vec<T, K>;
+    auto wrapped = [&f](const std::vector<D>& inputs) { return std::vector<D>{f(inputs)}; };
+    return jacobian<K>(wrapped, x).matrix;
+}
+
+template<std::size_t K, typename T, typename F>
+std::vector<T> gradient(F&& f, const std::vector<T>& x) {
+    return gradient<K>(std::forward<F>(f), span<const T>(x));
+}
+
+} // namespace cbt
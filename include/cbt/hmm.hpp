@@ -0,0 +1,559 @@
+/**
+ * Hidden Markov Models - Streaming Viterbi and Forward Decoding
+ *
+ * Transform: most likely state path → max-plus matrix-vector products
+ *   δₜ(j) = maxᵢ (δₜ₋₁(i) + log Aᵢⱼ) + log bⱼ(oₜ)        (tropical_max)
+ *   αₜ(j) = log Σᵢ exp(αₜ₋₁(i) + log Aᵢⱼ) + log bⱼ(oₜ)   (lg)
+ *
+ * Transitions are dense (row-major) or sparse (a tropical_sparse_matrix of
+ * edges i → j); frames arrive one at a time as log emission scores. Each
+ * step is a push over the surviving states: row i is added to δᵢ and
+ * max-ed into the next frame with a branch-free select that keeps the
+ * argmax, a loop over contiguous j that vectorizes wherever the target has
+ * a blend (SSE4.1 and later, e.g. -march=x86-64-v3, or NEON). Scores are
+ * renormalized to a maximum of 0 every frame, so long streams never drift
+ * toward -∞, and states more than `beam` below the best are dropped.
+ *
+ * Backpointers are packed at ⌈log₂ n⌉ bits per state per frame. Every
+ * checkpoint_interval frames the decoder traces the survivors back until
+ * they merge; the path up to that frame is final, is moved to the
+ * committed output and its backpointers are freed (a check that finds no
+ * merge doubles the wait for the next). Memory is O(states) plus the
+ * window since the last merge, which max_lag bounds outright.
+ *
+ * The forward pass works in the scaled linear domain: with the maximum of
+ * α at 0, exp(αᵢ) ≤ 1 multiplies precomputed linear transition weights, so
+ * a step is n exps, one multiply-add per transition and n logs.
+ *
+ * Trade-off:
+ *   Gain: O(nnz) per frame with a vectorized dense kernel, O(n) resident
+ *         state, backpointers at a few bits each, output while streaming
+ *   Loss: Beam pruning and max_lag trade exactness for speed and memory;
+ *         forward terms below e^-745 (e^-103 for float) of the best state
+ *         underflow to 0
+ *
+ * Applications:
+ *   - Speech and handwriting decoding, log and event-stream segmentation
+ *   - Online filtering, P(state | observations so far), and likelihoods
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "logarithmic.hpp"
+#include "span.hpp"
+#include "tropical.hpp"
+#include "tropical_sparse.hpp"
+
+namespace cbt {
+
+namespace detail {
+
+/// Frames of ⌈log₂ states⌉-bit state indices packed into 64-bit words
+class packed_backpointers {
+    std::size_t states_ = 0;
+    unsigned bits_ = 1;
+    std::size_t words_per_frame_ = 0;
+    std::vector<std::uint64_t> words_;
+
+public:
+    packed_backpointers() = default;
+
+    explicit packed_backpointers(std::size_t states) : states_(states) {
+        while (bits_ < 32 && (std::size_t(1) << bits_) < states) ++bits_;
+        words_per_frame_ = (states * bits_ + 63) / 64;
+    }
+
+    unsigned bits() const { return bits_; }
+    std::size_t frames() const { return words_per_frame_ ? words_.size() / words_per_frame_ : 0; }
+    std::size_t bytes() const { return words_.size() * sizeof(std::uint64_t); }
+
+    void push(const std::uint32_t* from) {
+        const std::size_t offset = words_.size();
+        words_.resize(offset + words_per_frame_, 0);
+        std::uint64_t* frame = words_.data() + offset;
+        for (std::size_t j = 0; j < states_; ++j) {
+            const std::size_t bit = j * bits_, shift = bit % 64;
+            const std::uint64_t v = from[j];
+            frame[bit / 64] |= v << shift;
+            if (shift + bits_ > 64) frame[bit / 64 + 1] |= v >> (64 - shift);
+        }
+    }
+
+    std::uint32_t get(std::size_t frame, std::size_t state) const {
+        const std::uint64_t* words = words_.data() + frame * words_per_frame_;
+        const std::size_t bit = state * bits_, shift = bit % 64;
+        std::uint64_t v = words[bit / 64] >> shift;
+        if (shift + bits_ > 64) v |= words[bit / 64 + 1] << (64 - shift);
+        return static_cast<std::uint32_t>(v & ((std::uint64_t(1) << bits_) - 1));
+    }
+
+    void drop_front(std::size_t frames) {
+        words_.erase(words_.begin(), words_.begin() + static_cast<std::ptrdiff_t>(frames * words_per_frame_));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief HMM transition model, log Aᵢⱼ for i → j
+ * @details Kept in log form for Viterbi and linear form for the forward
+ * pass. -∞ (or an absent sparse entry) means no transition.
+ */
+template<typename T>
+class hmm_transitions {
+    static_assert(std::is_floating_point_v<T>, "hmm_transitions requires floating-point type");
+
+private:
+    std::size_t states_ = 0;
+    bool dense_ = true;
+    std::vector<T> log_;                 ///< Dense: row-major n × n; sparse: per entry
+    std::vector<T> linear_;              ///< exp(log_)
+    std::vector<std::size_t> row_ptr_;   ///< Sparse rows by source state
+    std::vector<std::size_t> col_idx_;
+
+    static void check_states(std::size_t states) {
+        if (states == 0) throw std::invalid_argument("HMM needs at least one state");
+        if (states > (std::size_t(1) << 32)) throw std::invalid_argument("HMM state count exceeds 2^32");
+    }
+
+    template<typename Get>
+    static hmm_transitions dense(std::size_t states, std::size_t size, Get log_at) {
+        check_states(states);
+        if (size != states * states) throw std::invalid_argument("dense transitions must be states × states");
+        hmm_transitions result;
+        result.states_ = states;
+        result.log_.resize(size);
+        result.linear_.resize(size);
+        for (std::size_t p = 0; p < size; ++p) {
+            result.log_[p] = log_at(p);
+            result.linear_[p] = std::exp(result.log_[p]);
+        }
+        return result;
+    }
+
+public:
+    /// @param log_probs Row-major log Aᵢⱼ, states × states
+    /// @throws std::invalid_argument on a size mismatch or zero states
+    static hmm_transitions from_dense(std::size_t states, span<const tropical_max<T>> log_probs) {
+        return dense(states, log_probs.size(), [&](std::size_t p) { return log_probs[p].value(); });
+    }
+
+    static hmm_transitions from_dense(std::size_t states, const std::vector<tropical_max<T>>& log_probs) {
+        return from_dense(states, span<const tropical_max<T>>(log_probs));
+    }
+
+    /// @param probs Row-major Aᵢⱼ as lg values
+    static hmm_transitions from_dense(std::size_t states, span<const lg<T>> probs) {
+        return dense(states, probs.size(), [&](std::size_t p) { return probs[p].log(); });
+    }
+
+    static hmm_transitions from_dense(std::size_t states, const std::vector<lg<T>>& probs) {
+        return from_dense(states, span<const lg<T>>(probs));
+    }
+
+    /// @param log_probs Entry (i, j) is log Aᵢⱼ; parallel entries are combined
+    ///        by max (Viterbi) and by sum (forward)
+    /// @throws std::invalid_argument unless the matrix is square and non-empty
+    static hmm_transitions from_sparse(const tropical_sparse_matrix<tropical_max<T>>& log_probs) {
+        if (log_probs.rows() != log_probs.cols()) throw std::invalid_argument("sparse transitions must be square");
+        check_states(log_probs.rows());
+        hmm_transitions result;
+        result.states_ = log_probs.rows();
+        result.dense_ = false;
+        result.log_ = log_probs.values();
+        result.row_ptr_ = log_probs.row_ptr();
+        result.col_idx_ = log_probs.col_idx();
+        result.linear_.resize(result.log_.size());
+        for (std::size_t p = 0; p < result.log_.size(); ++p) result.linear_[p] = std::exp(result.log_[p]);
+        return result;
+    }
+
+    // Getters
+    std::size_t states() const { return states_; }
+    bool is_dense() const { return dense_; }
+    std::size_t nnz() const { return log_.size(); }
+    const std::vector<T>& log_weights() const { return log_; }
+    const std::vector<T>& linear_weights() const { return linear_; }
+    const std::vector<std::size_t>& row_ptr() const { return row_ptr_; }
+    const std::vector<std::size_t>& col_idx() const { return col_idx_; }
+};
+
+template<typename T>
+struct viterbi_options {
+    T beam = std::numeric_limits<T>::infinity();   ///< Drop states this far (in log) below the best
+    std::size_t checkpoint_interval = 64;          ///< Frames between merge checks; 0 never commits early
+    std::size_t max_lag = 0;                       ///< Commit the best path beyond this many open frames; 0 = exact
+};
+
+/**
+ * @brief Streaming max-plus Viterbi decoder
+ * @details The transitions are referenced, not copied, and must outlive
+ * the decoder. Ties go to the lowest-numbered predecessor.
+ */
+template<typename T>
+class viterbi_decoder {
+    static_assert(std::is_floating_point_v<T>, "viterbi_decoder requires floating-point type");
+
+    static constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+
+    const hmm_transitions<T>* transitions_;
+    viterbi_options<T> options_;
+    std::size_t n_;
+    std::vector<T> initial_;
+    std::vector<T> score_;                 ///< δ minus offset_; the best is 0
+    std::vector<T> next_;
+    std::vector<std::uint32_t> from_;
+    std::vector<std::uint32_t> active_;    ///< States with a finite score
+    std::size_t best_state_ = 0;
+    T offset_ = 0;
+
+    std::size_t frames_ = 0;
+    std::size_t first_open_ = 0;           ///< Frames before this are committed
+    detail::packed_backpointers backpointers_;   ///< Frames first_open_ + 1 ...
+    std::vector<std::size_t> committed_;   ///< Committed, not yet taken
+    std::vector<std::size_t> stamp_;
+    std::size_t epoch_ = 0;
+    std::size_t check_interval_;
+    std::size_t next_check_;
+    std::vector<std::uint32_t> set_, other_;
+
+    std::uint32_t predecessor(std::size_t frame, std::size_t state) const {
+        return backpointers_.get(frame - first_open_ - 1, state);
+    }
+
+    /// States at frames [first, last] on the path ending in `state` at last
+    void trace(std::size_t last, std::size_t state, std::size_t first, std::size_t* out) const {
+        for (std::size_t f = last;; --f) {
+            out[f - first] = state;
+            if (f == first) break;
+            state = predecessor(f, state);
+        }
+    }
+
+    /// Frames first_open_ ... k become final with state s at k
+    void commit_through(std::size_t k, std::size_t s) {
+        const std::size_t begin = committed_.size();
+        committed_.resize(begin + (k - first_open_ + 1));
+        trace(k, s, first_open_, committed_.data() + begin);
+        const std::size_t stored_end = frames_ - 1;   // last frame with backpointers
+        backpointers_.drop_front(std::min(k + 1, stored_end) - first_open_);
+        first_open_ = k + 1;
+    }
+
+    /// Commit up to the frame where every surviving path merges
+    bool commit_merged() {
+        if (active_.empty()) return false;
+        set_.assign(active_.begin(), active_.end());
+        std::size_t f = frames_ - 1;
+        while (set_.size() > 1 && f > first_open_) {
+            ++epoch_;
+            other_.clear();
+            for (std::uint32_t s : set_) {
+                std::uint32_t p = predecessor(f, s);
+                if (stamp_[p] != epoch_) {
+                    stamp_[p] = epoch_;
+                    other_.push_back(p);
+                }
+            }
+            set_.swap(other_);
+            --f;
+        }
+        if (set_.size() != 1) return false;
+        commit_through(f, set_[0]);
+        return true;
+    }
+
+    /// Too many open frames: commit half the window along the best path and
+    /// drop survivors that descend from another state at the commit point
+    void commit_lagging() {
+        const std::size_t last = frames_ - 1;
+        const std::size_t k = last - options_.max_lag / 2;
+        if (k < first_open_) return;
+        std::size_t anchor = best_state_;
+        for (std::size_t f = last; f > k; --f) anchor = predecessor(f, anchor);
+        std::size_t kept = 0;
+        for (std::uint32_t s : active_) {
+            std::size_t ancestor = s;
+            for (std::size_t f = last; f > k; --f) ancestor = predecessor(f, ancestor);
+            if (ancestor == anchor) {
+                active_[kept++] = s;
+            } else {
+                score_[s] = neg_inf;
+            }
+        }
+        active_.resize(kept);
+        commit_through(k, anchor);
+    }
+
+    void relax_dense() {
+        const T* log_weights = transitions_->log_weights().data();
+        T* next = next_.data();
+        std::uint32_t* from = from_.data();
+        for (std::uint32_t i : active_) {
+            const T d = score_[i];
+            const T* row = log_weights + std::size_t(i) * n_;
+            // Branch-free max with argmax: selects, no data-dependent jumps
+            for (std::size_t j = 0; j < n_; ++j) {
+                const T candidate = d + row[j];
+                const bool better = candidate > next[j];
+                next[j] = better ? candidate : next[j];
+                from[j] = better ? i : from[j];
+            }
+        }
+    }
+
+    void relax_sparse() {
+        const auto& row_ptr = transitions_->row_ptr();
+        const auto& col_idx = transitions_->col_idx();
+        const auto& log_weights = transitions_->log_weights();
+        for (std::uint32_t i : active_) {
+            const T d = score_[i];
+            for (std::size_t p = row_ptr[i]; p < row_ptr[i + 1]; ++p) {
+                const std::size_t j = col_idx[p];
+                const T candidate = d + log_weights[p];
+                if (candidate > next_[j]) {
+                    next_[j] = candidate;
+                    from_[j] = i;
+                }
+            }
+        }
+    }
+
+    /// Shift the best score to 0 and apply the beam
+    void normalize() {
+        T best = neg_inf;
+        best_state_ = 0;
+        for (std::size_t j = 0; j < n_; ++j) {
+            if (score_[j] > best) {
+                best = score_[j];
+                best_state_ = j;
+            }
+        }
+        active_.clear();
+        if (best == neg_inf) return;   // every path is impossible
+        offset_ += best;
+        const T floor = -options_.beam;
+        for (std::size_t j = 0; j < n_; ++j) {
+            const T s = score_[j] - best;
+            const bool keep = s > neg_inf && !(s < floor);
+            score_[j] = keep ? s : neg_inf;
+            if (keep) active_.push_back(static_cast<std::uint32_t>(j));
+        }
+    }
+
+public:
+    /**
+     * @param transitions Model, referenced for the decoder's lifetime
+     * @param initial log πⱼ, one per state
+     * @throws std::invalid_argument if initial has the wrong size
+     */
+    viterbi_decoder(const hmm_transitions<T>& transitions, span<const tropical_max<T>> initial,
+                    viterbi_options<T> options = viterbi_options<T>())
+        : transitions_(&transitions), options_(options), n_(transitions.states()),
+          initial_(n_), score_(n_, neg_inf), next_(n_), from_(n_), backpointers_(n_), stamp_(n_, 0),
+          check_interval_(options.checkpoint_interval), next_check_(options.checkpoint_interval) {
+        if (initial.size() != n_) throw std::invalid_argument("initial distribution must have one entry per state");
+        for (std::size_t j = 0; j < n_; ++j) initial_[j] = initial[j].value();
+        active_.reserve(n_);
+    }
+
+    viterbi_decoder(const hmm_transitions<T>& transitions, const std::vector<tropical_max<T>>& initial,
+                    viterbi_options<T> options = viterbi_options<T>())
+        : viterbi_decoder(transitions, span<const tropical_max<T>>(initial), options) {}
+
+    /// @brief Consume one frame of log emission scores log bⱼ(oₜ)
+    /// @throws std::invalid_argument if emission has the wrong size
+    void step(span<const tropical_max<T>> emission) {
+        if (emission.size() != n_) throw std::invalid_argument("emission must have one score per state");
+        if (frames_ == 0) {
+            for (std::size_t j = 0; j < n_; ++j) score_[j] = initial_[j] + emission[j].value();
+        } else {
+            std::fill(next_.begin(), next_.end(), neg_inf);
+            std::fill(from_.begin(), from_.end(), 0);
+            if (transitions_->is_dense()) {
+                relax_dense();
+            } else {
+                relax_sparse();
+            }
+            for (std::size_t j = 0; j < n_; ++j) score_[j] = next_[j] + emission[j].value();
+            if (frames_ > first_open_) backpointers_.push(from_.data());
+        }
+        ++frames_;
+        normalize();
+        if (options_.checkpoint_interval && frames_ >= next_check_) {
+            // A failed check doubles the wait, so paths that never merge
+            // cost amortized O(states) per frame instead of O(window)
+            check_interval_ = commit_merged() ? options_.checkpoint_interval : 2 * check_interval_;
+            next_check_ = frames_ + check_interval_;
+        }
+        if (options_.max_lag && frames_ - first_open_ > options_.max_lag) commit_lagging();
+    }
+
+    void step(const std::vector<tropical_max<T>>& emission) { step(span<const tropical_max<T>>(emission)); }
+
+    // Getters
+    std::size_t states() const { return n_; }
+    std::size_t frames() const { return frames_; }
+    std::size_t committed_frames() const { return first_open_; }
+    std::size_t active_states() const { return active_.size(); }
+    std::size_t backpointer_bytes() const { return backpointers_.bytes(); }
+    unsigned backpointer_bits() const { return backpointers_.bits(); }
+    std::size_t best_state() const { return best_state_; }
+
+    /// @brief log-score of the best path so far (max-plus value of δₜ)
+    tropical_max<T> best_score() const { return tropical_max<T>(active_.empty() ? neg_inf : offset_); }
+
+    /// @brief δₜ(j), the best log-score of a path ending in state j
+    tropical_max<T> score(std::size_t state) const { return tropical_max<T>(score_[state] + offset_); }
+
+    /**
+     * @brief Final states for committed frames not yet taken, in order
+     * @details Frames are committed once every surviving path agrees on
+     * them (or by max_lag); taking them frees their memory
+     */
+    std::vector<std::size_t> take_committed() {
+        std::vector<std::size_t> result;
+        result.swap(committed_);
+        return result;
+    }
+
+    /// @brief Best path over every frame not yet taken by take_committed()
+    std::vector<std::size_t> path() const {
+        std::vector<std::size_t> result(committed_);
+        if (frames_ > first_open_) {
+            const std::size_t begin = result.size();
+            result.resize(begin + (frames_ - first_open_));
+            trace(frames_ - 1, best_state_, first_open_, result.data() + begin);
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Streaming forward algorithm: filtering and likelihood in the log domain
+ * @details The transitions are referenced, not copied, and must outlive
+ * the filter.
+ */
+template<typename T>
+class hmm_forward {
+    static_assert(std::is_floating_point_v<T>, "hmm_forward requires floating-point type");
+
+    static constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+
+    const hmm_transitions<T>* transitions_;
+    T beam_;
+    std::size_t n_;
+    std::vector<T> initial_;
+    std::vector<T> alpha_;                 ///< log αₜ minus offset_; the maximum is 0
+    std::vector<T> next_;
+    std::vector<std::uint32_t> active_;
+    T offset_ = 0;
+    std::size_t frames_ = 0;
+
+    void propagate_dense() {
+        const T* weights = transitions_->linear_weights().data();
+        T* next = next_.data();
+        for (std::uint32_t i : active_) {
+            const T p = std::exp(alpha_[i]);
+            const T* row = weights + std::size_t(i) * n_;
+            for (std::size_t j = 0; j < n_; ++j) next[j] += p * row[j];
+        }
+    }
+
+    void propagate_sparse() {
+        const auto& row_ptr = transitions_->row_ptr();
+        const auto& col_idx = transitions_->col_idx();
+        const auto& weights = transitions_->linear_weights();
+        for (std::uint32_t i : active_) {
+            const T p = std::exp(alpha_[i]);
+            for (std::size_t q = row_ptr[i]; q < row_ptr[i + 1]; ++q) next_[col_idx[q]] += p * weights[q];
+        }
+    }
+
+    void normalize() {
+        T best = neg_inf;
+        for (std::size_t j = 0; j < n_; ++j) best = std::max(best, alpha_[j]);
+        active_.clear();
+        if (best == neg_inf) return;
+        offset_ += best;
+        const T floor = -beam_;
+        for (std::size_t j = 0; j < n_; ++j) {
+            const T a = alpha_[j] - best;
+            const bool keep = a > neg_inf && !(a < floor);
+            alpha_[j] = keep ? a : neg_inf;
+            if (keep) active_.push_back(static_cast<std::uint32_t>(j));
+        }
+    }
+
+public:
+    /**
+     * @param initial πⱼ, one per state
+     * @param beam Drop states whose log α is this far below the best
+     * @throws std::invalid_argument if initial has the wrong size
+     */
+    hmm_forward(const hmm_transitions<T>& transitions, span<const lg<T>> initial,
+                T beam = std::numeric_limits<T>::infinity())
+        : transitions_(&transitions), beam_(beam), n_(transitions.states()),
+          initial_(n_), alpha_(n_, neg_inf), next_(n_) {
+        if (initial.size() != n_) throw std::invalid_argument("initial distribution must have one entry per state");
+        for (std::size_t j = 0; j < n_; ++j) initial_[j] = initial[j].log();
+        active_.reserve(n_);
+    }
+
+    hmm_forward(const hmm_transitions<T>& transitions, const std::vector<lg<T>>& initial,
+                T beam = std::numeric_limits<T>::infinity())
+        : hmm_forward(transitions, span<const lg<T>>(initial), beam) {}
+
+    /// @brief Consume one frame of emission probabilities bⱼ(oₜ)
+    /// @throws std::invalid_argument if emission has the wrong size
+    void step(span<const lg<T>> emission) {
+        if (emission.size() != n_) throw std::invalid_argument("emission must have one score per state");
+        if (frames_ == 0) {
+            for (std::size_t j = 0; j < n_; ++j) alpha_[j] = initial_[j] + emission[j].log();
+        } else {
+            std::fill(next_.begin(), next_.end(), T(0));
+            if (transitions_->is_dense()) {
+                propagate_dense();
+            } else {
+                propagate_sparse();
+            }
+            for (std::size_t j = 0; j < n_; ++j) alpha_[j] = std::log(next_[j]) + emission[j].log();
+        }
+        ++frames_;
+        normalize();
+    }
+
+    void step(const std::vector<lg<T>>& emission) { step(span<const lg<T>>(emission)); }
+
+    // Getters
+    std::size_t states() const { return n_; }
+    std::size_t frames() const { return frames_; }
+    std::size_t active_states() const { return active_.size(); }
+
+    /// @brief P(o₁ ... oₜ), without leaving the log domain
+    lg<T> likelihood() const {
+        if (active_.empty()) return lg<T>();
+        const T* alpha = alpha_.data();
+        return lg<T>::from_log(offset_ + detail::log_sum_exp<T>(n_, [alpha](std::size_t j) { return alpha[j]; }));
+    }
+
+    /// @brief P(stateₜ = j | o₁ ... oₜ) for every state
+    std::vector<lg<T>> filtered() const {
+        std::vector<lg<T>> result(n_);
+        if (active_.empty()) return result;
+        const T* alpha = alpha_.data();
+        const T total = detail::log_sum_exp<T>(n_, [alpha](std::size_t j) { return alpha[j]; });
+        for (std::size_t j = 0; j < n_; ++j) result[j] = lg<T>::from_log(alpha_[j] - total);
+        return result;
+    }
+};
+
+} // namespace cbt
@@ -0,0 +1,129 @@
+/**
+ * Hyper-Dual Numbers - Exact Second Derivatives
+ *
+ * Transform: f(x) → (f, ∂₁f, ∂₂f, ∂₁∂₂f)
+ * Representation: a + bε₁ + cε₂ + dε₁ε₂ where ε₁² = ε₂² = 0, ε₁ε₂ ≠ 0
+ *
+ * Seeding x = a + v·ε₁ + w·ε₂ gives ε₁ε₂ = vᵀ H w exactly: no step size,
+ * no cancellation, unlike finite differences of gradients.
+ *
+ * Trade-off:
+ *   Gain: Exact second derivatives; every elementary function is one fused
+ *         rule using f, f′ and f″ of the real part
+ *   Loss: Four times the storage of T; one Hessian entry (or one bilinear
+ *         form) per evaluation - see tape::hessian_vector for H·v at once
+ *
+ * Applications:
+ *   - Newton steps and curvature checks in optimizers
+ *   - Second-order sensitivity analysis
+ */
+
+#pragma once
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+namespace cbt {
+
+template<typename T>
+class hyper_dual {
+    static_assert(std::is_floating_point_v<T>, "hyper_dual requires floating-point type");
+
+private:
+    T real_;   // f
+    T e1_;     // ∂f along ε₁
+    T e2_;     // ∂f along ε₂
+    T e12_;    // mixed second derivative
+
+    /// Chain rule to second order: (f, f′ẋ₁, f′ẋ₂, f′ẋ₁₂ + f″ẋ₁ẋ₂)
+    static hyper_dual chain(const hyper_dual& x, T f, T df, T d2f) {
+        return hyper_dual(f, df * x.e1_, df * x.e2_, df * x.e12_ + d2f * x.e1_ * x.e2_);
+    }
+
+public:
+    // Constructors
+    hyper_dual() : hyper_dual(T(0)) {}
+    hyper_dual(T real) : real_(real), e1_(0), e2_(0), e12_(0) {}
+    hyper_dual(T real, T e1, T e2, T e12) : real_(real), e1_(e1), e2_(e2), e12_(e12) {}
+
+    /// @brief Variable seeded in both directions: e12 of f(x) is f″(x)
+    static hyper_dual variable(T value) { return hyper_dual(value, 1, 1, 0); }
+
+    // Getters
+    T value() const { return real_; }
+    T derivative() const { return e1_; }            ///< ∂f along ε₁
+    T derivative2() const { return e2_; }           ///< ∂f along ε₂
+    T second_derivative() const { return e12_; }    ///< ∂₁∂₂f
+
+    // Arithmetic
+    hyper_dual operator+(const hyper_dual& other) const {
+        return hyper_dual(real_ + other.real_, e1_ + other.e1_, e2_ + other.e2_, e12_ + other.e12_);
+    }
+
+    hyper_dual operator-(const hyper_dual& other) const {
+        return hyper_dual(real_ - other.real_, e1_ - other.e1_, e2_ - other.e2_, e12_ - other.e12_);
+    }
+
+    hyper_dual operator*(const hyper_dual& other) const {
+        return hyper_dual(real_ * other.real_,
+                          e1_ * other.real_ + real_ * other.e1_,
+                          e2_ * other.real_ + real_ * other.e2_,
+                          e12_ * other.real_ + e1_ * other.e2_ + e2_ * other.e1_ + real_ * other.e12_);
+    }
+
+    hyper_dual operator/(const hyper_dual& other) const {
+        // x · (1/y) with 1/y from the chain rule: f′ = -1/y², f″ = 2/y³
+        T inv = 1 / other.real_;
+        return *this * chain(other, inv, -inv * inv, 2 * inv * inv * inv);
+    }
+
+    // Unary functions
+    hyper_dual operator-() const { return hyper_dual(-real_, -e1_, -e2_, -e12_); }
+
+    // Mathematical functions with derivatives
+    friend hyper_dual sin(const hyper_dual& x) {
+        T s = std::sin(x.real_);
+        return chain(x, s, std::cos(x.real_), -s);
+    }
+
+    friend hyper_dual cos(const hyper_dual& x) {
+        T c = std::cos(x.real_);
+        return chain(x, c, -std::sin(x.real_), -c);
+    }
+
+    friend hyper_dual exp(const hyper_dual& x) {
+        T e = std::exp(x.real_);
+        return chain(x, e, e, e);
+    }
+
+    friend hyper_dual log(const hyper_dual& x) {
+        T inv = 1 / x.real_;
+        return chain(x, std::log(x.real_), inv, -inv * inv);
+    }
+
+    friend hyper_dual pow(const hyper_dual& x, T n) {
+        T p = std::pow(x.real_, n - 2);
+        return chain(x, std::pow(x.real_, n), n * std::pow(x.real_, n - 1), n * (n - 1) * p);
+    }
+
+    friend hyper_dual sqrt(const hyper_dual& x) {
+        T s = std::sqrt(x.real_);
+        T d = 1 / (2 * s);
+        return chain(x, s, d, -d / (2 * x.real_));
+    }
+
+    // Comparison (based on real part)
+    bool operator==(const hyper_dual& other) const { return real_ == other.real_; }
+    bool operator<(const hyper_dual& other) const { return real_ < other.real_; }
+
+    // Output
+    friend std::ostream& operator<<(std::ostream& os, const hyper_dual& h) {
+        return os << h.real_ << " + " << h.e1_ << "ε₁ + " << h.e2_ << "ε₂ + " << h.e12_ << "ε₁ε₂";
+    }
+};
+
+// Type alias
+using hyper_dualf = hyper_dual<float>;
+using hyper_duald = hyper_dual<double>;
+
+} // namespace cbt
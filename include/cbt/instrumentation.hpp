@@ -0,0 +1,220 @@
+/**
+ * Instrumentation - Opt-In Counters for Transform Hot Paths
+ *
+ * Transform: "which trade-off is this workload paying for?" → event counts
+ *
+ * Build with CBT_INSTRUMENTATION=1 (CMake: CBT_ENABLE_INSTRUMENTATION) and
+ * the transforms count their operations, conversions, normalization work,
+ * saturations and interval widening. Each thread increments its own block
+ * of counters with plain relaxed stores (no read-modify-write, no sharing);
+ * snapshot() sums every block, so reads are lock-free and never stall a
+ * writer. Blocks outlive their threads and are reused by later ones, so
+ * counts are never lost and memory is bounded by the peak thread count.
+ *
+ * Counters only grow. Measure an interval as the difference of two
+ * snapshots; a snapshot taken while other threads run is a sum of
+ * per-counter values, not an atomic cut across counters.
+ *
+ * Trade-off:
+ *   Gain: Answers "how often does lg hit -∞, how often does the CRT run"
+ *         in production; disabled (the default), every hook is an empty
+ *         inline function and compiles away
+ *   Loss: Enabled, each hooked operation adds a thread-local increment,
+ *         which also keeps elementwise loops over hooked operators from
+ *         vectorizing
+ *
+ * Applications:
+ *   - Choosing a transform per call site from measured operation mix
+ *   - Alerting on saturation or interval blow-up in long computations
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "cmath.hpp"
+
+#ifndef CBT_INSTRUMENTATION
+#define CBT_INSTRUMENTATION 0
+#endif
+
+namespace cbt {
+namespace instrumentation {
+
+enum class counter : std::size_t {
+    lg_ops,                      ///< lg *, /, + and pow
+    lg_conversions,              ///< lg(T) and value()
+    lg_zero,                     ///< non-positive inputs mapped to -∞
+    lg_value_saturations,        ///< value() of a finite log overflowed to ∞ or underflowed to 0
+    multiscale_ops,              ///< multiscale +, * and /
+    multiscale_normalizations,   ///< mantissa renormalizations
+    multiscale_normalize_steps,  ///< extra ×SCALE corrections after the exponent estimate
+    multiscale_saturations,      ///< levels clamped at 127 or -128
+    interval_ops,                ///< interval +, -, * and / (arrays count per element)
+    interval_division_entire,    ///< divisions by an interval containing 0
+    interval_width_growth_bits,  ///< Σ ⌊log₂(result width / widest operand)⌋ over widening ops
+    rns_ops,                     ///< residue +, - and *
+    rns_reconstructions,         ///< CRT reconstructions (to_integer, to_range_type)
+    conversions,                 ///< elements converted by mappings::cbt_converter
+    adaptive_switches,           ///< representation changes made by adaptive_array
+};
+
+constexpr std::size_t counter_count = static_cast<std::size_t>(counter::adaptive_switches) + 1;
+
+/// Stable metric names, in counter order
+constexpr const char* name(counter c) {
+    constexpr const char* names[counter_count] = {
+        "lg.ops", "lg.conversions", "lg.zero", "lg.value_saturations",
+        "multiscale.ops", "multiscale.normalizations", "multiscale.normalize_steps",
+        "multiscale.saturations",
+        "interval.ops", "interval.division_entire", "interval.width_growth_bits",
+        "rns.ops", "rns.reconstructions",
+        "mappings.conversions",
+        "adaptive.switches",
+    };
+    return names[static_cast<std::size_t>(c)];
+}
+
+/// Totals across all threads at one point in time
+struct counters {
+    std::array<std::uint64_t, counter_count> values{};
+
+    std::uint64_t operator[](counter c) const { return values[static_cast<std::size_t>(c)]; }
+
+    /// Counts accumulated since an earlier snapshot
+    counters operator-(const counters& earlier) const {
+        counters delta;
+        for (std::size_t i = 0; i < counter_count; ++i) delta.values[i] = values[i] - earlier.values[i];
+        return delta;
+    }
+
+    /// f(name, value) for every counter, e.g. to publish to a metrics system
+    template<typename F>
+    void for_each(F&& f) const {
+        for (std::size_t i = 0; i < counter_count; ++i) f(name(static_cast<counter>(i)), values[i]);
+    }
+};
+
+} // namespace instrumentation
+
+namespace detail {
+
+/// One thread's counters; only the leasing thread writes them
+struct counter_block {
+    std::array<std::atomic<std::uint64_t>, instrumentation::counter_count> values{};
+    std::atomic<bool> leased{true};
+    counter_block* next = nullptr;
+};
+
+inline std::atomic<counter_block*>& counter_blocks() {
+    static std::atomic<counter_block*> head{nullptr};
+    return head;
+}
+
+/// A thread's claim on a block: reuses a released one (its counts stay in
+/// the totals) or pushes a new one onto the lock-free list
+struct counter_lease {
+    counter_block* block;
+
+    counter_lease() : block(acquire()) {}
+    ~counter_lease() { block->leased.store(false, std::memory_order_release); }
+    counter_lease(const counter_lease&) = delete;
+    counter_lease& operator=(const counter_lease&) = delete;
+
+    static counter_block* acquire() {
+        auto& head = counter_blocks();
+        for (counter_block* b = head.load(std::memory_order_acquire); b != nullptr; b = b->next) {
+            bool released = false;
+            if (b->leased.compare_exchange_strong(released, true, std::memory_order_acq_rel)) return b;
+        }
+        auto* b = new counter_block();   // never freed: readers may be walking the list
+        b->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return b;
+    }
+};
+
+inline counter_block& local_counters() {
+    thread_local counter_lease lease;
+    return *lease.block;
+}
+
+} // namespace detail
+
+namespace instrumentation {
+
+/**
+ * Counting policy: policy<false> is the zero-cost stub, policy<true> the
+ * thread-local counters. Hooks go through active_policy, chosen by
+ * CBT_INSTRUMENTATION; nothing counts during constant evaluation.
+ */
+template<bool Enabled>
+struct policy {
+    static constexpr bool enabled = Enabled;
+
+    static constexpr void count(counter c, std::uint64_t n = 1) {
+        if constexpr (Enabled) {
+            if (!CBT_CONSTANT_EVALUATED()) {
+                // Single writer: load + store, no locked read-modify-write
+                auto& value = detail::local_counters().values[static_cast<std::size_t>(c)];
+                value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+        } else {
+            (void)c;
+            (void)n;
+        }
+    }
+
+    static counters snapshot() {
+        counters result;
+        if constexpr (Enabled) {
+            for (const detail::counter_block* b = detail::counter_blocks().load(std::memory_order_acquire);
+                 b != nullptr; b = b->next) {
+                for (std::size_t i = 0; i < counter_count; ++i) {
+                    result.values[i] += b->values[i].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+using active_policy = policy<CBT_INSTRUMENTATION != 0>;
+
+constexpr bool enabled = active_policy::enabled;
+
+constexpr void count(counter c, std::uint64_t n = 1) { active_policy::count(c, n); }
+
+constexpr void count_if(bool event, counter c) {
+    if constexpr (enabled) {
+        if (event) count(c);
+    } else {
+        (void)event;
+        (void)c;
+    }
+}
+
+/// Record ⌊log₂(result / operand)⌋ widening bits when an operation grows
+/// an interval beyond its widest operand
+template<typename T>
+constexpr void record_width_growth(T result_width, T operand_width) {
+    if constexpr (enabled) {
+        if (!CBT_CONSTANT_EVALUATED() && operand_width > 0 && result_width > 2 * operand_width &&
+            result_width < std::numeric_limits<T>::infinity()) {
+            count(counter::interval_width_growth_bits,
+                  static_cast<std::uint64_t>(std::ilogb(result_width / operand_width)));
+        }
+    } else {
+        (void)result_width;
+        (void)operand_width;
+    }
+}
+
+inline counters snapshot() { return active_policy::snapshot(); }
+
+} // namespace instrumentation
+} // namespace cbt
@@ -17,20 +17,255 @@
 
 #pragma once
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "instrumentation.hpp"
+#include "span.hpp"
 
 namespace cbt {
 
+namespace detail {
+
+/**
+ * Outward rounding without changing the FPU rounding mode
+ *
+ * Each operation is computed in round-to-nearest together with its exact
+ * error term (TwoSum, TwoProduct, remainder). The error's sign says which
+ * side the true result lies on, and only that bound is moved one step
+ * outward; exactly representable results stay tight. Steps use the
+ * predecessor/successor bound of Rump, Zimmermann, Boldo and Melquiond:
+ * x ± (φ|x| + η) with φ = u(1 + 2u), which needs no nextafter call and no
+ * branch; loops of these kernels vectorize (SSE4.1 or later for the 64-bit
+ * masks, e.g. -march=x86-64-v2). Where the error term is unreliable (overflowing splits, results
+ * near the underflow threshold) both sides are widened, so every kernel is
+ * sound for all finite inputs.
+ *
+ * @warning Requires IEEE round-to-nearest and no -ffast-math
+ */
+template<typename T>
+struct interval_rounding {
+    static constexpr T eps = std::numeric_limits<T>::epsilon();
+    static constexpr T phi = eps / 2 * (1 + eps);
+    // Rump et al. use η = denorm_min; the smallest normal is just as sound
+    // and keeps subnormal operands (and their microcode assists) out of the
+    // step computation
+    static constexpr T eta = std::numeric_limits<T>::min();
+    static constexpr T max = std::numeric_limits<T>::max();
+    static constexpr T lowest = std::numeric_limits<T>::lowest();
+
+    using bits = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+
+    static bits to_bits(T x) {
+        static_assert(sizeof(T) == sizeof(bits), "interval rounding supports float and double");
+        bits b;
+        std::memcpy(&b, &x, sizeof b);
+        return b;
+    }
+
+    static T from_bits(bits b) {
+        T x;
+        std::memcpy(&x, &b, sizeof x);
+        return x;
+    }
+
+    // The selects below act on bit patterns: GCC turns an FP select feeding
+    // an FP operation into a branch around that (trapping) operation, after
+    // which the loop no longer vectorizes
+
+    /// flag ? x : +0
+    static T keep_if(bool flag, T x) { return from_bits(to_bits(x) & (flag ? ~bits(0) : bits(0))); }
+
+    /// |x|, or 0 for ±∞ (keeps a zero coefficient from giving 0·∞)
+    static T finite_magnitude(T x) {
+        T magnitude = std::abs(x);
+        return keep_if(magnitude != std::numeric_limits<T>::infinity(), magnitude);
+    }
+
+    /**
+     * Move r one step down and/or up: ±∞ stays put, except that +∞ steps
+     * down to max() and -∞ up to lowest()
+     */
+    static void bound(T r, bool step_down, bool step_up, T& down, T& up) {
+        T magnitude = finite_magnitude(r);
+        down = std::min(r - (keep_if(step_down, phi) * magnitude + keep_if(step_down, eta)), max);
+        up = std::max(r + (keep_if(step_up, phi) * magnitude + keep_if(step_up, eta)), lowest);
+    }
+
+    /// Some value ≥ the successor of x
+    static T next_up(T x) {
+        T down, up;
+        bound(x, false, true, down, up);
+        return up;
+    }
+
+    /// Some value ≤ the predecessor of x
+    static T next_down(T x) {
+        T down, up;
+        bound(x, true, false, down, up);
+        return down;
+    }
+
+    /// a·b = p + e exactly (barring overflow or underflow)
+    static void two_product(T a, T b, T& p, T& e) {
+        p = a * b;
+#if defined(FP_FAST_FMA) && defined(FP_FAST_FMAF)
+        e = std::fma(a, b, -p);
+#else
+        // Dekker split: hi + lo halves of at most ⌈digits/2⌉ bits each
+        constexpr T split = T((1ull << ((std::numeric_limits<T>::digits + 1) / 2)) + 1);
+        T ca = split * a, cb = split * b;
+        T a_hi = ca - (ca - a), a_lo = a - a_hi;
+        T b_hi = cb - (cb - b), b_lo = b - b_hi;
+        e = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+    }
+
+    /// Below this magnitude TwoProduct's partial products may underflow
+    static constexpr T tiny = std::numeric_limits<T>::min() / (eps * eps);
+
+    /// Round r given sign(exact - r); a NaN sign (unknown) widens both sides
+    static void bound(T r, T sign, T& down, T& up) {
+        bound(r, !(sign >= 0), !(sign <= 0), down, up);
+    }
+
+    static void add(T a, T b, T& down, T& up) {
+        // TwoSum: s + e = a + b exactly
+        T s = a + b;
+        T bb = s - a;
+        T e = (a - (s - bb)) + (b - bb);
+        bound(s, e, down, up);
+    }
+
+    static void mul(T a, T b, T& down, T& up) {
+        T p, e;
+        two_product(a, b, p, e);
+        // A zero factor is exact, also against ∞ (0·∞ = 0 in interval arithmetic)
+        bool exact = (a == 0) | (b == 0);
+        bool unknown = !(std::abs(p) >= tiny);
+        bound(exact ? T(0) : p, (!exact) & (unknown | !(e >= 0)), (!exact) & (unknown | !(e <= 0)),
+              down, up);
+    }
+
+    static void div(T a, T b, T& down, T& up) {
+        // a - q·b is exact; its sign over b's gives the side of a/b
+        T q = a / b;
+        T p, e;
+        two_product(q, b, p, e);
+        T sign = ((a - p) - e) * b;
+        bool exact = a == 0;
+        bool unknown = !(std::abs(p) >= tiny);
+        bound(q, (!exact) & (unknown | !(sign >= 0)), (!exact) & (unknown | !(sign <= 0)), down, up);
+    }
+
+    static void sqrt(T a, T& down, T& up) {
+        T r = std::sqrt(a);
+        T p, e;
+        two_product(r, r, p, e);
+        T sign = (a - p) - e;
+        bool exact = a == 0;
+        bool unknown = !(p >= tiny);
+        bound(r, (!exact) & (unknown | !(sign >= 0)), (!exact) & (unknown | !(sign <= 0)), down, up);
+        down = std::max(down, T(0));
+    }
+
+    /// Bounds for a libm result accurate to within one ulp (two steps)
+    static void library(T r, T& down, T& up) {
+        down = next_down(next_down(r));
+        up = next_up(next_up(r));
+    }
+
+    static void interval_mul(T al, T au, T bl, T bu, T& down, T& up) {
+        // Branch-free: all four endpoint products, inner bounds discarded
+        T d0, u0, d1, u1, d2, u2, d3, u3;
+        mul(al, bl, d0, u0);
+        mul(al, bu, d1, u1);
+        mul(au, bl, d2, u2);
+        mul(au, bu, d3, u3);
+        down = std::min(std::min(d0, d1), std::min(d2, d3));
+        up = std::max(std::max(u0, u1), std::max(u2, u3));
+    }
+
+    static void interval_div(T al, T au, T bl, T bu, T& down, T& up) {
+        T d0, u0, d1, u1, d2, u2, d3, u3;
+        div(al, bl, d0, u0);
+        div(al, bu, d1, u1);
+        div(au, bl, d2, u2);
+        div(au, bu, d3, u3);
+        down = std::min(std::min(d0, d1), std::min(d2, d3));
+        up = std::max(std::max(u0, u1), std::max(u2, u3));
+    }
+};
+
+} // namespace detail
+
 template<typename T>
 class interval {
     static_assert(std::is_floating_point_v<T>, "interval requires floating-point type");
     
 private:
+    using rounding = detail::interval_rounding<T>;
+    
     T lower_;
     T upper_;
     
+    /// Bounds already ordered, skips the swap check
+    static interval make(T lower, T upper) {
+        interval result;
+        result.lower_ = lower;
+        result.upper_ = upper;
+        return result;
+    }
+    
+    /// 2π-periodic f with maximum at peak and minimum at trough
+    template<typename F>
+    static interval periodic(const interval& x, F f, long double peak, long double trough) {
+        // The phase is located in at least double precision (float's own
+        // 2π and quotient are off by ~1e-2 turns near 1e5), with the range
+        // and slack scaled to the reduction type's digits: 2^20 for double
+        using W = std::conditional_t<(std::numeric_limits<T>::digits < std::numeric_limits<double>::digits),
+                                     double, long double>;
+        constexpr int spare = std::numeric_limits<W>::digits - 33;
+        constexpr W two_pi = W(6.28318530717958647692528676655900577L);
+        // Beyond 2^spare the reduction below loses the phase: give up soundly
+        const W reducible = std::ldexp(W(1), spare);
+        if (x.is_empty()) return empty();
+        const W lo = x.lower_, hi = x.upper_;
+        if (!(hi - lo < two_pi) || !(std::abs(lo) < reducible) || !(std::abs(hi) < reducible)) {
+            return make(-1, 1);
+        }
+        // Contains phase + 2πk for some k? The slack errs towards yes
+        auto hits = [&](long double phase) {
+            const W slack = std::ldexp(W(1), -spare);
+            W k = std::ceil((lo - W(phase)) / two_pi - slack);
+            return k <= (hi - W(phase)) / two_pi + slack;
+        };
+        T d0, u0, d1, u1;
+        rounding::library(f(x.lower_), d0, u0);
+        rounding::library(f(x.upper_), d1, u1);
+        T lower = hits(trough) ? T(-1) : std::max(T(-1), std::min(d0, d1));
+        T upper = hits(peak) ? T(1) : std::min(T(1), std::max(u0, u1));
+        return make(lower, upper);
+    }
+    
+    /// Count an arithmetic result and how far it widened past its operands
+    static interval observed(const interval& result, const interval& a, const interval& b) {
+        instrumentation::count(instrumentation::counter::interval_ops);
+        if constexpr (instrumentation::enabled) {
+            instrumentation::record_width_growth(result.width(), std::max(a.width(), b.width()));
+        }
+        return result;
+    }
+    
 public:
+    using value_type = T;
+    
     // Constructors
     interval() : lower_(0), upper_(0) {}
     interval(T value) : lower_(value), upper_(value) {}
@@ -40,7 +275,10 @@ public:
     
     // Factory methods
     static interval from_radius(T center, T radius) {
-        return interval(center - radius, center + radius);
+        T lower, upper, ignore;
+        rounding::add(center, -radius, lower, ignore);
+        rounding::add(center, radius, ignore, upper);
+        return interval(lower, upper);
     }
     
     static interval entire() {
@@ -63,32 +301,37 @@ public:
     bool is_empty() const { return std::isnan(lower_); }
     bool is_singleton() const { return lower_ == upper_; }
     
-    // Arithmetic with guaranteed containment
+    // Arithmetic with guaranteed containment (outward rounded)
     interval operator+(const interval& other) const {
-        return interval(lower_ + other.lower_, upper_ + other.upper_);
+        T lower, upper, ignore;
+        rounding::add(lower_, other.lower_, lower, ignore);
+        rounding::add(upper_, other.upper_, ignore, upper);
+        return observed(make(lower, upper), *this, other);
     }
     
     interval operator-(const interval& other) const {
-        return interval(lower_ - other.upper_, upper_ - other.lower_);
+        T lower, upper, ignore;
+        rounding::add(lower_, -other.upper_, lower, ignore);
+        rounding::add(upper_, -other.lower_, ignore, upper);
+        return observed(make(lower, upper), *this, other);
     }
     
     interval operator*(const interval& other) const {
-        T products[4] = {
-            lower_ * other.lower_,
-            lower_ * other.upper_,
-            upper_ * other.lower_,
-            upper_ * other.upper_
-        };
-        return interval(*std::min_element(products, products + 4),
-                       *std::max_element(products, products + 4));
+        T lower, upper;
+        rounding::interval_mul(lower_, upper_, other.lower_, other.upper_, lower, upper);
+        return observed(make(lower, upper), *this, other);
     }
     
     interval operator/(const interval& other) const {
         if (other.contains(0)) {
             // Division by interval containing zero
+            instrumentation::count(instrumentation::counter::interval_ops);
+            instrumentation::count(instrumentation::counter::interval_division_entire);
             return entire();
         }
-        return *this * interval(1.0 / other.upper_, 1.0 / other.lower_);
+        T lower, upper;
+        rounding::interval_div(lower_, upper_, other.lower_, other.upper_, lower, upper);
+        return observed(make(lower, upper), *this, other);
     }
     
     interval operator-() const {
@@ -119,29 +362,37 @@ public:
     // Mathematical functions with interval extensions
     friend interval sqrt(const interval& x) {
         if (x.upper_ < 0) return interval::empty();
-        return interval(x.lower_ <= 0 ? 0 : std::sqrt(x.lower_),
-                       std::sqrt(x.upper_));
+        T lower = 0, upper, ignore;
+        if (x.lower_ > 0) rounding::sqrt(x.lower_, lower, ignore);
+        rounding::sqrt(x.upper_, ignore, upper);
+        return make(lower, upper);
     }
     
+    /// @brief Monotone: libm at the endpoints, widened by its error bound
     friend interval exp(const interval& x) {
-        return interval(std::exp(x.lower_), std::exp(x.upper_));
+        T lower, upper, ignore;
+        rounding::library(std::exp(x.lower_), lower, ignore);
+        rounding::library(std::exp(x.upper_), ignore, upper);
+        return make(std::max(T(0), lower), upper);
     }
     
     friend interval log(const interval& x) {
         if (x.upper_ <= 0) return interval::empty();
-        return interval(x.lower_ <= 0 ? -std::numeric_limits<T>::infinity() 
-                                      : std::log(x.lower_),
-                       std::log(x.upper_));
+        T lower = -std::numeric_limits<T>::infinity(), upper, ignore;
+        if (x.lower_ > 0) rounding::library(std::log(x.lower_), lower, ignore);
+        rounding::library(std::log(x.upper_), ignore, upper);
+        return make(lower, upper);
     }
     
+    /// @brief Tight: endpoint values, plus ±1 where a peak or trough is inside
     friend interval sin(const interval& x) {
-        // Simplified - proper implementation needs period handling
-        return interval(-1, 1);
+        constexpr long double half_pi = 1.57079632679489661923132169163975144L;
+        return periodic(x, [](T v) { return std::sin(v); }, half_pi, -half_pi);
     }
     
     friend interval cos(const interval& x) {
-        // Simplified - proper implementation needs period handling
-        return interval(-1, 1);
+        constexpr long double pi = 3.14159265358979323846264338327950288L;
+        return periodic(x, [](T v) { return std::cos(v); }, 0.0L, pi);
     }
     
     // Comparison
@@ -0,0 +1,434 @@
+/**
+ * Interval Branch-and-Bound - Validated Global Minimization
+ *
+ * Transform: min f over a box → bisection tree of boxes, each bounded by
+ * the interval extension f([x])
+ *
+ * A box whose enclosure lies above the best upper bound found so far (the
+ * incumbent) cannot hold the global minimum and is discarded; the rest are
+ * bisected along their widest side until they are small enough. Because
+ * interval<T> rounds outward, the reported bracket [lower_bound, upper_bound]
+ * contains the true minimum.
+ *
+ * Trade-off:
+ *   Gain: Worker threads each own a best-first queue of boxes that idle
+ *         workers steal from, draw box storage from their own pool, and
+ *         share only an atomic incumbent and a counter of live boxes
+ *   Loss: Work grows exponentially with dimension unless the enclosures are
+ *         tight; an optional gradient enclosure prunes far more boxes
+ *
+ * Applications:
+ *   - Rigorous global optimization
+ *   - Verified bounds for parameter estimation
+ *   - Certificates that a function stays above a threshold on a region
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "interval.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+/// @brief Counters reported while and after a branch-and-bound run
+struct bnb_stats {
+    std::size_t boxes = 0;    ///< Boxes taken off a queue and examined
+    std::size_t pruned = 0;   ///< Boxes discarded by the incumbent or gradient test
+    double seconds = 0;       ///< Wall time since the run started
+
+    double boxes_per_second() const { return seconds > 0 ? boxes / seconds : 0.0; }
+    double pruning_ratio() const { return boxes ? double(pruned) / boxes : 0.0; }
+};
+
+template<typename T>
+struct bnb_options {
+    T box_tolerance = T(1e-6);         ///< Accept boxes whose widest side is below this
+    T value_tolerance = T(1e-6);       ///< ... or whose lower bound is this close to the incumbent
+    std::size_t max_boxes = 50000000;  ///< Stop after examining this many boxes
+    unsigned threads = 0;              ///< Worker count; 0 uses hardware concurrency
+    std::size_t report_every = 1 << 16;  ///< Boxes between progress callbacks
+    std::function<void(const bnb_stats&)> progress;  ///< Called from the calling thread
+};
+
+template<typename T>
+struct bnb_result {
+    T lower_bound;              ///< The global minimum is ≥ this
+    T upper_bound;              ///< ... and ≤ this; f(minimizer) ≤ upper_bound
+    std::vector<T> minimizer;   ///< Point whose value gave upper_bound
+    bool complete;              ///< false if max_boxes stopped the search
+    bnb_stats stats;
+};
+
+namespace detail {
+
+/// Fixed-size box storage recycled through a free list
+template<typename T>
+class bnb_box_pool {
+    static constexpr std::size_t boxes_per_chunk = 256;
+
+    std::size_t dimension_;
+    std::vector<std::unique_ptr<interval<T>[]>> chunks_;
+    std::vector<interval<T>*> free_;
+
+public:
+    explicit bnb_box_pool(std::size_t dimension) : dimension_(dimension) {}
+
+    interval<T>* allocate() {
+        if (free_.empty()) {
+            chunks_.emplace_back(new interval<T>[dimension_ * boxes_per_chunk]);
+            for (std::size_t i = boxes_per_chunk; i-- > 0;) {
+                free_.push_back(chunks_.back().get() + i * dimension_);
+            }
+        }
+        interval<T>* box = free_.back();
+        free_.pop_back();
+        return box;
+    }
+
+    void release(interval<T>* box) { free_.push_back(box); }
+};
+
+template<typename T>
+struct bnb_item {
+    interval<T>* box;
+    T lower;   // lower bound of f over the box
+
+    /// Heap order: smallest lower bound on top
+    bool operator<(const bnb_item& other) const { return lower > other.lower; }
+};
+
+/// One thread's queue, pool and counters; boxes stolen from here are later
+/// released into the thief's pool, so pools live until the run ends
+template<typename T>
+struct alignas(64) bnb_worker {
+    std::mutex lock;
+    std::vector<bnb_item<T>> queue;   // binary heap
+    bnb_box_pool<T> pool;
+    std::atomic<std::size_t> boxes{0};
+    std::atomic<std::size_t> pruned{0};
+    T accepted_lower = std::numeric_limits<T>::infinity();
+
+    explicit bnb_worker(std::size_t dimension) : pool(dimension) {}
+};
+
+/// No derivative pruning
+struct bnb_no_gradient {};
+
+} // namespace detail
+
+/**
+ * @brief Parallel interval branch-and-bound minimizer over a box
+ * @details The objective is called as f(span<const interval<T>>) and must
+ * return an enclosure interval<T> of f over the box; writing it as a
+ * generic lambda over `const auto&` is enough. It is invoked concurrently
+ * from several threads.
+ */
+template<typename T>
+class interval_bnb {
+    static_assert(std::is_floating_point_v<T>, "interval_bnb requires floating-point type");
+
+public:
+    using value_type = T;
+    using box_type = std::vector<interval<T>>;
+
+private:
+    box_type domain_;
+    bnb_options<T> options_;
+
+    using worker = detail::bnb_worker<T>;
+    using item = detail::bnb_item<T>;
+
+    /// Shared by all workers of one run
+    struct run_state {
+        std::vector<std::unique_ptr<worker>> workers;
+        std::atomic<T> incumbent{std::numeric_limits<T>::infinity()};
+        std::atomic<std::size_t> live{0};       // boxes queued or being examined
+        std::atomic<std::size_t> examined{0};
+        std::atomic<bool> stopped{false};       // max_boxes reached
+        std::atomic<bool> aborted{false};       // a worker threw, or the run is over
+        std::mutex minimizer_lock;
+        std::vector<T> minimizer;
+        std::exception_ptr error;               // first exception, under minimizer_lock
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        bnb_stats stats() const {
+            bnb_stats s;
+            for (const auto& w : workers) {
+                s.boxes += w->boxes.load(std::memory_order_relaxed);
+                s.pruned += w->pruned.load(std::memory_order_relaxed);
+            }
+            s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return s;
+        }
+    };
+
+    static void pop(worker& from, item& out) {
+        std::pop_heap(from.queue.begin(), from.queue.end());
+        out = from.queue.back();
+        from.queue.pop_back();
+    }
+
+    bool take(run_state& state, std::size_t self, item& out) const {
+        worker& own = *state.workers[self];
+        {
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.queue.empty()) {
+                pop(own, out);
+                return true;
+            }
+        }
+        // Idle: steal another worker's most promising box
+        const std::size_t n = state.workers.size();
+        for (std::size_t k = 1; k < n; ++k) {
+            worker& victim = *state.workers[(self + k) % n];
+            std::unique_lock<std::mutex> guard(victim.lock, std::try_to_lock);
+            if (guard.owns_lock() && !victim.queue.empty()) {
+                pop(victim, out);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Bound f over box; false (box released) if it cannot beat the incumbent
+    template<typename F>
+    bool bound(run_state& state, worker& self, F& f, interval<T>* box, T& lower) const {
+        lower = std::max(lower, interval<T>(f(span<const interval<T>>(box, domain_.size()))).lower());
+        if (lower > state.incumbent.load(std::memory_order_relaxed)) {
+            self.pruned.fetch_add(1, std::memory_order_relaxed);
+            self.pool.release(box);
+            return false;
+        }
+        return true;
+    }
+
+    /// Lower the incumbent to value; the winner records its point
+    static void offer(run_state& state, T value, const interval<T>* point, std::size_t n) {
+        T current = state.incumbent.load(std::memory_order_relaxed);
+        while (value < current) {
+            if (state.incumbent.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> guard(state.minimizer_lock);
+                if (state.incumbent.load(std::memory_order_relaxed) == value) {
+                    for (std::size_t i = 0; i < n; ++i) state.minimizer[i] = point[i].lower();
+                }
+                return;
+            }
+        }
+    }
+
+    template<typename F, typename G>
+    void examine(run_state& state, worker& self, item it, F& f, G& gradient,
+                 std::vector<interval<T>>& scratch) const {
+        const std::size_t n = domain_.size();
+        interval<T>* box = it.box;
+        auto prune = [&] {
+            self.pruned.fetch_add(1, std::memory_order_relaxed);
+            self.pool.release(box);
+        };
+
+        if (state.stopped.load(std::memory_order_relaxed) ||
+            state.examined.fetch_add(1, std::memory_order_relaxed) >= options_.max_boxes) {
+            // Out of budget: the box stays unresolved, its bound still counts
+            state.stopped.store(true, std::memory_order_relaxed);
+            self.accepted_lower = std::min(self.accepted_lower, it.lower);
+            self.pool.release(box);
+            return;
+        }
+        self.boxes.fetch_add(1, std::memory_order_relaxed);
+        // The incumbent may have dropped since the box was queued
+        const T lower = it.lower;
+        if (lower > state.incumbent.load(std::memory_order_relaxed)) return prune();
+
+        span<const interval<T>> view(box, n);
+
+        if constexpr (!std::is_same_v<G, detail::bnb_no_gradient>) {
+            // Monotonicity: f strictly monotone in xᵢ has its minimum on a
+            // face - none inside the domain, or only on the domain's face
+            gradient(view, span<interval<T>>(scratch));
+            for (std::size_t i = 0; i < n; ++i) {
+                if (scratch[i].lower() > 0) {
+                    if (box[i].lower() > domain_[i].lower()) return prune();
+                    box[i] = interval<T>(box[i].lower());
+                } else if (scratch[i].upper() < 0) {
+                    if (box[i].upper() < domain_[i].upper()) return prune();
+                    box[i] = interval<T>(box[i].upper());
+                }
+            }
+        }
+
+        // Rigorous upper bound on the minimum from the midpoint
+        for (std::size_t i = 0; i < n; ++i) scratch[i] = interval<T>(box[i].mid());
+        T at_mid = interval<T>(f(span<const interval<T>>(scratch.data(), n))).upper();
+        offer(state, at_mid, scratch.data(), n);
+
+        std::size_t widest = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            if (box[i].width() > box[widest].width()) widest = i;
+        }
+        T incumbent = state.incumbent.load(std::memory_order_relaxed);
+        if (!(box[widest].width() > options_.box_tolerance) ||
+            !(incumbent - lower > options_.value_tolerance)) {
+            self.accepted_lower = std::min(self.accepted_lower, lower);
+            self.pool.release(box);
+            return;
+        }
+
+        // Bisect; the parent's storage becomes the lower child. Children are
+        // bounded now so the queue can order them and drop hopeless ones
+        interval<T>* upper_child = self.pool.allocate();
+        std::copy(box, box + n, upper_child);
+        T split = box[widest].mid();
+        box[widest] = interval<T>(box[widest].lower(), split);
+        upper_child[widest] = interval<T>(split, upper_child[widest].upper());
+        item children[2] = {{box, lower}, {upper_child, lower}};
+        for (item& child : children) {
+            if (!bound(state, self, f, child.box, child.lower)) continue;
+            state.live.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> guard(self.lock);
+            self.queue.push_back(child);
+            std::push_heap(self.queue.begin(), self.queue.end());
+        }
+    }
+
+    template<typename F, typename G>
+    void work(run_state& state, std::size_t self_index, F& f, G& gradient) const {
+        worker& self = *state.workers[self_index];
+        std::vector<interval<T>> scratch(domain_.size());
+        std::size_t next_report = options_.report_every;
+        item it;
+        while (state.live.load(std::memory_order_acquire) != 0 && !state.aborted.load(std::memory_order_relaxed)) {
+            if (!take(state, self_index, it)) {
+                std::this_thread::yield();
+                continue;
+            }
+            examine(state, self, it, f, gradient, scratch);
+            state.live.fetch_sub(1, std::memory_order_acq_rel);
+            if (self_index == 0 && options_.progress &&
+                self.boxes.load(std::memory_order_relaxed) >= next_report) {
+                options_.progress(state.stats());
+                next_report += options_.report_every;
+            }
+        }
+    }
+
+    /// work() with any exception from f, gradient or progress kept for run()
+    /// to rethrow; the others stop, as the thrower's box never completes
+    template<typename F, typename G>
+    void guarded_work(run_state& state, std::size_t self_index, F& f, G& gradient) const noexcept {
+        try {
+            work(state, self_index, f, gradient);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(state.minimizer_lock);
+            if (!state.error) state.error = std::current_exception();
+            state.aborted.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /// Stops and joins the workers however run() leaves the pool's scope
+    struct joiner {
+        run_state& state;
+        std::vector<std::thread>& pool;
+        ~joiner() {
+            state.aborted.store(true, std::memory_order_relaxed);
+            for (auto& thread : pool) {
+                if (thread.joinable()) thread.join();
+            }
+        }
+    };
+
+    template<typename F, typename G>
+    bnb_result<T> run(F& f, G& gradient) const {
+        const std::size_t n = domain_.size();
+        unsigned threads = options_.threads ? options_.threads
+                                            : std::max(1u, std::thread::hardware_concurrency());
+        run_state state;
+        state.minimizer.resize(n);
+        for (unsigned t = 0; t < threads; ++t) state.workers.push_back(std::make_unique<worker>(n));
+
+        worker& first = *state.workers[0];
+        interval<T>* root = first.pool.allocate();
+        std::copy(domain_.begin(), domain_.end(), root);
+        T root_lower = -std::numeric_limits<T>::infinity();
+        bound(state, first, f, root, root_lower);
+        first.queue.push_back({root, root_lower});
+        state.live.store(1, std::memory_order_release);
+
+        {
+            std::vector<std::thread> pool;
+            joiner join_all{state, pool};
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; ++t) {
+                pool.emplace_back([&, t] { guarded_work(state, t, f, gradient); });
+            }
+            guarded_work(state, 0, f, gradient);
+        }
+        if (state.error) std::rethrow_exception(state.error);
+
+        bnb_result<T> result;
+        result.upper_bound = state.incumbent.load();
+        result.lower_bound = result.upper_bound;
+        for (const auto& w : state.workers) {
+            result.lower_bound = std::min(result.lower_bound, w->accepted_lower);
+        }
+        result.minimizer = std::move(state.minimizer);
+        result.complete = !state.stopped.load();
+        result.stats = state.stats();
+        if (options_.progress) options_.progress(result.stats);
+        return result;
+    }
+
+public:
+    /**
+     * @param domain Search box, one bounded non-empty interval per variable
+     * @throws std::invalid_argument for an empty domain or unbounded sides
+     */
+    explicit interval_bnb(box_type domain, bnb_options<T> options = bnb_options<T>())
+        : domain_(std::move(domain)), options_(std::move(options)) {
+        if (domain_.empty()) {
+            throw std::invalid_argument("branch-and-bound domain needs at least one variable");
+        }
+        for (const auto& side : domain_) {
+            if (side.is_empty() || !std::isfinite(side.lower()) || !std::isfinite(side.upper())) {
+                throw std::invalid_argument("branch-and-bound domain must be bounded");
+            }
+        }
+    }
+
+    const box_type& domain() const { return domain_; }
+    const bnb_options<T>& options() const { return options_; }
+
+    /// @brief Bracket the global minimum of f over the domain
+    /// @details An exception from f (or progress) on any thread stops every
+    ///          worker and is rethrown here once they have joined
+    template<typename F>
+    bnb_result<T> minimize(F&& f) const {
+        detail::bnb_no_gradient none;
+        return run(f, none);
+    }
+
+    /**
+     * @brief As minimize(f), discarding boxes on which f is monotone
+     * @param gradient Called as gradient(box, out) with box a
+     * span<const interval<T>> and out a span<interval<T>>; must store an
+     * enclosure of ∂f/∂xᵢ over the box in out[i]
+     */
+    template<typename F, typename G>
+    bnb_result<T> minimize(F&& f, G&& gradient) const {
+        return run(f, gradient);
+    }
+};
+
+} // namespace cbt
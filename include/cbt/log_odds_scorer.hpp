@@ -0,0 +1,304 @@
+/**
+ * Log-Odds Scorer - Linear Classifiers over Sparse Features in Log-Odds Space
+ *
+ * Transform: P(class | features) → log-odds = bias + Σ w[f] over active f
+ *
+ * Naive Bayes (w[f] = log P(f|+)/P(f|-)) and logistic regression share this
+ * form: scoring a document is a sum of table lookups, and to_probability()
+ * is applied once per document instead of once per feature.
+ *
+ * Trade-off:
+ *   Gain: Scoring is gather + add, prefetched ahead of use and accumulated
+ *         in independent lanes; weights are atomics updated lock-free with
+ *         CAS, so a trainer and many scoring threads share one table
+ *   Loss: Concurrent readers see each weight atomically but not a
+ *         consistent snapshot of the whole table; a hashed table has fixed
+ *         capacity so inserts never move slots under a reader
+ *
+ * Applications:
+ *   - Spam filtering and text classification
+ *   - Click-through and risk scoring over hashed features
+ *   - Online learning while serving
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "logarithmic.hpp"
+#include "odds_ratio.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+namespace detail {
+
+/// Lookups issued ahead of the one being accumulated
+constexpr std::size_t scorer_prefetch_distance = 16;
+
+inline void prefetch_read(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 1);
+#else
+    (void)address;
+#endif
+}
+
+/// value += delta with a CAS loop (std::atomic<T>::fetch_add for floating
+/// point is C++20)
+template<typename T>
+void atomic_add(std::atomic<T>& value, T delta) {
+    T expected = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(expected, expected + delta,
+                                        std::memory_order_relaxed,
+                                        std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Directly indexed weights for feature ids in [0, size)
+ * @details Unknown ids score 0; one atomic per feature
+ */
+template<typename T>
+class dense_weight_table {
+    static_assert(std::is_floating_point_v<T>, "weight table requires floating-point type");
+
+private:
+    std::vector<std::atomic<T>> weights_;
+
+public:
+    using value_type = T;
+
+    explicit dense_weight_table(std::size_t size) : weights_(size) {
+        for (auto& w : weights_) w.store(T(0), std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return weights_.size(); }
+
+    T weight(std::uint64_t feature) const {
+        return feature < weights_.size() ? weights_[feature].load(std::memory_order_relaxed) : T(0);
+    }
+
+    void prefetch(std::uint64_t feature) const {
+        if (feature < weights_.size()) detail::prefetch_read(&weights_[feature]);
+    }
+
+    /// @throws std::invalid_argument if feature ≥ capacity()
+    void add(std::uint64_t feature, T delta) {
+        if (feature >= weights_.size()) {
+            throw std::invalid_argument("feature id exceeds dense table size");
+        }
+        detail::atomic_add(weights_[feature], delta);
+    }
+};
+
+/**
+ * @brief Open-addressing hash table of weights for arbitrary 64-bit ids
+ * @details Power-of-two capacity, Fibonacci hashing and linear probing.
+ * Each 16-byte slot holds its key next to its weight, so a lookup usually
+ * touches one cache line. Keys are claimed with a CAS and never removed,
+ * so probes stay valid while other threads insert.
+ */
+template<typename T>
+class hashed_weight_table {
+    static_assert(std::is_floating_point_v<T>, "weight table requires floating-point type");
+
+public:
+    using value_type = T;
+
+    /// Reserved: marks an empty slot, cannot be used as a feature id
+    static constexpr std::uint64_t empty_key = ~std::uint64_t(0);
+
+private:
+    struct slot {
+        std::atomic<std::uint64_t> key;
+        std::atomic<T> weight;
+    };
+
+    std::vector<slot> slots_;
+    std::size_t mask_;
+    int shift_;
+
+    std::size_t home(std::uint64_t feature) const {
+        return static_cast<std::size_t>((feature * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+public:
+    /// @brief Room for at least min_capacity features at ≤ 50% load
+    explicit hashed_weight_table(std::size_t min_capacity) {
+        std::size_t capacity = 2;
+        int bits = 1;
+        while (capacity < 2 * min_capacity) {
+            capacity *= 2;
+            ++bits;
+        }
+        slots_ = std::vector<slot>(capacity);
+        mask_ = capacity - 1;
+        shift_ = 64 - bits;
+        for (auto& s : slots_) {
+            s.key.store(empty_key, std::memory_order_relaxed);
+            s.weight.store(T(0), std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t capacity() const { return slots_.size(); }
+
+    T weight(std::uint64_t feature) const {
+        for (std::size_t i = home(feature), probes = 0; probes < slots_.size();
+             i = (i + 1) & mask_, ++probes) {
+            std::uint64_t key = slots_[i].key.load(std::memory_order_acquire);
+            if (key == feature) return slots_[i].weight.load(std::memory_order_relaxed);
+            if (key == empty_key) return T(0);
+        }
+        return T(0);
+    }
+
+    void prefetch(std::uint64_t feature) const {
+        detail::prefetch_read(&slots_[home(feature)]);
+    }
+
+    /**
+     * @brief Lock-free w[feature] += delta, inserting feature if absent
+     * @throws std::invalid_argument for empty_key
+     * @throws std::runtime_error if the table is full
+     */
+    void add(std::uint64_t feature, T delta) {
+        if (feature == empty_key) {
+            throw std::invalid_argument("feature id is reserved for empty slots");
+        }
+        for (std::size_t i = home(feature), probes = 0; probes < slots_.size();
+             i = (i + 1) & mask_, ++probes) {
+            std::uint64_t key = slots_[i].key.load(std::memory_order_acquire);
+            if (key == empty_key) {
+                // Claim the slot; on failure key holds the winner's id
+                if (slots_[i].key.compare_exchange_strong(key, feature, std::memory_order_acq_rel)) {
+                    key = feature;
+                }
+            }
+            if (key == feature) {
+                detail::atomic_add(slots_[i].weight, delta);
+                return;
+            }
+        }
+        throw std::runtime_error("hashed weight table is full");
+    }
+};
+
+/**
+ * @brief Sparse-feature linear scorer accumulating in log-odds
+ * @tparam T Floating-point weight type
+ * @tparam Table dense_weight_table<T> or hashed_weight_table<T>
+ */
+template<typename T, typename Table = dense_weight_table<T>>
+class log_odds_scorer {
+    static_assert(std::is_floating_point_v<T>, "log_odds_scorer requires floating-point type");
+
+private:
+    Table table_;
+    std::atomic<T> bias_;
+
+public:
+    using value_type = T;
+    using table_type = Table;
+
+    /// @param capacity Dense: feature ids in [0, capacity); hashed: features held
+    explicit log_odds_scorer(std::size_t capacity, log_odds<T> prior = log_odds<T>())
+        : table_(capacity), bias_(prior.value()) {}
+
+    // Getters
+    const Table& table() const { return table_; }
+    T weight(std::uint64_t feature) const { return table_.weight(feature); }
+    log_odds<T> bias() const { return log_odds<T>(bias_.load(std::memory_order_relaxed)); }
+
+    // Scoring
+    /// @brief bias + Σ w[f] for one document's active features
+    log_odds<T> score(span<const std::uint64_t> features) const {
+        const std::uint64_t* f = features.data();
+        const std::size_t n = features.size();
+        const std::size_t ahead = std::min(n, detail::scorer_prefetch_distance);
+        for (std::size_t i = 0; i < ahead; ++i) table_.prefetch(f[i]);
+
+        T lanes[detail::lg_lanes] = {};
+        std::size_t i = 0;
+        for (; i + detail::lg_lanes <= n; i += detail::lg_lanes) {
+            for (std::size_t l = 0; l < detail::lg_lanes; ++l) {
+                std::size_t next = i + l + detail::scorer_prefetch_distance;
+                if (next < n) table_.prefetch(f[next]);
+                lanes[l] += table_.weight(f[i + l]);
+            }
+        }
+        for (; i < n; ++i) lanes[0] += table_.weight(f[i]);
+        T total = bias_.load(std::memory_order_relaxed);
+        for (std::size_t l = 0; l < detail::lg_lanes; ++l) total += lanes[l];
+        return log_odds<T>(total);
+    }
+
+    log_odds<T> score(const std::vector<std::uint64_t>& features) const {
+        return score(span<const std::uint64_t>(features));
+    }
+
+    /**
+     * @brief Score documents stored CSR-style
+     * @param features Concatenated feature ids of all documents
+     * @param offsets Document d owns features [offsets[d], offsets[d+1])
+     */
+    std::vector<log_odds<T>> score_batch(span<const std::uint64_t> features,
+                                         span<const std::size_t> offsets) const {
+        if (offsets.empty() || offsets[offsets.size() - 1] > features.size()) {
+            throw std::invalid_argument("offsets must end within the feature array");
+        }
+        std::vector<log_odds<T>> scores(offsets.size() - 1);
+        for (std::size_t d = 0; d + 1 < offsets.size(); ++d) {
+            if (offsets[d] > offsets[d + 1]) {
+                throw std::invalid_argument("offsets must be non-decreasing");
+            }
+            scores[d] = score(features.subspan(offsets[d], offsets[d + 1] - offsets[d]));
+        }
+        return scores;
+    }
+
+    std::vector<log_odds<T>> score_batch(const std::vector<std::uint64_t>& features,
+                                         const std::vector<std::size_t>& offsets) const {
+        return score_batch(span<const std::uint64_t>(features), span<const std::size_t>(offsets));
+    }
+
+    /// @brief P(positive | features) via the stable sigmoid
+    T probability(span<const std::uint64_t> features) const {
+        return score(features).to_probability();
+    }
+
+    // Updates (lock-free, safe while other threads score)
+    void add_weight(std::uint64_t feature, T delta) { table_.add(feature, delta); }
+
+    void add_bias(T delta) { detail::atomic_add(bias_, delta); }
+
+    /**
+     * @brief One online logistic-regression step
+     * @details Gradient of the log loss: w[f] += rate·(label - p) for each
+     * active f, and likewise for the bias
+     * @return The prediction made before the update
+     */
+    log_odds<T> train(span<const std::uint64_t> features, bool label, T rate) {
+        log_odds<T> prediction = score(features);
+        T step = rate * ((label ? T(1) : T(0)) - prediction.to_probability());
+        add_bias(step);
+        for (std::uint64_t f : features) table_.add(f, step);
+        return prediction;
+    }
+
+    log_odds<T> train(const std::vector<std::uint64_t>& features, bool label, T rate) {
+        return train(span<const std::uint64_t>(features), label, rate);
+    }
+};
+
+/// Scorer over arbitrary 64-bit (e.g. hashed token) feature ids
+template<typename T>
+using hashed_log_odds_scorer = log_odds_scorer<T, hashed_weight_table<T>>;
+
+} // namespace cbt
@@ -19,9 +19,16 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <iostream>
+#include <utility>
+#include <vector>
+#include "cmath.hpp"
+#include "instrumentation.hpp"
+#include "span.hpp"
 
 /// @namespace cbt
 /// @brief Core namespace for Computational Basis Transforms
@@ -37,6 +44,8 @@ namespace cbt {
  * - Multiplication becomes addition: lg(a) * lg(b) = lg(a×b)
  * - Division becomes subtraction: lg(a) / lg(b) = lg(a÷b)  
  * - Exponentiation becomes multiplication: lg(a)^n = lg(a^n)
+ * - Addition becomes log-sum-exp: lg(a) + lg(b) = lg(a+b), computed as
+ *   max + log1p(exp(-|log a - log b|)) without leaving the log domain
  * 
  * <b>Trade-offs:</b>
  * - Gains:
@@ -45,7 +54,8 @@ namespace cbt {
  *   - Accumulated rounding error reduction
  *   - Natural inter-CBT mappings
  * - Losses:
- *   - No direct addition operation
+ *   - Addition costs an exp and a log1p instead of one add
+ *   - No subtraction (differences may leave the positive reals)
  *   - Domain restricted to positive reals
  * 
  * <b>Example Usage:</b>
@@ -70,7 +80,10 @@ public:
     /// @param value The positive real value to transform
     /// @note Values ≤ 0 map to -∞ in log domain
     explicit constexpr lg(T value) 
-        : log_value_(value > 0 ? std::log(value) : -std::numeric_limits<T>::infinity()) {}
+        : log_value_(value > 0 ? cmath::log(value) : -std::numeric_limits<T>::infinity()) {
+        instrumentation::count(instrumentation::counter::lg_conversions);
+        instrumentation::count_if(!(value > 0), instrumentation::counter::lg_zero);
+    }
     
     /// @brief Factory method to create directly from log value
     /// @param log_val The logarithmic value
@@ -86,7 +99,12 @@ public:
     /// @return The exponential of the internal log value
     /// @warning May overflow for large log values
     constexpr T value() const {
-        return std::exp(log_value_);
+        T result = cmath::exp(log_value_);
+        instrumentation::count(instrumentation::counter::lg_conversions);
+        instrumentation::count_if((result == 0 || result == std::numeric_limits<T>::infinity()) &&
+                                  log_value_ - log_value_ == 0,
+                                  instrumentation::counter::lg_value_saturations);
+        return result;
     }
     
     /// @brief Get the internal log representation
@@ -98,14 +116,17 @@ public:
     
     // Arithmetic (multiplication in original domain)
     constexpr lg operator*(const lg& other) const {
+        instrumentation::count(instrumentation::counter::lg_ops);
         return from_log(log_value_ + other.log_value_);
     }
     
     constexpr lg operator/(const lg& other) const {
+        instrumentation::count(instrumentation::counter::lg_ops);
         return from_log(log_value_ - other.log_value_);
     }
     
     constexpr lg pow(T exponent) const {
+        instrumentation::count(instrumentation::counter::lg_ops);
         return from_log(log_value_ * exponent);
     }
     
@@ -113,6 +134,20 @@ public:
         return from_log(log_value_ / 2);
     }
     
+    /// @brief Addition in the original domain via log-sum-exp
+    /// @details log(a + b) = max + log1p(exp(min - max)); the shift by the
+    /// maximum keeps exp() in (0, 1] so neither operand can underflow the sum
+    constexpr lg operator+(const lg& other) const {
+        instrumentation::count(instrumentation::counter::lg_ops);
+        if (log_value_ == other.log_value_) {
+            // Also covers ±∞ + ±∞, where the difference below would be NaN
+            return from_log(log_value_ + T(0.69314718055994530941723212145817656807L));
+        }
+        T hi = std::max(log_value_, other.log_value_);
+        T lo = std::min(log_value_, other.log_value_);
+        return from_log(hi + cmath::log1p(cmath::exp(lo - hi)));
+    }
+    
     // Comparison
     constexpr bool operator==(const lg& other) const {
         return log_value_ == other.log_value_;
@@ -140,6 +175,155 @@ public:
     }
 };
 
+namespace detail {
+
+/// Independent accumulators per reduction; eight covers an AVX-512 register
+/// of doubles and lets the compiler keep the loops free of carried dependencies
+inline constexpr std::size_t lg_lanes = 8;
+
+/// Block length used by lg_accumulator so the second pass reads from L1
+inline constexpr std::size_t lg_block = 2048;
+
+/// Two-pass max-shift log-sum-exp over n log values produced by get(i)
+/// @return {max, Σ exp(x_i - max)}; the sum is 1 when max is +∞ and 0 when
+///         every term is -∞
+template<typename T, typename Get>
+std::pair<T, T> log_sum_exp_parts(std::size_t n, Get get) {
+    constexpr T neg_inf = -std::numeric_limits<T>::infinity();
+    
+    T lane_max[lg_lanes];
+    std::fill(lane_max, lane_max + lg_lanes, neg_inf);
+    std::size_t i = 0;
+    for (; i + lg_lanes <= n; i += lg_lanes) {
+        for (std::size_t l = 0; l < lg_lanes; ++l) {
+            lane_max[l] = std::max(lane_max[l], get(i + l));
+        }
+    }
+    for (; i < n; ++i) {
+        lane_max[0] = std::max(lane_max[0], get(i));
+    }
+    T m = *std::max_element(lane_max, lane_max + lg_lanes);
+    if (std::isinf(m)) {
+        return {m, m > 0 ? T(1) : T(0)};
+    }
+    
+    T lane_sum[lg_lanes] = {};
+    i = 0;
+    for (; i + lg_lanes <= n; i += lg_lanes) {
+        for (std::size_t l = 0; l < lg_lanes; ++l) {
+            lane_sum[l] += std::exp(get(i + l) - m);
+        }
+    }
+    for (; i < n; ++i) {
+        lane_sum[0] += std::exp(get(i) - m);
+    }
+    T s = 0;
+    for (std::size_t l = 0; l < lg_lanes; ++l) s += lane_sum[l];
+    return {m, s};
+}
+
+/// Log of Σ exp(x_i) over n log values produced by get(i)
+template<typename T, typename Get>
+T log_sum_exp(std::size_t n, Get get) {
+    auto [m, s] = log_sum_exp_parts<T>(n, get);
+    if (std::isinf(m)) return m;
+    return m + std::log(s);
+}
+
+} // namespace detail
+
+/**
+ * @brief Sum of many log-domain values without leaving the log domain
+ * @param values Contiguous lg values
+ * @return lg(Σ values)
+ * 
+ * @details
+ * Two-pass log-sum-exp: the first pass finds the maximum, the second sums
+ * exp(x - max) ∈ (0, 1]. Both passes run over independent lanes so they
+ * vectorize (exp() needs a vector math library, e.g. -O3 -ffast-math with
+ * glibc's libmvec). This is one exp per element and a single log overall,
+ * versus an exp/log round trip per element for repeated operator+.
+ */
+template<typename T>
+lg<T> lg_sum(span<const lg<T>> values) {
+    const lg<T>* data = values.data();
+    return lg<T>::from_log(detail::log_sum_exp<T>(
+        values.size(), [data](std::size_t i) { return data[i].log(); }));
+}
+
+template<typename T>
+lg<T> lg_sum(const std::vector<lg<T>>& values) {
+    return lg_sum(span<const lg<T>>(values));
+}
+
+/**
+ * @class lg_accumulator
+ * @brief Streaming log-sum-exp with an online max shift
+ * @tparam T Underlying floating-point type
+ * 
+ * @details
+ * Keeps a running (max, Σ exp(x - max)) pair. Single values rescale the
+ * running sum when a new maximum arrives; spans are reduced block-wise with
+ * the two-pass kernel and merged, so streaming input costs the same as lg_sum.
+ * 
+ * @code
+ * cbt::lg_accumulator<double> acc;
+ * for (const auto& chunk : chunks) acc.add(chunk);
+ * cbt::lgd total = acc.result();
+ * @endcode
+ */
+template<typename T>
+class lg_accumulator {
+private:
+    T max_;
+    T sum_;  ///< Σ exp(x - max_)
+    
+    void merge(T m, T s) {
+        if (s == 0) return;
+        if (m > max_) {
+            sum_ = sum_ * std::exp(max_ - m) + s;
+            max_ = m;
+        } else if (std::isinf(max_)) {
+            // +∞ absorbs everything
+        } else {
+            sum_ += s * std::exp(m - max_);
+        }
+    }
+    
+public:
+    lg_accumulator() : max_(-std::numeric_limits<T>::infinity()), sum_(0) {}
+    
+    void add(const lg<T>& x) {
+        merge(x.log(), std::isinf(x.log()) && x.log() < 0 ? T(0) : T(1));
+    }
+    
+    void add(span<const lg<T>> values) {
+        for (std::size_t offset = 0; offset < values.size(); offset += detail::lg_block) {
+            std::size_t count = std::min(detail::lg_block, values.size() - offset);
+            const lg<T>* data = values.data() + offset;
+            auto [m, s] = detail::log_sum_exp_parts<T>(
+                count, [data](std::size_t i) { return data[i].log(); });
+            merge(m, s);
+        }
+    }
+    
+    void add(const std::vector<lg<T>>& values) {
+        add(span<const lg<T>>(values));
+    }
+    
+    /// @brief Current sum as an lg value
+    lg<T> result() const {
+        if (sum_ == 0) return lg<T>();
+        if (std::isinf(max_)) return lg<T>::from_log(max_);
+        return lg<T>::from_log(max_ + std::log(sum_));
+    }
+    
+    void reset() {
+        max_ = -std::numeric_limits<T>::infinity();
+        sum_ = 0;
+    }
+};
+
 /// @typedef lgf
 /// @brief Single-precision logarithmic transform
 using lgf = lg<float>;
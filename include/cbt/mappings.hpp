@@ -10,18 +10,98 @@
  * Key Insight: The "normal" computational basis is just one node
  * in a graph of possible representations. Direct edges between
  * CBTs can be more efficient and preserve more information.
+ *
+ * The graph is explicit: each direct mapping is a conversion_edge with a
+ * cost, and cbt_converter<From, To> finds the cheapest route at compile
+ * time (Floyd-Warshall over the registered nodes). The route is one
+ * inlined composition of representation-level hops, so e.g.
+ * tropical_min → lg → multiscale passes the log value straight through
+ * and never forms the real number. convert_batch() runs whole spans, with
+ * lane-blocked kernels for lg ↔ multiscale and lg ↔ tropical_min.
  */
 
 #pragma once
 #include "logarithmic.hpp"
 #include "multiscale.hpp"
 #include "dual.hpp"
+#include "instrumentation.hpp"
 #include "interval.hpp"
+#include "span.hpp"
 #include "tropical.hpp"
-#include <limits>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace cbt {
+namespace detail {
+
+template<typename T>
+using if_real = std::enable_if_t<std::is_floating_point_v<T>>;
+
+/// ln SCALE = SCALE_FACTOR·ln 10 split as hi + lo (Cody-Waite), with hi
+/// short enough that k·hi is exact for every level |k| < 2^8
+template<typename T, int SCALE_FACTOR>
+struct multiscale_log_scale {
+    static constexpr long double exact = SCALE_FACTOR * 2.302585092994045684017991454684364208L;
+
+    static constexpr T split() {
+        int integer_bits = 0;
+        for (long double v = exact; v >= 1; v /= 2) ++integer_bits;
+        long double unit = 1;
+        for (int b = 0; b < std::numeric_limits<T>::digits - 9 - integer_bits; ++b) unit /= 2;
+        return static_cast<T>(static_cast<long double>(static_cast<long long>(exact / unit)) * unit);
+    }
+
+    static constexpr T hi = split();
+    static constexpr T lo = static_cast<T>(exact - hi);
+    static constexpr T inverse = static_cast<T>(1 / exact);
+};
+
+/**
+ * Normalized multiscale parts of e^log_value, without forming e^log_value
+ *
+ * The level is ⌊log / ln SCALE⌋ + 1 in integer arithmetic, saturated to the
+ * int8_t range; the mantissa is exp of the reduced argument (|·| < ln SCALE)
+ * and one select corrects the rounding at a level boundary. Branch-free, so
+ * lane loops over it vectorize given a vector exp (e.g. -O3 -ffast-math
+ * with glibc's libmvec). Saturated levels leave the mantissa unnormalized
+ * (growing to +∞ past the top), as multiscale_normalize does.
+ */
+template<typename T, int SCALE_FACTOR>
+void multiscale_parts_from_log(T log_value, T& mantissa, int& scale) {
+    using powers = multiscale_powers<T, SCALE_FACTOR>;
+    using ln_scale = multiscale_log_scale<T, SCALE_FACTOR>;
+    T q = log_value * ln_scale::inverse;
+    q = q < T(130) ? q : T(130);   // +∞ and NaN saturate high
+    q = q > T(-130) ? q : T(-130);
+    int k = static_cast<int>(q);
+    k = k - (T(k) > q) + 1;
+    k = k < 127 ? k : 127;
+    k = k > -128 ? k : -128;
+    T m = std::exp((log_value - T(k) * ln_scale::hi) - T(k) * ln_scale::lo);
+    const bool up = (m >= 1) & (k < 127);
+    const bool down = (m < powers::inv_scale) & (k > -128);
+    mantissa = m * (up ? powers::inv_scale : (down ? powers::scale : T(1)));
+    k += int(up) - int(down);
+    scale = m == 0 ? 0 : k;
+}
+
+/// Natural log of m·SCALEᵏ, without forming SCALEᵏ
+template<typename T, int SCALE_FACTOR>
+T log_from_multiscale_parts(T mantissa, int scale) {
+    using ln_scale = multiscale_log_scale<T, SCALE_FACTOR>;
+    const T k = T(scale);
+    return std::log(mantissa) + (k * ln_scale::hi + k * ln_scale::lo);
+}
+
+} // namespace detail
+
 namespace mappings {
 
 /**
@@ -31,34 +111,22 @@ namespace mappings {
  * - Both handle extreme ranges
  * - lg preserves ratios, multiscale preserves scales
  * - Direct mapping avoids overflow that would occur via normal domain
+ *
+ * Values beyond the multiscale level range saturate at level 127 (+∞
+ * mantissa) or round to zero.
  */
 template<typename T, int SCALE_FACTOR = 3>
 multiscale<T, SCALE_FACTOR> lg_to_multiscale(const lg<T>& x) {
-    T log_val = x.log();
-    
-    // Handle special cases
-    if (std::isinf(log_val)) {
-        if (log_val < 0) return multiscale<T, SCALE_FACTOR>(0);
-        // Positive infinity in log domain
-        return multiscale<T, SCALE_FACTOR>(std::numeric_limits<T>::max());
-    }
-    
-    // Convert log value directly to mantissa and scale
-    // log(x) = log(mantissa) + scale * log(SCALE)
-    constexpr T LOG_SCALE = std::log(T(10)) * SCALE_FACTOR;
-    int scale = static_cast<int>(log_val / LOG_SCALE);
-    T mantissa_log = log_val - scale * LOG_SCALE;
-    T mantissa = std::exp(mantissa_log);
-    
-    return multiscale<T, SCALE_FACTOR>(mantissa, scale);
+    T mantissa;
+    int scale;
+    detail::multiscale_parts_from_log<T, SCALE_FACTOR>(x.log(), mantissa, scale);
+    return multiscale<T, SCALE_FACTOR>::from_normalized(mantissa, static_cast<std::int8_t>(scale));
 }
 
 template<typename T, int SCALE_FACTOR = 3>
 lg<T> multiscale_to_lg(const multiscale<T, SCALE_FACTOR>& x) {
     // Direct conversion: log(mantissa * 10^(scale*SCALE_FACTOR))
-    T log_val = std::log(x.mantissa()) + 
-                x.scale_level() * SCALE_FACTOR * std::log(T(10));
-    return lg<T>::from_log(log_val);
+    return lg<T>::from_log(detail::log_from_multiscale_parts<T, SCALE_FACTOR>(x.mantissa(), x.scale_level()));
 }
 
 /**
@@ -98,10 +166,9 @@ tropical_min<T> lg_to_tropical_min(const lg<T>& x) {
 
 template<typename T>
 lg<T> tropical_min_to_lg(const tropical_min<T>& x) {
-    if (x.is_infinite()) {
-        return lg<T>(0);  // Return lg of 0 (maps to -infinity)
-    }
-    return lg<T>::from_log(x.value());
+    // Infinite values map to lg of 0 (-infinity); a select, so batches vectorize
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    return lg<T>::from_log(std::abs(x.value()) == inf ? -inf : x.value());
 }
 
 /**
@@ -119,48 +186,364 @@ interval<T> multiscale_to_interval(const multiscale<T, SCALE_FACTOR>& x) {
     return interval<T>::from_radius(value, epsilon);
 }
 
+/**
+ * Conversion Graph
+ *
+ * conversion_edge<From, To> registers a direct mapping with a cost and
+ * apply() (plus apply_batch() where a kernel beats a per-element loop).
+ * Costs rank what a hop risks, so the cheapest route keeps values in
+ * representation space: forming the plain real number (overflow) and
+ * discarding bounds or derivatives are the expensive steps.
+ */
+namespace conversion_cost {
+constexpr int relabel = 1;          // same numbers, new meaning
+constexpr int arithmetic = 2;       // a few flops
+constexpr int transcendental = 8;   // one exp or log
+constexpr int real_domain = 32;     // forms the plain value: may overflow
+constexpr int lossy = 64;           // drops bounds or derivative
+} // namespace conversion_cost
+
+template<typename From, typename To, typename = void>
+struct conversion_edge {
+    static constexpr bool exists = false;
+};
+
+template<typename T>
+struct conversion_edge<T, lg<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::transcendental;
+    static lg<T> apply(T x) { return lg<T>(x); }
+};
+
+template<typename T>
+struct conversion_edge<lg<T>, T, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::transcendental + conversion_cost::real_domain;
+    static T apply(const lg<T>& x) { return x.value(); }
+};
+
+template<typename T, int SCALE_FACTOR>
+struct conversion_edge<T, multiscale<T, SCALE_FACTOR>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::arithmetic;
+    static multiscale<T, SCALE_FACTOR> apply(T x) { return multiscale<T, SCALE_FACTOR>(x); }
+};
+
+template<typename T, int SCALE_FACTOR>
+struct conversion_edge<multiscale<T, SCALE_FACTOR>, T, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::arithmetic + conversion_cost::real_domain;
+    static T apply(const multiscale<T, SCALE_FACTOR>& x) { return x.to_value(); }
+};
+
+template<typename T, int SCALE_FACTOR>
+struct conversion_edge<lg<T>, multiscale<T, SCALE_FACTOR>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::transcendental;
+    static multiscale<T, SCALE_FACTOR> apply(const lg<T>& x) { return lg_to_multiscale<T, SCALE_FACTOR>(x); }
+
+    /// Parts for lg_lanes inputs at a time into local arrays (the exp loop
+    /// vectorizes), then one pass to write the {mantissa, int8_t} structs
+    static void apply_batch(const lg<T>* from, multiscale<T, SCALE_FACTOR>* to, std::size_t n) {
+        constexpr std::size_t lanes = detail::lg_lanes;
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            T mantissa[lanes];
+            int scale[lanes];
+            for (std::size_t l = 0; l < lanes; ++l) {
+                detail::multiscale_parts_from_log<T, SCALE_FACTOR>(from[i + l].log(), mantissa[l], scale[l]);
+            }
+            for (std::size_t l = 0; l < lanes; ++l) {
+                to[i + l] = multiscale<T, SCALE_FACTOR>::from_normalized(mantissa[l], static_cast<std::int8_t>(scale[l]));
+            }
+        }
+        for (; i < n; ++i) to[i] = apply(from[i]);
+    }
+};
+
+template<typename T, int SCALE_FACTOR>
+struct conversion_edge<multiscale<T, SCALE_FACTOR>, lg<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::transcendental;
+    static lg<T> apply(const multiscale<T, SCALE_FACTOR>& x) { return multiscale_to_lg<T, SCALE_FACTOR>(x); }
+
+    static void apply_batch(const multiscale<T, SCALE_FACTOR>* from, lg<T>* to, std::size_t n) {
+        constexpr std::size_t lanes = detail::lg_lanes;
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            T log_value[lanes];
+            for (std::size_t l = 0; l < lanes; ++l) {
+                log_value[l] = detail::log_from_multiscale_parts<T, SCALE_FACTOR>(from[i + l].mantissa(),
+                                                                                 from[i + l].scale_level());
+            }
+            for (std::size_t l = 0; l < lanes; ++l) to[i + l] = lg<T>::from_log(log_value[l]);
+        }
+        for (; i < n; ++i) to[i] = apply(from[i]);
+    }
+};
+
+template<typename T>
+struct conversion_edge<lg<T>, tropical_min<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::relabel;
+    static tropical_min<T> apply(const lg<T>& x) { return lg_to_tropical_min(x); }
+
+    static void apply_batch(const lg<T>* from, tropical_min<T>* to, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) to[i] = apply(from[i]);
+    }
+};
+
+template<typename T>
+struct conversion_edge<tropical_min<T>, lg<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::relabel;
+    static lg<T> apply(const tropical_min<T>& x) { return tropical_min_to_lg(x); }
+
+    static void apply_batch(const tropical_min<T>* from, lg<T>* to, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) to[i] = apply(from[i]);
+    }
+};
+
+template<typename T>
+struct conversion_edge<T, interval<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::relabel;
+    static interval<T> apply(T x) { return interval<T>(x); }
+};
+
+template<typename T>
+struct conversion_edge<interval<T>, T, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::relabel + conversion_cost::lossy;
+    static T apply(const interval<T>& x) { return x.mid(); }
+};
+
+template<typename T>
+struct conversion_edge<T, dual<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::relabel;
+    static dual<T> apply(T x) { return dual<T>(x); }
+};
+
+template<typename T>
+struct conversion_edge<dual<T>, T, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::relabel + conversion_cost::lossy;
+    static T apply(const dual<T>& x) { return x.value(); }
+};
+
+template<typename T, int SCALE_FACTOR>
+struct conversion_edge<multiscale<T, SCALE_FACTOR>, interval<T>, detail::if_real<T>> {
+    static constexpr bool exists = true;
+    static constexpr int cost = conversion_cost::arithmetic + conversion_cost::real_domain;
+    static interval<T> apply(const multiscale<T, SCALE_FACTOR>& x) { return multiscale_to_interval(x); }
+};
+
+// dual_to_interval and interval_to_dual are heuristics (invented width,
+// invented derivative), so they are deliberately not edges
+
+/// Underlying scalar of a CBT; its hubs are the intermediate graph nodes
+template<typename X>
+struct conversion_scalar {
+    using type = std::conditional_t<std::is_floating_point_v<X>, X, void>;
+};
+
+template<typename T> struct conversion_scalar<lg<T>> { using type = T; };
+template<typename T, int S> struct conversion_scalar<multiscale<T, S>> { using type = T; };
+template<typename T> struct conversion_scalar<tropical_min<T>> { using type = T; };
+template<typename T> struct conversion_scalar<interval<T>> { using type = T; };
+template<typename T> struct conversion_scalar<dual<T>> { using type = T; };
+
+template<typename T>
+struct conversion_hubs {
+    using type = std::tuple<T, lg<T>, multiscale<T>, tropical_min<T>, interval<T>, dual<T>>;
+};
+
+template<>
+struct conversion_hubs<void> {
+    using type = std::tuple<>;
+};
+
+} // namespace mappings
+
+namespace detail {
+
+constexpr int conversion_unreachable = std::numeric_limits<int>::max() / 4;
+
+template<typename From, typename To>
+constexpr int edge_cost() {
+    if constexpr (std::is_same_v<From, To>) return 0;
+    else if constexpr (mappings::conversion_edge<From, To>::exists) return mappings::conversion_edge<From, To>::cost;
+    else return conversion_unreachable;
+}
+
+template<std::size_t N>
+struct conversion_plan {
+    std::array<std::array<int, N>, N> distance;
+    std::array<std::array<std::size_t, N>, N> next;   // first hop of a cheapest i → j route
+};
+
+template<typename From, typename... Nodes>
+constexpr std::array<int, sizeof...(Nodes)> edge_costs_from() {
+    return {{edge_cost<From, Nodes>()...}};
+}
+
+/// All-pairs cheapest routes (Floyd-Warshall); a handful of nodes, so cheap to evaluate at compile time
+template<typename... Nodes>
+constexpr conversion_plan<sizeof...(Nodes)> plan_conversions() {
+    constexpr std::size_t n = sizeof...(Nodes);
+    conversion_plan<n> plan{{{edge_costs_from<Nodes, Nodes...>()...}}, {}};
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) plan.next[i][j] = j;
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                int through = plan.distance[i][k] + plan.distance[k][j];
+                if (through < plan.distance[i][j]) {
+                    plan.distance[i][j] = through;
+                    plan.next[i][j] = plan.next[i][k];
+                }
+            }
+        }
+    }
+    return plan;
+}
+
+template<typename... Nodes>
+struct conversion_graph {
+    template<std::size_t I>
+    using node = std::tuple_element_t<I, std::tuple<Nodes...>>;
+
+    static constexpr conversion_plan<sizeof...(Nodes)> plan = plan_conversions<Nodes...>();
+};
+
+template<typename From, typename To, typename Hubs>
+struct conversion_graph_over;
+
+template<typename From, typename To, typename... Hubs>
+struct conversion_graph_over<From, To, std::tuple<Hubs...>> {
+    using type = conversion_graph<From, To, Hubs...>;
+};
+
+/// The cheapest I → J route as one composed call; hops between
+/// duplicate nodes (To is also a hub) are skipped, not executed
+template<typename Graph, std::size_t I, std::size_t J, typename = void>
+struct conversion_route {
+    static constexpr std::size_t middle = Graph::plan.next[I][J];
+    using from_type = typename Graph::template node<I>;
+    using middle_type = typename Graph::template node<middle>;
+    using rest = conversion_route<Graph, middle, J>;
+    static constexpr bool relabels = std::is_same_v<from_type, middle_type>;
+    static constexpr std::size_t hops = (relabels ? 0 : 1) + rest::hops;
+
+    static typename Graph::template node<J> apply(const from_type& x) {
+        if constexpr (relabels) return rest::apply(x);
+        else return rest::apply(mappings::conversion_edge<from_type, middle_type>::apply(x));
+    }
+};
+
+template<typename Graph, std::size_t I>
+struct conversion_route<Graph, I, I, void> {
+    static constexpr std::size_t hops = 0;
+
+    static typename Graph::template node<I> apply(const typename Graph::template node<I>& x) { return x; }
+};
+
+template<typename Edge, typename = void>
+struct has_batch_edge : std::false_type {};
+
+template<typename Edge>
+struct has_batch_edge<Edge, std::void_t<decltype(&Edge::apply_batch)>> : std::true_type {};
+
+} // namespace detail
+
+namespace mappings {
+
+/**
+ * Universal CBT Interface
+ *
+ * cbt_converter<From, To> converts along the cheapest registered route:
+ * exists, cost and hops describe it at compile time, convert() and
+ * convert_batch() run it. Single-hop routes with a batch kernel use it;
+ * longer routes run as one fused per-element loop.
+ */
+template<typename From, typename To>
+struct cbt_converter {
+private:
+    using graph = typename detail::conversion_graph_over<
+        From, To, typename conversion_hubs<typename conversion_scalar<From>::type>::type>::type;
+    using route = detail::conversion_route<graph, 0, 1>;
+    using direct = conversion_edge<From, To>;
+
+public:
+    static constexpr int cost = graph::plan.distance[0][1];
+    static constexpr bool exists = cost < detail::conversion_unreachable;
+    static constexpr std::size_t hops = exists ? route::hops : 0;
+
+    static To convert(const From& from) {
+        static_assert(exists, "no registered conversion route between these types");
+        instrumentation::count(instrumentation::counter::conversions);
+        return route::apply(from);
+    }
+
+    /// @throws std::invalid_argument if the spans differ in size
+    static void convert_batch(span<const From> from, span<To> to) {
+        static_assert(exists, "no registered conversion route between these types");
+        if (from.size() != to.size()) {
+            throw std::invalid_argument("convert_batch spans must have equal sizes");
+        }
+        instrumentation::count(instrumentation::counter::conversions, from.size());
+        if constexpr (hops == 1 && detail::edge_cost<From, To>() == cost && detail::has_batch_edge<direct>::value) {
+            direct::apply_batch(from.data(), to.data(), from.size());
+        } else {
+            for (std::size_t i = 0; i < from.size(); ++i) to[i] = route::apply(from[i]);
+        }
+    }
+};
+
+template<typename To, typename From>
+To convert(const From& from) {
+    return cbt_converter<From, To>::convert(from);
+}
+
+/// @throws std::invalid_argument if the spans differ in size
+template<typename From, typename To>
+void convert_batch(span<const From> from, span<To> to) {
+    cbt_converter<From, To>::convert_batch(from, to);
+}
+
+template<typename To, typename From>
+std::vector<To> convert_batch(const std::vector<From>& from) {
+    std::vector<To> to(from.size());
+    cbt_converter<From, To>::convert_batch(span<const From>(from), span<To>(to));
+    return to;
+}
+
 /**
  * Composed mappings for multi-hop transformations
  */
 template<typename T>
 class cbt_network {
-    // This could be extended to a full graph-based transformation system
-    // with optimal path finding between any two CBT domains
 public:
     // Example: Transform through intermediate domain to preserve properties
     template<int SCALE_FACTOR = 3>
     static multiscale<T, SCALE_FACTOR> lg_to_multiscale_via_dual(const lg<T>& x) {
-        // Create dual number with log derivative
-        dual<T> d(x.value(), x.value());  // d/dx of e^x = e^x
+        // Carry the log value, not x.value() (which overflows beyond e^709):
+        // as a dual in the log domain, d/dx log e^x = 1
+        dual<T> d(x.log(), T(1));
         
         // Convert to interval for bounds checking
         interval<T> i = dual_to_interval(d);
         
-        // Finally to multiscale
-        return multiscale<T, SCALE_FACTOR>(i.mid());
+        // Finally to multiscale, straight from the log domain
+        return lg_to_multiscale<T, SCALE_FACTOR>(lg<T>::from_log(i.mid()));
     }
-    
-    // Optimal path finder between CBTs could be implemented here
-    // using graph algorithms to minimize information loss
-};
 
-/**
- * Universal CBT Interface
- * 
- * Concept: All CBTs could implement a common interface for
- * inter-domain mappings, enabling automatic conversion networks
- */
-template<typename From, typename To>
-struct cbt_converter {
-    // Specializations would implement specific conversions
-    static To convert(const From& from);
-};
-
-// Example specialization
-template<typename T>
-struct cbt_converter<lg<T>, multiscale<T, 3>> {
-    static multiscale<T, 3> convert(const lg<T>& from) {
-        return lg_to_multiscale<T, 3>(from);
+    /// Cheapest registered route from From to To (see cbt_converter)
+    template<typename To, typename From>
+    static To convert(const From& from) {
+        return cbt_converter<From, To>::convert(from);
     }
 };
 
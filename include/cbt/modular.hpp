@@ -7,6 +7,11 @@
  * Trade-off:
  *   Gain: Bounded values, cryptographic properties
  *   Loss: Ordering loses meaning, division complex
+ *
+ * Multiplication never divides: odd moduli use Montgomery form (values
+ * stay as a·R mod m across whole operation chains and are converted back
+ * only by value()), even moduli use Barrett reduction, and moduli up to
+ * 2⁶⁴ are supported through 128-bit products. See modular_reduction.hpp.
  * 
  * Applications:
  *   - Cryptography (RSA, Diffie-Hellman)
@@ -16,75 +21,96 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include "modular_reduction.hpp"
 
 namespace cbt {
 
+namespace detail {
+
+/// Unsigned storage word for residues of T: 32 bits when they fit, else 64
+template<typename T>
+using modular_word_t = std::conditional_t<sizeof(T) <= 4, std::uint32_t, std::uint64_t>;
+
+/// Canonical x mod m for any integral x, including negative values
+template<typename U, typename T>
+constexpr U reduce_integral(T x, U m) {
+    using S = std::make_unsigned_t<T>;
+    if constexpr (std::is_signed_v<T>) {
+        if (x < 0) {
+            U r = static_cast<U>((S(0) - static_cast<S>(x)) % m);
+            return r == 0 ? U(0) : static_cast<U>(m - r);
+        }
+    }
+    return static_cast<U>(static_cast<S>(x) % m);
+}
+
+} // namespace detail
+
 template<typename T, T Modulus>
 class modular {
     static_assert(std::is_integral_v<T>, "modular requires integral type");
     static_assert(Modulus > 0, "Modulus must be positive");
     
+public:
+    using word_type = detail::modular_word_t<T>;
+    using engine_type = detail::modular_engine_t<word_type, static_cast<word_type>(Modulus)>;
+    
 private:
-    T value_;
+    word_type value_;  ///< Residue in the engine's form (Montgomery for odd moduli)
     
-    static T mod(T x) {
-        T result = x % Modulus;
-        return result < 0 ? result + Modulus : result;
-    }
+    static constexpr engine_type engine_{static_cast<word_type>(Modulus)};
+    static constexpr word_type modulus_word = static_cast<word_type>(Modulus);
     
-    // Extended Euclidean algorithm for modular inverse
-    static T extended_gcd(T a, T b, T& x, T& y) {
-        if (b == 0) {
-            x = 1;
-            y = 0;
-            return a;
-        }
-        T x1, y1;
-        T gcd = extended_gcd(b, a % b, x1, y1);
-        x = y1;
-        y = x1 - (a / b) * y1;
-        return gcd;
+    static constexpr modular from_form(word_type form) {
+        modular result;
+        result.value_ = form;
+        return result;
     }
     
 public:
     // Constructors
-    modular() : value_(0) {}
-    explicit modular(T value) : value_(mod(value)) {}
+    constexpr modular() : value_(0) {}
+    explicit constexpr modular(T value)
+        : value_(static_cast<word_type>(
+              engine_.to_form(detail::reduce_integral(value, modulus_word)))) {}
     
     // Getters
-    T value() const { return value_; }
+    constexpr T value() const { return static_cast<T>(engine_.from_form(value_)); }
     static constexpr T modulus() { return Modulus; }
     
-    // Arithmetic operations
-    modular operator+(const modular& other) const {
-        return modular(value_ + other.value_);
+    // Arithmetic operations (all stay in the engine's form)
+    constexpr modular operator+(const modular& other) const {
+        return from_form(static_cast<word_type>(engine_.add(value_, other.value_)));
     }
     
-    modular operator-(const modular& other) const {
-        return modular(value_ - other.value_);
+    constexpr modular operator-(const modular& other) const {
+        return from_form(static_cast<word_type>(engine_.sub(value_, other.value_)));
     }
     
-    modular operator*(const modular& other) const {
-        return modular(static_cast<long long>(value_) * other.value_);
+    constexpr modular operator*(const modular& other) const {
+        return from_form(static_cast<word_type>(engine_.mul(value_, other.value_)));
     }
     
-    modular operator/(const modular& other) const {
+    constexpr modular operator/(const modular& other) const {
         return *this * other.inverse();
     }
     
-    modular operator-() const {
-        return modular(-value_);
+    constexpr modular operator-() const {
+        return from_form(static_cast<word_type>(engine_.sub(0, value_)));
     }
     
     // Modular exponentiation (fast power)
-    modular pow(T exponent) const {
+    constexpr modular pow(T exponent) const {
         if (exponent < 0) {
             return inverse().pow(-exponent);
         }
         
-        modular result(1);
+        modular result = from_form(static_cast<word_type>(engine_.one()));
         modular base = *this;
         
         while (exponent > 0) {
@@ -99,38 +125,41 @@ public:
     }
     
     // Modular inverse (exists only if gcd(value, Modulus) = 1)
-    modular inverse() const {
-        T x, y;
-        T gcd = extended_gcd(value_, Modulus, x, y);
-        if (gcd != 1) {
+    constexpr modular inverse() const {
+        word_type canonical = static_cast<word_type>(engine_.from_form(value_));
+        word_type inv = detail::mod_inverse(canonical, modulus_word, [](word_type a, word_type b) {
+            return static_cast<word_type>(engine_.from_form(
+                static_cast<word_type>(engine_.mul(engine_.to_form(a), b))));
+        });
+        if (inv == 0 && modulus_word != 1) {
             throw std::runtime_error("Modular inverse does not exist");
         }
-        return modular(x);
+        return from_form(static_cast<word_type>(engine_.to_form(inv)));
     }
     
     // Check if invertible
-    bool is_unit() const {
-        return std::gcd(value_, Modulus) == 1;
+    constexpr bool is_unit() const {
+        return std::gcd(static_cast<word_type>(engine_.from_form(value_)), modulus_word) == 1;
     }
     
-    // Comparison
-    bool operator==(const modular& other) const {
+    // Comparison (the form is a bijection, so equality needs no conversion)
+    constexpr bool operator==(const modular& other) const {
         return value_ == other.value_;
     }
     
-    bool operator!=(const modular& other) const {
+    constexpr bool operator!=(const modular& other) const {
         return value_ != other.value_;
     }
     
     // Note: < and > don't have mathematical meaning in modular arithmetic
     // but can be useful for data structures
-    bool operator<(const modular& other) const {
-        return value_ < other.value_;
+    constexpr bool operator<(const modular& other) const {
+        return value() < other.value();
     }
     
     // Output
     friend std::ostream& operator<<(std::ostream& os, const modular& m) {
-        return os << m.value_ << " (mod " << Modulus << ")";
+        return os << m.value() << " (mod " << Modulus << ")";
     }
 };
 
@@ -138,51 +167,104 @@ public:
 using mod7 = modular<int, 7>;
 using mod256 = modular<int, 256>;
 using mod_prime = modular<int, 1000000007>;  // Common in competitive programming
+using mod_goldilocks = modular<std::uint64_t, 0xFFFFFFFF00000001ull>;  // 2⁶⁴ - 2³² + 1
 
 // Dynamic modulus version
 template<typename T>
 class modular_dynamic {
     static_assert(std::is_integral_v<T>, "modular requires integral type");
     
+public:
+    using word_type = detail::modular_word_t<T>;
+    using engine_type = detail::runtime_reducer<word_type>;
+    
 private:
-    T value_;
-    T modulus_;
+    word_type value_;      ///< Residue in the engine's form
+    engine_type engine_;   ///< Constants precomputed once per modulus
     
-    T mod(T x) const {
-        T result = x % modulus_;
-        return result < 0 ? result + modulus_ : result;
+    static engine_type make_engine(T modulus) {
+        if (modulus <= 0) {
+            throw std::invalid_argument("Modulus must be positive");
+        }
+        return engine_type(static_cast<word_type>(modulus));
+    }
+    
+    modular_dynamic(word_type form, const engine_type& engine)
+        : value_(form), engine_(engine) {}
+    
+    void check_modulus(const modular_dynamic& other) const {
+        if (modulus() != other.modulus()) {
+            throw std::invalid_argument("Moduli must match");
+        }
     }
     
 public:
     modular_dynamic(T value, T modulus) 
-        : value_(0), modulus_(modulus) {
-        if (modulus_ <= 0) {
-            throw std::invalid_argument("Modulus must be positive");
-        }
-        value_ = mod(value);
+        : value_(0), engine_(make_engine(modulus)) {
+        value_ = engine_.to_form(detail::reduce_integral(value, engine_.modulus()));
     }
     
-    T value() const { return value_; }
-    T modulus() const { return modulus_; }
+    T value() const { return static_cast<T>(engine_.from_form(value_)); }
+    T modulus() const { return static_cast<T>(engine_.modulus()); }
     
     modular_dynamic operator+(const modular_dynamic& other) const {
-        if (modulus_ != other.modulus_) {
-            throw std::invalid_argument("Moduli must match");
-        }
-        return modular_dynamic(value_ + other.value_, modulus_);
+        check_modulus(other);
+        return modular_dynamic(engine_.add(value_, other.value_), engine_);
+    }
+    
+    modular_dynamic operator-(const modular_dynamic& other) const {
+        check_modulus(other);
+        return modular_dynamic(engine_.sub(value_, other.value_), engine_);
     }
     
     modular_dynamic operator*(const modular_dynamic& other) const {
-        if (modulus_ != other.modulus_) {
-            throw std::invalid_argument("Moduli must match");
+        check_modulus(other);
+        return modular_dynamic(engine_.mul(value_, other.value_), engine_);
+    }
+    
+    modular_dynamic operator/(const modular_dynamic& other) const {
+        return *this * other.inverse();
+    }
+    
+    modular_dynamic pow(T exponent) const {
+        if (exponent < 0) {
+            return inverse().pow(-exponent);
         }
-        return modular_dynamic(static_cast<long long>(value_) * other.value_, 
-                              modulus_);
+        modular_dynamic result(engine_.one(), engine_);
+        modular_dynamic base = *this;
+        while (exponent > 0) {
+            if (exponent & 1) {
+                result = result * base;
+            }
+            base = base * base;
+            exponent >>= 1;
+        }
+        return result;
+    }
+    
+    modular_dynamic inverse() const {
+        word_type m = engine_.modulus();
+        word_type inv = detail::mod_inverse(engine_.from_form(value_), m,
+            [this](word_type a, word_type b) {
+                return engine_.from_form(engine_.mul(engine_.to_form(a), b));
+            });
+        if (inv == 0 && m != 1) {
+            throw std::runtime_error("Modular inverse does not exist");
+        }
+        return modular_dynamic(engine_.to_form(inv), engine_);
+    }
+    
+    bool operator==(const modular_dynamic& other) const {
+        return modulus() == other.modulus() && value_ == other.value_;
+    }
+    
+    bool operator!=(const modular_dynamic& other) const {
+        return !(*this == other);
     }
     
     friend std::ostream& operator<<(std::ostream& os, const modular_dynamic& m) {
-        return os << m.value_ << " (mod " << m.modulus_ << ")";
+        return os << m.value() << " (mod " << m.modulus() << ")";
     }
 };
 
-} // namespace cbt
\ No newline at end of file
+} // namespace cbt
@@ -0,0 +1,354 @@
+/**
+ * Modular Reduction Engines - Division-Free Residue Arithmetic
+ *
+ * Transform: x mod m → multiply-high and shift with precomputed constants
+ *
+ * Trade-off:
+ *   Gain: No hardware division on the hot path; constants are computed
+ *         once per modulus and shared by every value
+ *   Loss: Constants must be precomputed and stored with the modulus
+ *
+ * Engines:
+ *   - barrett_reducer: any modulus below 2³², values kept canonical
+ *   - montgomery_reducer<U>: any odd modulus (U = uint32_t or uint64_t),
+ *     values kept in Montgomery form a·R mod m with R = 2^(bits of U)
+ *   - wide_reducer: even moduli of 2³² and above, via 128-bit division
+ *
+ * All three share one interface (to_form, from_form, one, add, sub, mul),
+ * so modular and modular_dynamic are written once against any of them.
+ *
+ * Used by residue_number_system (one reducer per channel) and modular.
+ */
+
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cbt {
+
+namespace detail {
+
+/// High 64 bits of the 128-bit product a·b
+constexpr std::uint64_t mulhi64(std::uint64_t a, std::uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+    std::uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    std::uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    std::uint64_t lo_lo = a_lo * b_lo;
+    std::uint64_t hi_lo = a_hi * b_lo;
+    std::uint64_t lo_hi = a_lo * b_hi;
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/// Low and high halves of the double-width product a·b
+template<typename U>
+constexpr void mul_wide(U a, U b, U& lo, U& hi) {
+    if constexpr (sizeof(U) <= 4) {
+        std::uint64_t p = static_cast<std::uint64_t>(a) * b;
+        lo = static_cast<U>(p);
+        hi = static_cast<U>(p >> 32);
+    } else {
+        lo = a * b;
+        hi = mulhi64(a, b);
+    }
+}
+
+/// (a + b) mod m for a, b < m, correct even when a + b wraps the word
+template<typename U>
+constexpr U add_mod(U a, U b, U m) {
+    U s = a + b;
+    return (s < a || s >= m) ? static_cast<U>(s - m) : s;
+}
+
+template<typename U>
+constexpr U sub_mod(U a, U b, U m) {
+    return a >= b ? static_cast<U>(a - b) : static_cast<U>(a - b + m);
+}
+
+} // namespace detail
+
+/**
+ * Barrett reduction for moduli below 2³²
+ *
+ * With μ = ⌊(2⁶⁴-1)/m⌋, q = ⌊x·μ / 2⁶⁴⌋ underestimates ⌊x/m⌋ by at most one,
+ * so x - q·m needs a single conditional subtraction. Any product of two
+ * residues fits the 64-bit input.
+ */
+class barrett_reducer {
+private:
+    std::uint64_t modulus_;
+    std::uint64_t mu_;
+
+public:
+    constexpr barrett_reducer() : modulus_(1), mu_(~std::uint64_t(0)) {}
+
+    explicit constexpr barrett_reducer(std::uint64_t modulus)
+        : modulus_(modulus), mu_(0) {
+        if (modulus == 0 || modulus > 0xFFFFFFFFu) {
+            throw std::invalid_argument("Barrett modulus must be in [1, 2^32)");
+        }
+        mu_ = ~std::uint64_t(0) / modulus;
+    }
+
+    constexpr std::uint64_t modulus() const { return modulus_; }
+
+    /// @brief x mod m for any 64-bit x
+    constexpr std::uint64_t reduce(std::uint64_t x) const {
+        std::uint64_t q = detail::mulhi64(x, mu_);
+        std::uint64_t r = x - q * modulus_;
+        return r >= modulus_ ? r - modulus_ : r;
+    }
+
+    /// @brief a·b mod m for residues a, b < m
+    constexpr std::uint64_t mul(std::uint64_t a, std::uint64_t b) const {
+        return reduce(a * b);
+    }
+
+    // Engine interface: values are kept canonical
+    constexpr std::uint64_t to_form(std::uint64_t x) const { return x; }
+    constexpr std::uint64_t from_form(std::uint64_t a) const { return a; }
+    constexpr std::uint64_t one() const { return reduce(1); }
+    constexpr std::uint64_t add(std::uint64_t a, std::uint64_t b) const {
+        return detail::add_mod(a, b, modulus_);
+    }
+    constexpr std::uint64_t sub(std::uint64_t a, std::uint64_t b) const {
+        return detail::sub_mod(a, b, modulus_);
+    }
+};
+
+/**
+ * Montgomery multiplication for odd moduli
+ *
+ * With R = 2^w (w = bits of U), values are stored as ā = a·R mod m and
+ * REDC(T) = T·R⁻¹ mod m needs only word multiplies and one conditional
+ * correction. Using the positive inverse m⁻¹ mod R, REDC subtracts the high
+ * half of q·m from the high half of T, so it never overflows even for m
+ * just below 2^w (e.g. the Goldilocks prime 2⁶⁴ - 2³² + 1).
+ *
+ * Conversions cost one REDC each; chains of +, -, · stay in form.
+ */
+template<typename U>
+class montgomery_reducer {
+    static_assert(std::is_same_v<U, std::uint32_t> || std::is_same_v<U, std::uint64_t>,
+                  "montgomery_reducer requires uint32_t or uint64_t");
+
+private:
+    U modulus_;
+    U inverse_;   ///< m⁻¹ mod R
+    U r1_;        ///< R mod m
+    U r2_;        ///< R² mod m
+
+    constexpr U redc(U lo, U hi) const {
+        U q = lo * inverse_;
+        U qm_lo = 0, qm_hi = 0;
+        detail::mul_wide(q, modulus_, qm_lo, qm_hi);
+        // lo - qm_lo == 0 exactly, so the result is hi - qm_hi (mod m)
+        return hi >= qm_hi ? static_cast<U>(hi - qm_hi) : static_cast<U>(hi - qm_hi + modulus_);
+    }
+
+public:
+    constexpr montgomery_reducer() : modulus_(1), inverse_(1), r1_(0), r2_(0) {}
+
+    explicit constexpr montgomery_reducer(U modulus)
+        : modulus_(modulus), inverse_(modulus), r1_(0), r2_(0) {
+        if (modulus % 2 == 0) {
+            throw std::invalid_argument("Montgomery modulus must be odd");
+        }
+        // Newton iteration doubles the number of correct low bits each step
+        for (int i = 0; i < 5; ++i) {
+            inverse_ *= static_cast<U>(2 - modulus * inverse_);
+        }
+        r1_ = static_cast<U>(static_cast<U>(0 - modulus) % modulus);
+        r2_ = r1_;
+        for (int i = 0; i < static_cast<int>(sizeof(U) * 8); ++i) {
+            r2_ = detail::add_mod(r2_, r2_, modulus_);
+        }
+    }
+
+    constexpr U modulus() const { return modulus_; }
+
+    /// @brief x·R mod m for x < m
+    constexpr U to_form(U x) const { return mul(x, r2_); }
+    /// @brief Canonical value a·R⁻¹ mod m
+    constexpr U from_form(U a) const { return redc(a, 0); }
+    constexpr U one() const { return r1_; }
+
+    constexpr U add(U a, U b) const { return detail::add_mod(a, b, modulus_); }
+    constexpr U sub(U a, U b) const { return detail::sub_mod(a, b, modulus_); }
+
+    constexpr U mul(U a, U b) const {
+        U lo = 0, hi = 0;
+        detail::mul_wide(a, b, lo, hi);
+        return redc(lo, hi);
+    }
+};
+
+/**
+ * Reduction for even moduli of 2³² and above
+ *
+ * Neither Barrett with a 64-bit μ nor Montgomery applies, so products are
+ * reduced by 128-bit division. Values are kept canonical.
+ */
+class wide_reducer {
+private:
+    std::uint64_t modulus_;
+
+public:
+    constexpr wide_reducer() : modulus_(1) {}
+
+    explicit constexpr wide_reducer(std::uint64_t modulus) : modulus_(modulus) {
+        if (modulus == 0) {
+            throw std::invalid_argument("Modulus must be positive");
+        }
+    }
+
+    constexpr std::uint64_t modulus() const { return modulus_; }
+
+    constexpr std::uint64_t to_form(std::uint64_t x) const { return x; }
+    constexpr std::uint64_t from_form(std::uint64_t a) const { return a; }
+    constexpr std::uint64_t one() const { return 1 % modulus_; }
+    constexpr std::uint64_t add(std::uint64_t a, std::uint64_t b) const {
+        return detail::add_mod(a, b, modulus_);
+    }
+    constexpr std::uint64_t sub(std::uint64_t a, std::uint64_t b) const {
+        return detail::sub_mod(a, b, modulus_);
+    }
+
+    constexpr std::uint64_t mul(std::uint64_t a, std::uint64_t b) const {
+#ifdef __SIZEOF_INT128__
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) % modulus_);
+#else
+        // Double-and-add keeps every intermediate below 2m
+        std::uint64_t result = 0;
+        for (; b > 0; b >>= 1) {
+            if (b & 1) result = detail::add_mod(result, a, modulus_);
+            a = detail::add_mod(a, a, modulus_);
+        }
+        return result;
+#endif
+    }
+};
+
+namespace detail {
+
+/// Engine chosen for a compile-time modulus: Montgomery when odd, else Barrett
+/// below 2³², else 128-bit division
+template<typename U, U Modulus>
+using modular_engine_t = std::conditional_t<
+    Modulus % 2 == 1,
+    montgomery_reducer<U>,
+    std::conditional_t<(static_cast<std::uint64_t>(Modulus) <= 0xFFFFFFFFu),
+                       barrett_reducer, wide_reducer>>;
+
+/**
+ * Engine chosen at runtime for modular_dynamic
+ *
+ * Holds both kinds of constants; the single branch on the kind is perfectly
+ * predictable because it never changes for a given modulus.
+ */
+template<typename U>
+class runtime_reducer {
+private:
+    montgomery_reducer<U> montgomery_;
+    wide_reducer plain_;
+    barrett_reducer barrett_;
+    enum class kind : unsigned char { montgomery, barrett, wide } kind_;
+
+public:
+    explicit constexpr runtime_reducer(U modulus)
+        : montgomery_(), plain_(), barrett_(), kind_(kind::wide) {
+        if (modulus == 0) {
+            throw std::invalid_argument("Modulus must be positive");
+        }
+        if (modulus % 2 == 1) {
+            montgomery_ = montgomery_reducer<U>(modulus);
+            kind_ = kind::montgomery;
+        } else if (static_cast<std::uint64_t>(modulus) <= 0xFFFFFFFFu) {
+            barrett_ = barrett_reducer(modulus);
+            kind_ = kind::barrett;
+        } else {
+            plain_ = wide_reducer(modulus);
+        }
+    }
+
+    constexpr U modulus() const {
+        switch (kind_) {
+            case kind::montgomery: return montgomery_.modulus();
+            case kind::barrett: return static_cast<U>(barrett_.modulus());
+            default: return static_cast<U>(plain_.modulus());
+        }
+    }
+
+    constexpr bool is_odd() const { return kind_ == kind::montgomery; }
+
+    constexpr U to_form(U x) const {
+        return kind_ == kind::montgomery ? montgomery_.to_form(x) : x;
+    }
+    constexpr U from_form(U a) const {
+        return kind_ == kind::montgomery ? montgomery_.from_form(a) : a;
+    }
+    constexpr U one() const {
+        return kind_ == kind::montgomery ? montgomery_.one() : static_cast<U>(1 % modulus());
+    }
+    constexpr U add(U a, U b) const { return add_mod(a, b, modulus()); }
+    constexpr U sub(U a, U b) const { return sub_mod(a, b, modulus()); }
+
+    constexpr U mul(U a, U b) const {
+        switch (kind_) {
+            case kind::montgomery: return montgomery_.mul(a, b);
+            case kind::barrett: return static_cast<U>(barrett_.mul(a, b));
+            default: return static_cast<U>(plain_.mul(a, b));
+        }
+    }
+};
+
+/**
+ * a⁻¹ mod m for canonical a, or 0 when gcd(a, m) ≠ 1
+ *
+ * Odd m: binary extended GCD (shifts and subtractions only). Even m:
+ * iterative Euclid with coefficients kept mod m through mul_mod.
+ */
+template<typename U, typename MulMod>
+constexpr U mod_inverse(U a, U m, MulMod mul_mod) {
+    if (m == 1) return 0;
+    if (a == 0) return 0;
+    if (m % 2 == 1) {
+        // Invariants: x1·a ≡ u, x2·a ≡ v (mod m)
+        U u = a, v = m, x1 = 1, x2 = 0;
+        auto halve = [m](U x) -> U {
+            return (x % 2 == 0) ? static_cast<U>(x >> 1)
+                                : static_cast<U>((x >> 1) + (m >> 1) + 1);
+        };
+        while (u != 1 && v != 1) {
+            while (u % 2 == 0) { u >>= 1; x1 = halve(x1); }
+            while (v % 2 == 0) { v >>= 1; x2 = halve(x2); }
+            if (u == v) return 0;  // common factor u > 1
+            if (u > v) {
+                u -= v;
+                x1 = sub_mod(x1, x2, m);
+            } else {
+                v -= u;
+                x2 = sub_mod(x2, x1, m);
+            }
+        }
+        return u == 1 ? x1 : x2;
+    }
+    // Invariants: s0·a ≡ r0, s1·a ≡ r1 (mod m)
+    U r0 = a, r1 = m, s0 = 1, s1 = 0;
+    while (r1 != 0) {
+        U q = r0 / r1;
+        U r2 = r0 - q * r1;
+        U s2 = sub_mod(s0, mul_mod(static_cast<U>(q % m), s1), m);
+        r0 = r1; r1 = r2;
+        s0 = s1; s1 = s2;
+    }
+    return r0 == 1 ? s0 : 0;
+}
+
+} // namespace detail
+
+} // namespace cbt
@@ -7,6 +7,10 @@
  * Trade-off:
  *   Gain: Handle 200+ orders of magnitude without overflow
  *   Loss: Some precision loss at scale boundaries
+ *
+ * Normalization is O(1): the binary exponent (ilogb) estimates the scale
+ * level, one multiply by a precomputed power SCALEᵏ applies it, and a single
+ * select corrects the estimate. No runtime std::pow, no per-level loop.
  * 
  * Applications:
  *   - Physics simulations (quantum to cosmic scales)
@@ -16,56 +20,168 @@
  */
 
 #pragma once
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include "instrumentation.hpp"
 
 namespace cbt {
 
+namespace detail {
+
+/**
+ * Constexpr table of SCALEᵏ = 10^(SCALE_FACTOR·k) for |k| ≤ max_index
+ *
+ * max_index is the largest k whose power and reciprocal are normal in T.
+ * Entries are accumulated in long double and rounded once, so each is
+ * within an ulp of the true power.
+ */
+template<typename T, int SCALE_FACTOR>
+struct multiscale_powers {
+    static_assert(SCALE_FACTOR <= std::numeric_limits<T>::max_exponent10,
+                  "SCALE_FACTOR exceeds the range of T");
+
+    static constexpr int max_index =
+        (std::numeric_limits<T>::max_exponent10 < -std::numeric_limits<T>::min_exponent10
+             ? std::numeric_limits<T>::max_exponent10
+             : -std::numeric_limits<T>::min_exponent10) / SCALE_FACTOR;
+
+    static constexpr std::array<T, 2 * max_index + 1> make_table() {
+        std::array<T, 2 * max_index + 1> table{};
+        long double step = 1;
+        for (int i = 0; i < SCALE_FACTOR; ++i) step *= 10;
+        long double power = 1;
+        for (int k = 0; k <= max_index; ++k) {
+            table[max_index + k] = static_cast<T>(power);
+            table[max_index - k] = static_cast<T>(1 / power);
+            power *= step;
+        }
+        return table;
+    }
+
+    static constexpr std::array<T, 2 * max_index + 1> table = make_table();
+    static constexpr T scale = table[max_index + 1];
+    static constexpr T inv_scale = table[max_index - 1];
+
+    /// @brief SCALEⁿ for |n| ≤ max_index
+    static constexpr T power(int n) { return table[max_index + n]; }
+
+    /// @brief m·SCALEⁿ for any n, in as few table multiplies as possible
+    static T scale_by(T m, int n) {
+        while (n > max_index) { m *= power(max_index); n -= max_index; }
+        while (n < -max_index) { m *= power(-max_index); n += max_index; }
+        return m * power(n);
+    }
+
+    /// @brief m·SCALEⁿ for n ≤ 0 with two lookups and no loop
+    /// @details Exact down to n = -2·max_index; below that the result is
+    /// far under the smallest normal anyway
+    static T scale_down(T m, int n) {
+        int first = n < -max_index ? -max_index : n;
+        int rest = n - first;
+        rest = rest < -max_index ? -max_index : rest;
+        return m * power(first) * power(rest);
+    }
+};
+
+/**
+ * Bring mantissa into [1/SCALE, 1) in magnitude, adjusting scale
+ *
+ * The binary exponent e gives ⌊log₁₀|m|⌋ ∈ {L, L+1} with L = ⌊e·log₁₀2⌋,
+ * so the level estimate is exact or one short; one select fixes it. Scales
+ * saturate at the int8_t bounds, leaving the mantissa unnormalized there.
+ */
+template<typename T, int SCALE_FACTOR>
+void multiscale_normalize(T& mantissa, int& scale) {
+    using powers = multiscale_powers<T, SCALE_FACTOR>;
+    instrumentation::count(instrumentation::counter::multiscale_normalizations);
+    if (mantissa == 0) {
+        scale = 0;
+        return;
+    }
+    if (!std::isfinite(mantissa)) {
+        if (std::isinf(mantissa)) {
+            scale = 127;
+            instrumentation::count(instrumentation::counter::multiscale_saturations);
+        }
+        return;
+    }
+    constexpr T log10_2 = T(0.301029995663981195213738894724493027L);
+    const int e = std::ilogb(mantissa);
+    const int decimal = static_cast<int>(std::floor(e * log10_2));
+    // Floor division by SCALE_FACTOR, valid for negative decimal too
+    int k = (decimal >= 0 ? decimal / SCALE_FACTOR
+                          : -((-decimal + SCALE_FACTOR - 1) / SCALE_FACTOR)) + 1;
+    T m = powers::scale_by(mantissa, -k);
+    const T magnitude = std::abs(m);
+    if (magnitude >= 1) {
+        m *= powers::inv_scale;
+        ++k;
+        instrumentation::count(instrumentation::counter::multiscale_normalize_steps);
+    } else if (magnitude < powers::inv_scale) {
+        m *= powers::scale;
+        --k;
+        instrumentation::count(instrumentation::counter::multiscale_normalize_steps);
+    }
+    const int target = scale + k;
+    if (target > 127 || target < -128) {
+        instrumentation::count(instrumentation::counter::multiscale_saturations);
+        const int clamped = target > 127 ? 127 : -128;
+        m = powers::scale_by(mantissa, -(clamped - scale));
+        scale = clamped;
+    } else {
+        scale = target;
+    }
+    mantissa = m;
+}
+
+} // namespace detail
+
 template<typename T, int SCALE_FACTOR = 3>
 class multiscale {
     static_assert(std::is_floating_point_v<T>, "multiscale requires floating-point type");
     static_assert(SCALE_FACTOR > 0, "SCALE_FACTOR must be positive");
     
 private:
+    using powers = detail::multiscale_powers<T, SCALE_FACTOR>;
+    
     T mantissa_;
     int8_t scale_level_;
     
-    static constexpr T SCALE = std::pow(10, SCALE_FACTOR);
-    static constexpr T INV_SCALE = 1.0 / SCALE;
+    static constexpr T SCALE = powers::scale;
+    static constexpr T INV_SCALE = powers::inv_scale;
     
-    void normalize() {
-        if (mantissa_ == 0) {
-            scale_level_ = 0;
-            return;
-        }
-        
-        while (std::abs(mantissa_) >= 1 && scale_level_ < 127) {
-            mantissa_ *= INV_SCALE;
-            scale_level_++;
-        }
-        
-        while (std::abs(mantissa_) < INV_SCALE && scale_level_ > -128) {
-            mantissa_ *= SCALE;
-            scale_level_--;
-        }
+    /// Normalize from a wide scale, so sums of levels cannot wrap int8_t
+    static multiscale make(T mantissa, int scale) {
+        detail::multiscale_normalize<T, SCALE_FACTOR>(mantissa, scale);
+        multiscale result;
+        result.mantissa_ = mantissa;
+        result.scale_level_ = static_cast<int8_t>(scale);
+        return result;
     }
     
 public:
     // Constructors
     multiscale() : mantissa_(0), scale_level_(0) {}
     
-    explicit multiscale(T value) : mantissa_(value), scale_level_(0) {
-        normalize();
-    }
+    explicit multiscale(T value) : multiscale(make(value, 0)) {}
+    
+    multiscale(T mantissa, int8_t scale) : multiscale(make(mantissa, scale)) {}
     
-    multiscale(T mantissa, int8_t scale) : mantissa_(mantissa), scale_level_(scale) {
-        normalize();
+    /// @brief Build from parts that are already normalized (no checks)
+    static multiscale from_normalized(T mantissa, int8_t scale) {
+        multiscale result;
+        result.mantissa_ = mantissa;
+        result.scale_level_ = scale;
+        return result;
     }
     
     // Conversion
     T to_value() const {
-        return mantissa_ * std::pow(SCALE, scale_level_);
+        return powers::scale_by(mantissa_, scale_level_);
     }
     
     // Getters
@@ -74,33 +190,36 @@ public:
     
     // Arithmetic
     multiscale operator+(const multiscale& other) const {
+        instrumentation::count(instrumentation::counter::multiscale_ops);
         if (mantissa_ == 0) return other;
         if (other.mantissa_ == 0) return *this;
         
-        int8_t scale_diff = scale_level_ - other.scale_level_;
+        int scale_diff = scale_level_ - other.scale_level_;
         
         if (scale_diff == 0) {
-            return multiscale(mantissa_ + other.mantissa_, scale_level_);
+            return make(mantissa_ + other.mantissa_, scale_level_);
         } else if (scale_diff > 0) {
-            T scaled_other = other.mantissa_ * std::pow(INV_SCALE, scale_diff);
-            return multiscale(mantissa_ + scaled_other, scale_level_);
+            T scaled_other = powers::scale_by(other.mantissa_, -scale_diff);
+            return make(mantissa_ + scaled_other, scale_level_);
         } else {
-            T scaled_this = mantissa_ * std::pow(INV_SCALE, -scale_diff);
-            return multiscale(scaled_this + other.mantissa_, other.scale_level_);
+            T scaled_this = powers::scale_by(mantissa_, scale_diff);
+            return make(scaled_this + other.mantissa_, other.scale_level_);
         }
     }
     
     multiscale operator*(const multiscale& other) const {
-        return multiscale(mantissa_ * other.mantissa_, 
-                         scale_level_ + other.scale_level_);
+        instrumentation::count(instrumentation::counter::multiscale_ops);
+        return make(mantissa_ * other.mantissa_,
+                    scale_level_ + other.scale_level_);
     }
     
     multiscale operator/(const multiscale& other) const {
+        instrumentation::count(instrumentation::counter::multiscale_ops);
         if (other.mantissa_ == 0) {
             throw std::runtime_error("Division by zero");
         }
-        return multiscale(mantissa_ / other.mantissa_,
-                         scale_level_ - other.scale_level_);
+        return make(mantissa_ / other.mantissa_,
+                    scale_level_ - other.scale_level_);
     }
     
     // Comparison
@@ -122,4 +241,4 @@ public:
     }
 };
 
-} // namespace cbt
\ No newline at end of file
+} // namespace cbt
@@ -0,0 +1,192 @@
+/**
+ * Multiscale Array - Structure-of-Arrays Storage for Multiscale Values
+ *
+ * Layout: mantissas and int8_t scale levels in two separate contiguous
+ * arrays, so batched kernels stream each with unit stride and the scales
+ * cost one byte per element.
+ *
+ * Trade-off:
+ *   Gain: Products need at most one renormalization step, done with
+ *         selects instead of branches; sums align every mantissa to the
+ *         largest scale with one table multiply and accumulate in lanes
+ *   Loss: Single-element access assembles a multiscale from two arrays
+ *
+ * Applications:
+ *   - Accumulating very many values spanning extreme ranges
+ *   - Physics kernels (particle weights, cross sections)
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "logarithmic.hpp"
+#include "multiscale.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+template<typename T, int SCALE_FACTOR = 3>
+class multiscale_array {
+    static_assert(std::is_floating_point_v<T>, "multiscale_array requires floating-point type");
+
+public:
+    using value_type = multiscale<T, SCALE_FACTOR>;
+
+private:
+    using powers = detail::multiscale_powers<T, SCALE_FACTOR>;
+
+    std::vector<T> mantissas_;
+    std::vector<std::int8_t> scales_;
+
+    void check_size(const multiscale_array& other) const {
+        if (size() != other.size()) {
+            throw std::invalid_argument("multiscale_array sizes must match");
+        }
+    }
+
+    static int clamp_scale(int s) { return s > 127 ? 127 : (s < -128 ? -128 : s); }
+
+public:
+    // Constructors
+    multiscale_array() = default;
+
+    /// @brief n zeros
+    explicit multiscale_array(std::size_t n) : mantissas_(n, T(0)), scales_(n, 0) {}
+
+    /// @brief Batched forward transform
+    static multiscale_array from_values(span<const T> values) {
+        multiscale_array result(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            T m = values[i];
+            int s = 0;
+            detail::multiscale_normalize<T, SCALE_FACTOR>(m, s);
+            result.mantissas_[i] = m;
+            result.scales_[i] = static_cast<std::int8_t>(s);
+        }
+        return result;
+    }
+
+    static multiscale_array from_values(const std::vector<T>& values) {
+        return from_values(span<const T>(values));
+    }
+
+    /// @brief Adopt already-normalized parts (e.g. a mapped file) as is
+    static multiscale_array from_normalized(span<const T> mantissas, span<const std::int8_t> scales) {
+        if (mantissas.size() != scales.size()) {
+            throw std::invalid_argument("multiscale_array needs one scale per mantissa");
+        }
+        multiscale_array result;
+        result.mantissas_.assign(mantissas.begin(), mantissas.end());
+        result.scales_.assign(scales.begin(), scales.end());
+        return result;
+    }
+
+    /// @brief Batched inverse transform
+    /// @warning Elements may overflow or underflow in the real domain
+    std::vector<T> to_values() const {
+        std::vector<T> values(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            values[i] = powers::scale_by(mantissas_[i], scales_[i]);
+        }
+        return values;
+    }
+
+    // Element access
+    std::size_t size() const { return mantissas_.size(); }
+    bool empty() const { return mantissas_.empty(); }
+
+    value_type get(std::size_t i) const {
+        return value_type::from_normalized(mantissas_[i], scales_[i]);
+    }
+
+    void set(std::size_t i, const value_type& value) {
+        mantissas_[i] = value.mantissa();
+        scales_[i] = value.scale_level();
+    }
+
+    span<const T> mantissas() const { return span<const T>(mantissas_); }
+    span<const std::int8_t> scales() const { return span<const std::int8_t>(scales_); }
+
+    // Batched arithmetic
+    /// @brief Elementwise product
+    /// @details |mᵃ·mᵇ| ∈ [1/SCALE², 1), so one select renormalizes; only
+    /// scale saturation falls back to the general path
+    multiscale_array operator*(const multiscale_array& other) const {
+        check_size(other);
+        multiscale_array result(size());
+        const T* a = mantissas_.data();
+        const T* b = other.mantissas_.data();
+        const std::int8_t* sa = scales_.data();
+        const std::int8_t* sb = other.scales_.data();
+        T* out = result.mantissas_.data();
+        std::int8_t* out_s = result.scales_.data();
+        for (std::size_t i = 0; i < size(); ++i) {
+            T p = a[i] * b[i];
+            int s = sa[i] + sb[i];
+            bool shift = std::abs(p) < powers::inv_scale;
+            p = shift ? p * powers::scale : p;
+            s = shift ? s - 1 : s;
+            s = p == 0 ? 0 : s;
+            if (s != clamp_scale(s)) {
+                p = a[i] * b[i];
+                s = sa[i] + sb[i];
+                detail::multiscale_normalize<T, SCALE_FACTOR>(p, s);
+            }
+            out[i] = p;
+            out_s[i] = static_cast<std::int8_t>(s);
+        }
+        return result;
+    }
+
+    /// @brief Elementwise sum, aligned to the larger scale of each pair
+    multiscale_array operator+(const multiscale_array& other) const {
+        check_size(other);
+        multiscale_array result(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            T ma = mantissas_[i], mb = other.mantissas_[i];
+            int sa = ma == 0 ? other.scales_[i] : scales_[i];
+            int sb = mb == 0 ? sa : other.scales_[i];
+            int s = std::max(sa, sb);
+            T m = powers::scale_down(ma, sa - s) + powers::scale_down(mb, sb - s);
+            detail::multiscale_normalize<T, SCALE_FACTOR>(m, s);
+            result.mantissas_[i] = m;
+            result.scales_[i] = static_cast<std::int8_t>(s);
+        }
+        return result;
+    }
+
+    /// @brief Σ of all elements
+    /// @details Two passes: the maximum scale S, then Σ mᵢ·SCALE^(sᵢ-S) in
+    /// independent lanes. Every term is below 1 in magnitude, so the
+    /// accumulator cannot overflow; terms more than 2·max_index levels
+    /// below S underflow to zero, as they would in the scalar sum.
+    value_type sum() const {
+        if (empty()) return value_type();
+        int top = -128;
+        for (std::size_t i = 0; i < size(); ++i) {
+            int s = mantissas_[i] == 0 ? -128 : scales_[i];
+            top = std::max(top, s);
+        }
+        T lanes[detail::lg_lanes] = {};
+        const std::size_t n = size();
+        std::size_t i = 0;
+        const T* m = mantissas_.data();
+        const std::int8_t* s = scales_.data();
+        // Zeros keep scale 0, which may exceed top; their shift is irrelevant
+        auto term = [m, s, top](std::size_t k) {
+            return powers::scale_down(m[k], m[k] == 0 ? 0 : s[k] - top);
+        };
+        for (; i + detail::lg_lanes <= n; i += detail::lg_lanes) {
+            for (std::size_t l = 0; l < detail::lg_lanes; ++l) lanes[l] += term(i + l);
+        }
+        for (; i < n; ++i) lanes[0] += term(i);
+        T total = 0;
+        for (std::size_t l = 0; l < detail::lg_lanes; ++l) total += lanes[l];
+        return value_type(total, static_cast<std::int8_t>(top));
+    }
+};
+
+} // namespace cbt
@@ -0,0 +1,364 @@
+/**
+ * Number-Theoretic Transform - Convolution in the Evaluation Domain
+ *
+ * Transform: coefficient vector → values at the n-th roots of unity mod p
+ * Convolution becomes pointwise multiplication, like the FFT but exact
+ *
+ * Trade-off:
+ *   Gain: Polynomial products in O(n log n) instead of O(n²), with no
+ *         rounding error; every butterfly is a Montgomery multiply plus
+ *         branch-free add/sub on the value stored in modular<T, P>
+ *   Loss: Requires an NTT-friendly prime (2ᵏ | p - 1 for n ≤ 2ᵏ);
+ *         exact integer products need several primes recombined by CRT
+ *
+ * Layout: twiddles are stored per stage (stage with half-length h occupies
+ * [h, 2h)), so every butterfly loop streams contiguous memory. Stages whose
+ * blocks fit in ntt_cache_block elements run chunk by chunk, so the early
+ * stages of a large transform stay in cache.
+ *
+ * Applications:
+ *   - Polynomial multiplication over finite fields
+ *   - Exact big-integer and integer-sequence convolution (multi-prime)
+ *   - Hashing and coding theory
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "modular.hpp"
+#include "residue_number_system.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+namespace detail {
+
+/// Elements per cache-resident chunk for the early butterfly stages
+constexpr std::size_t ntt_cache_block = std::size_t(1) << 12;
+
+/// Inputs this short are multiplied by the schoolbook loop instead
+constexpr std::size_t ntt_schoolbook_threshold = 32;
+
+/// Largest k with 2ᵏ | x
+constexpr unsigned two_adicity(std::uint64_t x) {
+    unsigned k = 0;
+    while (x != 0 && x % 2 == 0) {
+        x /= 2;
+        ++k;
+    }
+    return k;
+}
+
+template<typename T, T P>
+constexpr modular<T, P> ntt_primitive_root() {
+    using value_type = modular<T, P>;
+    const std::uint64_t order = static_cast<std::uint64_t>(P) - 1;
+    std::uint64_t factors[16] = {};   // a 64-bit integer has at most 15 distinct prime factors
+    std::size_t count = 0;
+    std::uint64_t rest = order;
+    for (std::uint64_t q = 2; q * q <= rest; ++q) {
+        if (rest % q != 0) continue;
+        factors[count++] = q;
+        while (rest % q == 0) rest /= q;
+    }
+    if (rest > 1) factors[count++] = rest;
+    for (std::uint64_t g = 2; g < static_cast<std::uint64_t>(P); ++g) {
+        bool generator = true;
+        for (std::size_t f = 0; f < count; ++f) {
+            if (value_type(static_cast<T>(g)).pow(static_cast<T>(order / factors[f])) == value_type(1)) {
+                generator = false;
+                break;
+            }
+        }
+        if (generator) return value_type(static_cast<T>(g));
+    }
+    throw std::invalid_argument("NTT modulus must be prime");
+}
+
+/// Principal 2ᵏ-th roots of unity and their inverses for every supported
+/// k, computed at compile time: plans fill their twiddles without pow()
+template<typename T, T P>
+struct ntt_roots {
+    using value_type = modular<T, P>;
+
+    static constexpr unsigned max_log_size =
+        std::min<unsigned>(two_adicity(static_cast<std::uint64_t>(P) - 1), sizeof(std::size_t) * 8 - 2);
+
+    struct table {
+        std::array<value_type, max_log_size + 1> roots;      ///< roots[k] = ω_{2ᵏ}
+        std::array<value_type, max_log_size + 1> inverses;
+    };
+
+    static constexpr table make() {
+        table result{};
+        value_type w = ntt_primitive_root<T, P>().pow(
+            static_cast<T>((static_cast<std::uint64_t>(P) - 1) >> max_log_size));
+        value_type wi = w.inverse();
+        for (unsigned k = max_log_size + 1; k-- > 0;) {
+            result.roots[k] = w;
+            result.inverses[k] = wi;
+            w = w * w;
+            wi = wi * wi;
+        }
+        return result;
+    }
+
+    static constexpr table ladder = make();
+};
+
+} // namespace detail
+
+/**
+ * @brief Precomputed transform of one power-of-two size over ℤ/pℤ
+ * @tparam T Integral type of modular<T, P>
+ * @tparam P Prime with 2ᵏ | P - 1 (e.g. 998244353, 2⁶⁴ - 2³² + 1)
+ */
+template<typename T, T P>
+class ntt_plan {
+public:
+    using value_type = modular<T, P>;
+
+private:
+    std::size_t size_;
+    std::vector<value_type> roots_;          ///< roots_[h + j] = ω_{2h}^j
+    std::vector<value_type> inverse_roots_;
+    value_type size_inverse_;
+
+    static void bit_reverse(span<value_type> a) {
+        const std::size_t n = a.size();
+        for (std::size_t i = 1, j = 0; i < n; ++i) {
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(a[i], a[j]);
+        }
+    }
+
+    /// One radix-2 stage of half-length h over [begin, end)
+    static void butterflies(value_type* a, std::size_t begin, std::size_t end,
+                            std::size_t h, const value_type* w) {
+        for (std::size_t start = begin; start < end; start += 2 * h) {
+            value_type* lo = a + start;
+            value_type* hi = lo + h;
+            for (std::size_t j = 0; j < h; ++j) {
+                value_type u = lo[j];
+                value_type v = hi[j] * w[j];
+                lo[j] = u + v;
+                hi[j] = u - v;
+            }
+        }
+    }
+
+    void transform(span<value_type> a, const std::vector<value_type>& roots) const {
+        if (a.size() != size_) {
+            throw std::invalid_argument("NTT input size must match the plan");
+        }
+        bit_reverse(a);
+        value_type* data = a.data();
+        const std::size_t block = std::min(size_, detail::ntt_cache_block);
+        // Early stages: finish every stage inside one chunk before moving on
+        for (std::size_t chunk = 0; chunk < size_; chunk += block) {
+            for (std::size_t h = 1; 2 * h <= block; h *= 2) {
+                butterflies(data, chunk, chunk + block, h, roots.data() + h);
+            }
+        }
+        // Late stages span several chunks
+        for (std::size_t h = block; h < size_; h *= 2) {
+            butterflies(data, 0, size_, h, roots.data() + h);
+        }
+    }
+
+public:
+    /// @brief Smallest generator of (ℤ/Pℤ)*, by trial division of P - 1
+    /// @details Cheap for NTT-friendly primes, whose P - 1 is 2ᵏ times a
+    /// small odd cofactor
+    static constexpr value_type primitive_root() { return detail::ntt_primitive_root<T, P>(); }
+
+    /// @brief Largest supported transform size, 2ᵏ with 2ᵏ | P - 1
+    static constexpr std::size_t max_size() { return std::size_t(1) << detail::ntt_roots<T, P>::max_log_size; }
+
+    /// @param n Power of two not exceeding max_size()
+    explicit ntt_plan(std::size_t n) : size_(n) {
+        if (n == 0 || (n & (n - 1)) != 0) {
+            throw std::invalid_argument("NTT size must be a power of two");
+        }
+        if (n > max_size()) {
+            throw std::invalid_argument("NTT size exceeds 2-adicity of the modulus");
+        }
+        roots_.assign(std::max<std::size_t>(n, 2), value_type(1));
+        inverse_roots_.assign(std::max<std::size_t>(n, 2), value_type(1));
+        // Stage h needs powers of ω_{2h}, read from the compile-time ladder
+        for (std::size_t h = 1, k = 1; h < n; h *= 2, ++k) {
+            value_type step = detail::ntt_roots<T, P>::ladder.roots[k];
+            value_type step_inverse = detail::ntt_roots<T, P>::ladder.inverses[k];
+            value_type w(1), wi(1);
+            for (std::size_t j = 0; j < h; ++j) {
+                roots_[h + j] = w;
+                inverse_roots_[h + j] = wi;
+                w = w * step;
+                wi = wi * step_inverse;
+            }
+        }
+        size_inverse_ = value_type(static_cast<T>(n % static_cast<std::uint64_t>(P))).inverse();
+    }
+
+    std::size_t size() const { return size_; }
+
+    /// @brief In place, natural order in and out
+    void forward(span<value_type> a) const { transform(a, roots_); }
+
+    /// @brief In place inverse, including the 1/n scaling
+    void inverse(span<value_type> a) const {
+        transform(a, inverse_roots_);
+        for (std::size_t i = 0; i < a.size(); ++i) a[i] = a[i] * size_inverse_;
+    }
+
+    void forward(std::vector<value_type>& a) const { forward(span<value_type>(a)); }
+    void inverse(std::vector<value_type>& a) const { inverse(span<value_type>(a)); }
+};
+
+/// @brief Polynomial product over ℤ/Pℤ; size a.size() + b.size() - 1
+template<typename T, T P>
+std::vector<modular<T, P>> ntt_convolve(span<const modular<T, P>> a, span<const modular<T, P>> b) {
+    using value_type = modular<T, P>;
+    if (a.empty() || b.empty()) return {};
+    const std::size_t result_size = a.size() + b.size() - 1;
+    if (std::min(a.size(), b.size()) <= detail::ntt_schoolbook_threshold) {
+        std::vector<value_type> result(result_size);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            for (std::size_t j = 0; j < b.size(); ++j) {
+                result[i + j] = result[i + j] + a[i] * b[j];
+            }
+        }
+        return result;
+    }
+    std::size_t n = 1;
+    while (n < result_size) n *= 2;
+    ntt_plan<T, P> plan(n);
+
+    std::vector<value_type> fa(n), fb(n);
+    std::copy(a.begin(), a.end(), fa.begin());
+    std::copy(b.begin(), b.end(), fb.begin());
+    plan.forward(fa);
+    plan.forward(fb);
+    for (std::size_t i = 0; i < n; ++i) fa[i] = fa[i] * fb[i];
+    plan.inverse(fa);
+    fa.resize(result_size);
+    return fa;
+}
+
+template<typename T, T P>
+std::vector<modular<T, P>> ntt_convolve(const std::vector<modular<T, P>>& a,
+                                        const std::vector<modular<T, P>>& b) {
+    return ntt_convolve(span<const modular<T, P>>(a), span<const modular<T, P>>(b));
+}
+
+// Common NTT-friendly primes
+using ntt998 = ntt_plan<std::uint32_t, 998244353u>;                      // 119·2²³ + 1
+using ntt_goldilocks = ntt_plan<std::uint64_t, 0xFFFFFFFF00000001ull>;  // 2⁶⁴ - 2³² + 1
+
+#ifdef __SIZEOF_INT128__
+
+/**
+ * Multi-prime NTT: exact integer convolution
+ *
+ * Three 32-bit NTT primes give three independent convolutions; each output
+ * coefficient is then reconstructed through the shared RNS basis, whose
+ * dynamic range M = p₁p₂p₃ ≈ 2⁸⁶ bounds the exact result.
+ */
+using ntt_crt_moduli = rns_moduli<std::int64_t, 998244353, 167772161, 469762049>;
+using ntt_crt_rns = residue_number_system<std::int64_t, 3, ntt_crt_moduli>;
+
+namespace detail {
+
+template<std::uint32_t P>
+std::vector<std::uint32_t> ntt_convolve_channel(span<const std::uint64_t> a,
+                                                span<const std::uint64_t> b) {
+    using value_type = modular<std::uint32_t, P>;
+    std::vector<value_type> ra(a.size()), rb(b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) ra[i] = value_type(static_cast<std::uint32_t>(a[i] % P));
+    for (std::size_t i = 0; i < b.size(); ++i) rb[i] = value_type(static_cast<std::uint32_t>(b[i] % P));
+    std::vector<value_type> product = ntt_convolve(ra, rb);
+    std::vector<std::uint32_t> result(product.size());
+    for (std::size_t i = 0; i < product.size(); ++i) result[i] = product[i].value();
+    return result;
+}
+
+/// Residue triples of the convolution, ready for CRT or base extension
+inline std::vector<ntt_crt_rns> ntt_convolve_residues(span<const std::uint64_t> a,
+                                                      span<const std::uint64_t> b) {
+    auto c0 = ntt_convolve_channel<998244353>(a, b);
+    auto c1 = ntt_convolve_channel<167772161>(a, b);
+    auto c2 = ntt_convolve_channel<469762049>(a, b);
+    std::vector<ntt_crt_rns> result(c0.size());
+    for (std::size_t k = 0; k < c0.size(); ++k) {
+        result[k] = ntt_crt_rns::from_residues({c0[k], c1[k], c2[k]});
+    }
+    return result;
+}
+
+} // namespace detail
+
+/// @brief Exact Σ a[i]·b[k-i] over the integers
+/// @throws std::invalid_argument if a coefficient could reach M = p₁p₂p₃
+inline std::vector<ntt_crt_rns::range_type> ntt_convolve_exact(span<const std::uint64_t> a,
+                                                               span<const std::uint64_t> b) {
+    using range_type = ntt_crt_rns::range_type;
+    if (a.empty() || b.empty()) return {};
+    range_type max_a = *std::max_element(a.begin(), a.end());
+    range_type max_b = *std::max_element(b.begin(), b.end());
+    range_type terms = std::min(a.size(), b.size());
+    const range_type limit = ntt_crt_rns::dynamic_range() - 1;
+    if (max_a != 0 && max_b != 0 && (max_a > limit / max_b || max_a * max_b > limit / terms)) {
+        throw std::invalid_argument("Convolution exceeds the multi-prime NTT range");
+    }
+    auto residues = detail::ntt_convolve_residues(a, b);
+    std::vector<range_type> result(residues.size());
+    for (std::size_t k = 0; k < residues.size(); ++k) result[k] = residues[k].to_range_type();
+    return result;
+}
+
+inline std::vector<ntt_crt_rns::range_type> ntt_convolve_exact(const std::vector<std::uint64_t>& a,
+                                                               const std::vector<std::uint64_t>& b) {
+    return ntt_convolve_exact(span<const std::uint64_t>(a), span<const std::uint64_t>(b));
+}
+
+/// @brief Convolution modulo any m < 2³², NTT-friendly or not
+/// @details The exact coefficients are never formed: each residue triple is
+/// base-extended straight to m by mixed-radix conversion
+inline std::vector<std::uint32_t> ntt_convolve_mod(span<const std::uint32_t> a,
+                                                   span<const std::uint32_t> b,
+                                                   std::uint32_t modulus) {
+    using range_type = ntt_crt_rns::range_type;
+    if (modulus == 0) throw std::invalid_argument("Modulus must be positive");
+    if (a.empty() || b.empty()) return {};
+    range_type m1 = modulus - 1;
+    range_type terms = std::min(a.size(), b.size());
+    if (m1 != 0 && m1 * m1 > (ntt_crt_rns::dynamic_range() - 1) / terms) {
+        throw std::invalid_argument("Convolution exceeds the multi-prime NTT range");
+    }
+    std::vector<std::uint64_t> wa(a.size()), wb(b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) wa[i] = a[i] % modulus;
+    for (std::size_t i = 0; i < b.size(); ++i) wb[i] = b[i] % modulus;
+    auto residues = detail::ntt_convolve_residues(wa, wb);
+    std::vector<std::uint32_t> result(residues.size());
+    for (std::size_t k = 0; k < residues.size(); ++k) {
+        result[k] = static_cast<std::uint32_t>(residues[k].base_extend(modulus));
+    }
+    return result;
+}
+
+inline std::vector<std::uint32_t> ntt_convolve_mod(const std::vector<std::uint32_t>& a,
+                                                   const std::vector<std::uint32_t>& b,
+                                                   std::uint32_t modulus) {
+    return ntt_convolve_mod(span<const std::uint32_t>(a), span<const std::uint32_t>(b), modulus);
+}
+
+#endif // __SIZEOF_INT128__
+
+} // namespace cbt
@@ -33,6 +33,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include "cmath.hpp"
 
 namespace cbt {
 
@@ -96,7 +97,7 @@ public:
     /// @note Handles infinite odds (returns 1.0)
     /// @details Uses formula: p = odds/(1+odds)
     constexpr T to_probability() const {
-        if (std::isinf(odds_)) return 1;
+        if (cmath::isinf(odds_)) return 1;
         return odds_ / (1 + odds_);
     }
     
@@ -108,7 +109,7 @@ public:
     /// @return Natural logarithm of the odds
     /// @note Useful for numerical stability with extreme probabilities
     constexpr T to_log_odds() const {
-        return std::log(odds_);
+        return cmath::log(odds_);
     }
     
     /// @brief Bayesian update via multiplication
@@ -223,14 +224,14 @@ public:
     static constexpr log_odds from_probability(T prob) {
         if (prob <= 0) return log_odds(-std::numeric_limits<T>::infinity());
         if (prob >= 1) return log_odds(std::numeric_limits<T>::infinity());
-        return log_odds(std::log(prob / (1 - prob)));
+        return log_odds(cmath::log(prob / (1 - prob)));
     }
     
     /// @brief Factory method to create from odds
     /// @param odds Odds value (not in log space)
     /// @return log_odds instance
     static constexpr log_odds from_odds(T odds) {
-        return log_odds(std::log(odds));
+        return log_odds(cmath::log(odds));
     }
     
     /// @brief Convert to probability using sigmoid function
@@ -239,10 +240,10 @@ public:
     /// @warning May return 0 or 1 for extreme log-odds values
     constexpr T to_probability() const {
         if (log_odds_ > 0) {
-            T exp_neg = std::exp(-log_odds_);
+            T exp_neg = cmath::exp(-log_odds_);
             return 1 / (1 + exp_neg);
         } else {
-            T exp_val = std::exp(log_odds_);
+            T exp_val = cmath::exp(log_odds_);
             return exp_val / (1 + exp_val);
         }
     }
@@ -0,0 +1,374 @@
+/**
+ * Parallel Reduce and Scan - Deterministic Monoid Algorithms
+ *
+ * Transform: x₀ ⊕ x₁ ⊕ ... ⊕ xₙ₋₁ → fixed-shape tree of chunk folds
+ *
+ * The input is cut into chunks of `grain` elements. Each chunk is folded
+ * left to right as one task, and chunk results are combined by a fixed
+ * pairwise tree (the left half gets ⌊count/2⌋ chunks). The grouping
+ * depends only on n and grain, never on the thread count or which task ran
+ * where, so floating-point results are reproducible bit for bit across
+ * machines and runs. Operands are never reordered, so non-commutative
+ * monoids (quaternion products, tropical matrix products) are exact.
+ *
+ * parallel_inclusive_scan uses the same chunks: chunk totals in parallel,
+ * a sequential scan of the totals, then each chunk rescanned from its
+ * carry-in. Both run on thread_pool::shared() by default, or on any
+ * executor with bulk(count, f) that calls f(0) ... f(count - 1) and
+ * returns when all calls have finished.
+ *
+ * thread_pool is a small work-stealing pool: a bulk job starts as one
+ * index range that is split in halves, the owner keeping the nearest half
+ * (LIFO) and idle workers stealing the largest pending range (FIFO).
+ * Threads waiting on a job run other tasks meanwhile, so bulk jobs nest.
+ *
+ * Trade-off:
+ *   Gain: Reductions and prefix scans over any declared monoid scale with
+ *         cores and give the same answer for any thread count
+ *   Loss: A fixed tree is not the best-balanced schedule for every thread
+ *         count, the result differs in the last bits from a sequential left
+ *         fold, and the scan applies the operation about twice per element
+ *
+ * Applications:
+ *   - Products of many lg probabilities; tropical prefix scans for DP
+ *   - Prefix products of quaternion rotations (trajectories, kinematics)
+ *   - Reproducible parallel sums in tests and distributed pipelines
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "algebra.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+/// Elements per chunk unless the caller chooses; fixes the reduction tree
+constexpr std::size_t parallel_default_grain = 4096;
+
+/// @brief Runs bulk work on the calling thread, in index order
+struct inline_executor {
+    template<typename F>
+    void bulk(std::size_t count, F&& f) const {
+        for (std::size_t i = 0; i < count; ++i) f(i);
+    }
+};
+
+namespace detail {
+
+/// A bulk call in flight; lives on the caller's stack until pending is 0
+struct pool_job {
+    std::atomic<std::size_t> pending;
+    std::mutex error_lock;
+    std::exception_ptr error;
+
+    explicit pool_job(std::size_t count) : pending(count) {}
+    virtual ~pool_job() = default;
+    virtual void run(std::size_t index) = 0;
+};
+
+template<typename F>
+struct pool_job_of final : pool_job {
+    F& f;
+
+    pool_job_of(std::size_t count, F& fn) : pool_job(count), f(fn) {}
+    void run(std::size_t index) override { f(index); }
+};
+
+/// Indices [begin, end) of one job
+struct pool_task {
+    pool_job* job;
+    std::size_t begin, end;
+};
+
+/// One thread's task deque: the owner works at the back, thieves at the front
+struct alignas(64) pool_slot {
+    std::mutex lock;
+    std::deque<pool_task> tasks;
+};
+
+} // namespace detail
+
+/**
+ * @brief Work-stealing thread pool with fork-join bulk()
+ * @details Slot 0 belongs to threads outside the pool; each worker owns
+ * one more. A thread calling bulk() helps run tasks until its job is done.
+ */
+class thread_pool {
+    std::vector<std::unique_ptr<detail::pool_slot>> slots_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> queued_{0};     // tasks in all deques
+    std::atomic<std::size_t> sleeping_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex sleep_lock_;
+    std::condition_variable wake_;
+
+    struct worker_identity {
+        const thread_pool* pool = nullptr;
+        std::size_t slot = 0;
+    };
+
+    static worker_identity& identity() {
+        thread_local worker_identity id;
+        return id;
+    }
+
+    std::size_t caller_slot() const {
+        const worker_identity& id = identity();
+        return id.pool == this ? id.slot : 0;
+    }
+
+    void push(std::size_t slot, detail::pool_task task) {
+        {
+            std::lock_guard<std::mutex> guard(slots_[slot]->lock);
+            slots_[slot]->tasks.push_back(task);
+            queued_.fetch_add(1);
+        }
+        // Paired with the sleeper's increment before it rechecks queued_
+        if (sleeping_.load() != 0) {
+            std::lock_guard<std::mutex> guard(sleep_lock_);
+            wake_.notify_one();
+        }
+    }
+
+    bool take(std::size_t self, detail::pool_task& out) {
+        {
+            detail::pool_slot& own = *slots_[self];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.tasks.empty()) {
+                out = own.tasks.back();
+                own.tasks.pop_back();
+                queued_.fetch_sub(1);
+                return true;
+            }
+        }
+        // Idle: steal the oldest (largest) range of another slot
+        const std::size_t n = slots_.size();
+        for (std::size_t k = 1; k < n; ++k) {
+            detail::pool_slot& victim = *slots_[(self + k) % n];
+            std::unique_lock<std::mutex> guard(victim.lock, std::try_to_lock);
+            if (guard.owns_lock() && !victim.tasks.empty()) {
+                out = victim.tasks.front();
+                victim.tasks.pop_front();
+                queued_.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Split off upper halves for thieves, then run the first index
+    void execute(detail::pool_task task, std::size_t self) {
+        while (task.end - task.begin > 1) {
+            std::size_t mid = task.begin + (task.end - task.begin) / 2;
+            push(self, {task.job, mid, task.end});
+            task.end = mid;
+        }
+        detail::pool_job& job = *task.job;
+        try {
+            job.run(task.begin);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(job.error_lock);
+            if (!job.error) job.error = std::current_exception();
+        }
+        job.pending.fetch_sub(1, std::memory_order_acq_rel);   // job may be gone after this
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock_);
+            stopping_.store(true);
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) thread.join();
+    }
+
+    void work(std::size_t self) {
+        identity() = {this, self};
+        detail::pool_task task;
+        while (true) {
+            if (take(self, task)) {
+                execute(task, self);
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleep_lock_);
+            sleeping_.fetch_add(1);
+            wake_.wait(guard, [&] { return queued_.load() != 0 || stopping_.load(); });
+            sleeping_.fetch_sub(1);
+            if (stopping_.load() && queued_.load() == 0) return;
+        }
+    }
+
+public:
+    /// @param threads Concurrency including the calling thread; 0 uses
+    ///        std::thread::hardware_concurrency()
+    explicit thread_pool(unsigned threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 0; t < threads; ++t) slots_.push_back(std::make_unique<detail::pool_slot>());
+        threads_.reserve(threads - 1);
+        try {
+            for (unsigned t = 1; t < threads; ++t) threads_.emplace_back([this, t] { work(t); });
+        } catch (...) {
+            stop();   // the destructor does not run for a failed constructor
+            throw;
+        }
+    }
+
+    ~thread_pool() { stop(); }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /// Threads that run a bulk job, counting the caller
+    std::size_t concurrency() const { return slots_.size(); }
+
+    /// Process-wide pool sized to the hardware, created on first use
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Call f(i) for every i in [0, count), concurrently, and return
+     * when all calls have finished
+     * @details The first exception thrown by f is rethrown here once no call
+     * is still running; later indices may or may not have run.
+     */
+    template<typename F>
+    void bulk(std::size_t count, F&& f) {
+        if (count == 0) return;
+        if (count == 1 || threads_.empty()) {
+            for (std::size_t i = 0; i < count; ++i) f(i);
+            return;
+        }
+        detail::pool_job_of<std::remove_reference_t<F>> job(count, f);
+        const std::size_t self = caller_slot();
+        push(self, {&job, 0, count});
+        detail::pool_task task;
+        while (job.pending.load(std::memory_order_acquire) != 0) {
+            if (take(self, task)) {
+                execute(task, self);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        if (job.error) std::rethrow_exception(job.error);
+    }
+};
+
+namespace detail {
+
+template<typename T, typename Op>
+T fold_left(const T* values, std::size_t count, const Op& op) {
+    T accumulator = values[0];
+    for (std::size_t i = 1; i < count; ++i) accumulator = T(op(accumulator, values[i]));
+    return accumulator;
+}
+
+/// Fixed pairwise tree: ⌊count/2⌋ leaves on the left
+template<typename T, typename Op>
+T fold_tree(const T* values, std::size_t count, const Op& op) {
+    if (count == 1) return values[0];
+    const std::size_t half = count / 2;
+    return T(op(fold_tree(values, half, op), fold_tree(values + half, count - half, op)));
+}
+
+inline std::size_t parallel_chunks(std::size_t n, std::size_t grain) {
+    if (grain == 0) throw std::invalid_argument("parallel grain must be positive");
+    return (n + grain - 1) / grain;
+}
+
+} // namespace detail
+
+/**
+ * @brief Reduce values with the monoid (T, Op) in a fixed tree
+ * @param values Input; empty returns monoid_traits<T, Op>::identity()
+ * @param executor thread_pool::shared(), another thread_pool, inline_executor
+ *        or any type with bulk(count, f)
+ * @param grain Elements per chunk; the result depends on grain, not on
+ *        the executor
+ * @throws std::invalid_argument if grain is 0
+ */
+template<typename T, typename Op = std::plus<>, typename Executor = thread_pool&>
+T parallel_reduce(span<const T> values, Op op = Op{}, Executor&& executor = thread_pool::shared(),
+                  std::size_t grain = parallel_default_grain) {
+    using traits = monoid_traits<T, Op>;
+    static_assert(traits::is_monoid, "parallel_reduce requires a monoid_traits<T, Op> specialization");
+    static_assert(traits::associative, "parallel_reduce requires an associative operation");
+    const std::size_t n = values.size();
+    const std::size_t chunks = detail::parallel_chunks(n, grain);
+    if (n == 0) return traits::identity();
+    std::vector<T> partials(chunks, traits::identity());
+    executor.bulk(chunks, [&](std::size_t c) {
+        const std::size_t begin = c * grain;
+        partials[c] = detail::fold_left(values.data() + begin, std::min(grain, n - begin), op);
+    });
+    return detail::fold_tree(partials.data(), chunks, op);
+}
+
+template<typename T, typename Op = std::plus<>, typename Executor = thread_pool&>
+T parallel_reduce(const std::vector<T>& values, Op op = Op{}, Executor&& executor = thread_pool::shared(),
+                  std::size_t grain = parallel_default_grain) {
+    return parallel_reduce(span<const T>(values), op, std::forward<Executor>(executor), grain);
+}
+
+/**
+ * @brief out[i] = in[0] ⊕ ... ⊕ in[i], grouped by chunk of `grain`
+ * @details Within chunk c the prefix is ((carry_c ⊕ x_b) ⊕ x_b+1) ⊕ ...,
+ * where carry_c folds the chunk totals left to right. in and out may be
+ * the same storage.
+ * @throws std::invalid_argument if the sizes differ or grain is 0
+ */
+template<typename T, typename Op = std::plus<>, typename Executor = thread_pool&>
+void parallel_inclusive_scan(span<const T> in, span<T> out, Op op = Op{},
+                             Executor&& executor = thread_pool::shared(),
+                             std::size_t grain = parallel_default_grain) {
+    using traits = monoid_traits<T, Op>;
+    static_assert(traits::is_monoid, "parallel_inclusive_scan requires a monoid_traits<T, Op> specialization");
+    static_assert(traits::associative, "parallel_inclusive_scan requires an associative operation");
+    if (in.size() != out.size()) throw std::invalid_argument("parallel_inclusive_scan size mismatch");
+    const std::size_t n = in.size();
+    const std::size_t chunks = detail::parallel_chunks(n, grain);
+    if (n == 0) return;
+
+    // carries[c] = total of chunks [0, c); the last chunk's total is never needed
+    std::vector<T> carries(chunks, traits::identity());
+    if (chunks > 1) {
+        executor.bulk(chunks - 1, [&](std::size_t c) {
+            carries[c + 1] = detail::fold_left(in.data() + c * grain, grain, op);
+        });
+        for (std::size_t c = 2; c < chunks; ++c) carries[c] = T(op(carries[c - 1], carries[c]));
+    }
+
+    executor.bulk(chunks, [&](std::size_t c) {
+        const std::size_t begin = c * grain, end = std::min(n, begin + grain);
+        T accumulator = c == 0 ? in[begin] : T(op(carries[c], in[begin]));
+        out[begin] = accumulator;
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            accumulator = T(op(accumulator, in[i]));
+            out[i] = accumulator;
+        }
+    });
+}
+
+template<typename T, typename Op = std::plus<>, typename Executor = thread_pool&>
+std::vector<T> parallel_inclusive_scan(const std::vector<T>& values, Op op = Op{},
+                                       Executor&& executor = thread_pool::shared(),
+                                       std::size_t grain = parallel_default_grain) {
+    std::vector<T> result(values);
+    parallel_inclusive_scan(span<const T>(result), span<T>(result), op, std::forward<Executor>(executor), grain);
+    return result;
+}
+
+} // namespace cbt
@@ -1,13 +1,20 @@
 /**
  * Residue Number System (RNS) - Parallel Arithmetic Without Carries
- * 
+ *
  * Transform: n → (n mod p₁, n mod p₂, ..., n mod pₖ)
  * where p₁, p₂, ..., pₖ are coprime moduli
- * 
+ *
  * Trade-off:
  *   Gain: Fully parallel addition/multiplication, no carry propagation
  *   Loss: Comparison and division become complex operations
- * 
+ *         (O(N²) small-word ops via mixed-radix conversion, no wide CRT)
+ *
+ * Representation:
+ *   The moduli and every derived constant live in one immutable rns_basis,
+ *   shared by all values of a type; a value stores only its residues.
+ *   The basis is validated once (at compile time for template moduli) and
+ *   arithmetic never re-checks coprimality or recomputes CRT constants.
+ *
  * Applications:
  *   - Cryptography (RSA, ECC)
  *   - Digital signal processing
@@ -17,154 +24,476 @@
 
 #pragma once
 #include <array>
+#include <cstdint>
 #include <numeric>
 #include <iostream>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include "instrumentation.hpp"
+#include "modular_reduction.hpp"
 
 namespace cbt {
 
-template<typename T, size_t N>
-class residue_number_system {
+namespace detail {
+
+#ifdef __SIZEOF_INT128__
+using rns_range_t = unsigned __int128;
+#else
+using rns_range_t = std::uint64_t;
+#endif
+
+/// Inverse of a modulo m by the iterative extended Euclidean algorithm
+constexpr std::int64_t rns_mod_inverse(std::int64_t a, std::int64_t m) {
+    std::int64_t old_r = a, r = m;
+    std::int64_t old_s = 1, s = 0;
+    while (r != 0) {
+        std::int64_t q = old_r / r;
+        std::int64_t tmp = old_r - q * r;
+        old_r = r;
+        r = tmp;
+        tmp = old_s - q * s;
+        old_s = s;
+        s = tmp;
+    }
+    if (old_r != 1) throw std::runtime_error("Modular inverse does not exist");
+    return ((old_s % m) + m) % m;
+}
+
+/// First N pairwise-coprime integers ≥ 2 (the fallback default basis)
+template<typename T, std::size_t N>
+constexpr std::array<T, N> rns_default_moduli() {
+    if constexpr (N == 3) {
+        return {251, 253, 255};
+    } else if constexpr (N == 4) {
+        return {251, 253, 255, 256};
+    } else {
+        std::array<T, N> result{};
+        T current = 2;
+        for (std::size_t i = 0; i < N; ++i) {
+            result[i] = current++;
+            while (i > 0) {
+                bool coprime = true;
+                for (std::size_t j = 0; j < i; ++j) {
+                    if (std::gcd(current, result[j]) != 1) {
+                        coprime = false;
+                        break;
+                    }
+                }
+                if (coprime) break;
+                current++;
+            }
+        }
+        return result;
+    }
+}
+
+} // namespace detail
+
+/**
+ * Precomputed RNS basis
+ *
+ * Holds the moduli mᵢ (each in [2, 2³²)), the dynamic range M = Πmᵢ, the
+ * CRT constants Mᵢ = M/mᵢ and Mᵢ⁻¹ mod mᵢ, and one Barrett reducer per
+ * channel. Construction validates coprimality once (O(N²) gcd); every
+ * channel operation afterwards is division-free and branch-free apart from
+ * the conditional subtraction that compiles to a select.
+ *
+ * It also holds the pairwise inverses mᵢ⁻¹ mod mⱼ for mixed-radix
+ * conversion (MRC): x = a₀ + a₁m₀ + a₂m₀m₁ + ... with digits aᵢ < mᵢ.
+ * The digits order values lexicographically, which gives comparison, sign
+ * detection and base extension in residue space without reconstructing x.
+ */
+template<typename T, std::size_t N>
+class rns_basis {
     static_assert(std::is_integral_v<T>, "RNS requires integral type");
-    
+    static_assert(N > 0, "RNS requires at least one modulus");
+
+public:
+    using residue_type = T;
+    using range_type = detail::rns_range_t;
+
 private:
-    std::array<T, N> residues_;
     std::array<T, N> moduli_;
-    T dynamic_range_;
-    
-    // Extended Euclidean algorithm for modular inverse
-    static T extended_gcd(T a, T b, T& x, T& y) {
-        if (b == 0) {
-            x = 1;
-            y = 0;
-            return a;
-        }
-        T x1, y1;
-        T gcd = extended_gcd(b, a % b, x1, y1);
-        x = y1;
-        y = x1 - (a / b) * y1;
-        return gcd;
+    std::array<barrett_reducer, N> reducers_;
+    std::array<T, N> mi_inverse_;
+    std::array<range_type, N> mi_;
+    range_type dynamic_range_;
+    std::array<std::array<T, N>, N> inverses_;  ///< inverses_[i][j] = mᵢ⁻¹ mod mⱼ
+    std::array<T, N> half_digits_;              ///< MRC digits of ⌈M/2⌉
+
+    /// MRC over the channels listed in order[0..count): digits[t] < m_order[t]
+    constexpr void mixed_radix_subset(const std::array<T, N>& residues,
+                                      const std::array<std::size_t, N>& order,
+                                      std::size_t count,
+                                      std::array<T, N>& digits) const {
+        std::array<T, N> y = residues;
+        for (std::size_t t = 0; t < count; ++t) {
+            std::size_t i = order[t];
+            digits[t] = y[i];
+            for (std::size_t u = t + 1; u < count; ++u) {
+                std::size_t j = order[u];
+                T a = reduce(j, static_cast<std::uint64_t>(digits[t]));
+                y[j] = mul(j, sub(j, y[j], a), inverses_[i][j]);
+            }
+        }
     }
-    
-    static T mod_inverse(T a, T m) {
-        T x, y;
-        T g = extended_gcd(a, m, x, y);
-        if (g != 1) throw std::runtime_error("Modular inverse does not exist");
-        return (x % m + m) % m;
+
+    /// Σ digits[t]·Π_{u<t} m_order[u] reduced modulo an arbitrary reducer
+    template<typename Reducer>
+    static constexpr std::uint64_t evaluate_digits(const std::array<T, N>& digits,
+                                                   const std::array<std::size_t, N>& order,
+                                                   std::size_t count,
+                                                   const std::array<T, N>& moduli,
+                                                   const Reducer& target) {
+        std::uint64_t result = 0;
+        for (std::size_t t = count; t-- > 0;) {
+            // Horner: result = result·m_order[t] + digit
+            std::uint64_t m = target.reduce(static_cast<std::uint64_t>(moduli[order[t]]));
+            result = target.reduce(target.mul(result, m) +
+                                   target.reduce(static_cast<std::uint64_t>(digits[t])));
+        }
+        return result;
     }
-    
+
+    static constexpr std::array<std::size_t, N> identity_order() {
+        std::array<std::size_t, N> order{};
+        for (std::size_t i = 0; i < N; ++i) order[i] = i;
+        return order;
+    }
+
 public:
-    // Constructor
-    residue_number_system(const std::array<T, N>& moduli) : moduli_(moduli) {
-        // Verify moduli are coprime
-        for (size_t i = 0; i < N; ++i) {
-            for (size_t j = i + 1; j < N; ++j) {
+    explicit constexpr rns_basis(const std::array<T, N>& moduli)
+        : moduli_(moduli), reducers_{}, mi_inverse_{}, mi_{}, dynamic_range_(1),
+          inverses_{}, half_digits_{} {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (moduli_[i] < 2 || static_cast<std::uint64_t>(moduli_[i]) > 0xFFFFFFFFu) {
+                throw std::invalid_argument("Moduli must be in [2, 2^32)");
+            }
+            for (std::size_t j = i + 1; j < N; ++j) {
                 if (std::gcd(moduli_[i], moduli_[j]) != 1) {
                     throw std::invalid_argument("Moduli must be coprime");
                 }
             }
         }
-        
-        dynamic_range_ = 1;
-        for (T m : moduli_) {
+
+        for (std::size_t i = 0; i < N; ++i) {
+            auto m = static_cast<range_type>(moduli_[i]);
+            // Keep headroom for the 2M intermediate in reconstruct()
+            if (dynamic_range_ > (~range_type(0) >> 1) / m) {
+                throw std::invalid_argument("RNS dynamic range exceeds the wide integer type");
+            }
             dynamic_range_ *= m;
         }
-        
-        residues_.fill(0);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            auto m = static_cast<std::uint64_t>(moduli_[i]);
+            reducers_[i] = barrett_reducer(m);
+            mi_[i] = dynamic_range_ / m;
+            auto mi_mod = static_cast<std::int64_t>(mi_[i] % m);
+            mi_inverse_[i] = static_cast<T>(
+                detail::rns_mod_inverse(mi_mod, static_cast<std::int64_t>(m)));
+        }
+
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                if (i == j) continue;
+                auto mj = static_cast<std::int64_t>(moduli_[j]);
+                inverses_[i][j] = static_cast<T>(detail::rns_mod_inverse(
+                    static_cast<std::int64_t>(moduli_[i]) % mj, mj));
+            }
+        }
+
+        range_type half = dynamic_range_ - dynamic_range_ / 2;
+        std::array<T, N> half_residues{};
+        for (std::size_t i = 0; i < N; ++i) {
+            half_residues[i] = static_cast<T>(half % static_cast<range_type>(moduli_[i]));
+        }
+        half_digits_ = mixed_radix(half_residues);
     }
-    
-    // Default moduli for common use cases
-    static std::array<T, N> default_moduli() {
-        if constexpr (N == 3) {
-            return {251, 253, 255};
-        } else if constexpr (N == 4) {
-            return {251, 253, 255, 256};
-        } else {
-            std::array<T, N> result;
-            T current = 2;
-            for (size_t i = 0; i < N; ++i) {
-                result[i] = current++;
-                while (i > 0) {
-                    bool coprime = true;
-                    for (size_t j = 0; j < i; ++j) {
-                        if (std::gcd(current, result[j]) != 1) {
-                            coprime = false;
-                            break;
-                        }
-                    }
-                    if (coprime) break;
-                    current++;
-                }
+
+    // Getters
+    constexpr const std::array<T, N>& moduli() const { return moduli_; }
+    constexpr T modulus(std::size_t i) const { return moduli_[i]; }
+    constexpr range_type dynamic_range() const { return dynamic_range_; }
+    constexpr range_type mi(std::size_t i) const { return mi_[i]; }
+    constexpr T mi_inverse(std::size_t i) const { return mi_inverse_[i]; }
+    constexpr const barrett_reducer& reducer(std::size_t i) const { return reducers_[i]; }
+
+    // Channel arithmetic on residues in [0, mᵢ)
+    constexpr T reduce(std::size_t i, std::uint64_t x) const {
+        return static_cast<T>(reducers_[i].reduce(x));
+    }
+
+    constexpr T add(std::size_t i, T a, T b) const {
+        std::uint64_t m = static_cast<std::uint64_t>(moduli_[i]);
+        std::uint64_t s = static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b);
+        return static_cast<T>(s >= m ? s - m : s);
+    }
+
+    constexpr T sub(std::size_t i, T a, T b) const {
+        std::uint64_t m = static_cast<std::uint64_t>(moduli_[i]);
+        std::uint64_t d = static_cast<std::uint64_t>(a) + m - static_cast<std::uint64_t>(b);
+        return static_cast<T>(d >= m ? d - m : d);
+    }
+
+    constexpr T mul(std::size_t i, T a, T b) const {
+        return static_cast<T>(reducers_[i].mul(static_cast<std::uint64_t>(a),
+                                               static_cast<std::uint64_t>(b)));
+    }
+
+    /// @brief value mod mᵢ in [0, mᵢ), including negative values
+    constexpr T channel_from_integer(std::size_t i, T value) const {
+        if constexpr (std::is_signed_v<T>) {
+            if (value < 0) {
+                // -(value + 1) cannot overflow, unlike -value
+                auto neg = static_cast<std::uint64_t>(-(value + 1)) + 1;
+                T r = reduce(i, neg);
+                return r == 0 ? T(0) : static_cast<T>(moduli_[i] - r);
             }
-            return result;
         }
+        return reduce(i, static_cast<std::uint64_t>(value));
     }
-    
-    residue_number_system() : residue_number_system(default_moduli()) {}
-    
+
+    /// @brief Mixed-radix digits, least significant first
+    constexpr std::array<T, N> mixed_radix(const std::array<T, N>& residues) const {
+        std::array<T, N> digits{};
+        mixed_radix_subset(residues, identity_order(), N, digits);
+        return digits;
+    }
+
+    /// @brief -1, 0 or 1 comparing the representatives in [0, M)
+    constexpr int compare_unsigned(const std::array<T, N>& a, const std::array<T, N>& b) const {
+        std::array<T, N> da = mixed_radix(a);
+        std::array<T, N> db = mixed_radix(b);
+        for (std::size_t t = N; t-- > 0;) {
+            if (da[t] != db[t]) return da[t] < db[t] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    /// @brief Whether the representative is ≥ ⌈M/2⌉, i.e. negative when signed
+    constexpr bool is_upper_half(const std::array<T, N>& residues) const {
+        std::array<T, N> digits = mixed_radix(residues);
+        for (std::size_t t = N; t-- > 0;) {
+            if (digits[t] != half_digits_[t]) return digits[t] > half_digits_[t];
+        }
+        return true;
+    }
+
+    /// @brief Base extension: the representative x ∈ [0, M) reduced mod m
+    /// @param m Any modulus in [1, 2³²), not necessarily part of the basis
+    constexpr T extend(const std::array<T, N>& residues, std::uint64_t m) const {
+        std::array<T, N> digits = mixed_radix(residues);
+        return static_cast<T>(evaluate_digits(digits, identity_order(), N, moduli_,
+                                              barrett_reducer(m)));
+    }
+
+    /// @brief Residues of ⌊x / mₖ⌋ for the representative x ∈ [0, M)
+    /// @details (x - rₖ)·mₖ⁻¹ is exact in every other channel; channel k is
+    /// then recovered by base extension from the remaining N-1 channels
+    constexpr std::array<T, N> scale(const std::array<T, N>& residues, std::size_t k) const {
+        std::array<T, N> result{};
+        std::array<std::size_t, N> order{};
+        std::size_t count = 0;
+        for (std::size_t j = 0; j < N; ++j) {
+            if (j == k) continue;
+            T rk = reduce(j, static_cast<std::uint64_t>(residues[k]));
+            result[j] = mul(j, sub(j, residues[j], rk), inverses_[k][j]);
+            order[count++] = j;
+        }
+        std::array<T, N> digits{};
+        mixed_radix_subset(result, order, count, digits);
+        result[k] = static_cast<T>(evaluate_digits(digits, order, count, moduli_, reducers_[k]));
+        return result;
+    }
+
+    /// @brief CRT reconstruction: Σ Mᵢ·((rᵢ·Mᵢ⁻¹) mod mᵢ) mod M, in [0, M)
+    constexpr range_type reconstruct(const std::array<T, N>& residues) const {
+        range_type result = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            range_type digit = static_cast<range_type>(mul(i, residues[i], mi_inverse_[i]));
+            result += mi_[i] * digit;
+            if (result >= dynamic_range_) result -= dynamic_range_;
+        }
+        return result;
+    }
+};
+
+/// @brief Compile-time moduli; the basis is built and validated during compilation
+template<typename T, T... Moduli>
+struct rns_moduli {
+    static constexpr std::size_t size = sizeof...(Moduli);
+    static constexpr rns_basis<T, size> basis{std::array<T, size>{Moduli...}};
+};
+
+/// @brief Default basis for N moduli
+template<typename T, std::size_t N>
+struct rns_default_basis {
+    static constexpr rns_basis<T, N> basis{detail::rns_default_moduli<T, N>()};
+};
+
+template<typename T, size_t N, typename Basis = rns_default_basis<T, N>>
+class residue_number_system {
+    static_assert(std::is_integral_v<T>, "RNS requires integral type");
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(Basis::basis)>, rns_basis<T, N>>,
+                  "Basis must provide an rns_basis<T, N>");
+
+private:
+    std::array<T, N> residues_;
+
+public:
+    using range_type = typename rns_basis<T, N>::range_type;
+
+    /// @brief The shared basis of this RNS type
+    static constexpr const rns_basis<T, N>& basis() { return Basis::basis; }
+
+    // Default moduli for common use cases
+    static constexpr const std::array<T, N>& default_moduli() {
+        return basis().moduli();
+    }
+
+    // Constructor - represents zero
+    constexpr residue_number_system() : residues_{} {}
+
     // Convert from integer
-    static residue_number_system from_integer(T value, 
-                                              const std::array<T, N>& moduli = default_moduli()) {
-        residue_number_system result(moduli);
+    static constexpr residue_number_system from_integer(T value) {
+        residue_number_system result;
         for (size_t i = 0; i < N; ++i) {
-            result.residues_[i] = ((value % moduli[i]) + moduli[i]) % moduli[i];
+            result.residues_[i] = basis().channel_from_integer(i, value);
         }
         return result;
     }
-    
-    // Convert to integer using Chinese Remainder Theorem
-    T to_integer() const {
-        T result = 0;
-        
+
+    // Construct from residues (each reduced into its channel)
+    static constexpr residue_number_system from_residues(const std::array<T, N>& residues) {
+        residue_number_system result;
         for (size_t i = 0; i < N; ++i) {
-            T Mi = dynamic_range_ / moduli_[i];
-            T Mi_inv = mod_inverse(Mi % moduli_[i], moduli_[i]);
-            result = (result + residues_[i] * Mi * Mi_inv) % dynamic_range_;
+            result.residues_[i] = basis().channel_from_integer(i, residues[i]);
         }
-        
         return result;
     }
-    
+
+    // Convert to integer using Chinese Remainder Theorem
+    // Note: the result is the representative in [0, M) narrowed to T
+    constexpr T to_integer() const {
+        instrumentation::count(instrumentation::counter::rns_reconstructions);
+        return static_cast<T>(basis().reconstruct(residues_));
+    }
+
+    /// @brief Full-width CRT reconstruction in [0, M)
+    constexpr range_type to_range_type() const {
+        instrumentation::count(instrumentation::counter::rns_reconstructions);
+        return basis().reconstruct(residues_);
+    }
+
     // Parallel arithmetic operations
-    residue_number_system operator+(const residue_number_system& other) const {
-        residue_number_system result(moduli_);
+    constexpr residue_number_system operator+(const residue_number_system& other) const {
+        instrumentation::count(instrumentation::counter::rns_ops);
+        residue_number_system result;
         for (size_t i = 0; i < N; ++i) {
-            result.residues_[i] = (residues_[i] + other.residues_[i]) % moduli_[i];
+            result.residues_[i] = basis().add(i, residues_[i], other.residues_[i]);
         }
         return result;
     }
-    
-    residue_number_system operator-(const residue_number_system& other) const {
-        residue_number_system result(moduli_);
+
+    constexpr residue_number_system operator-(const residue_number_system& other) const {
+        instrumentation::count(instrumentation::counter::rns_ops);
+        residue_number_system result;
         for (size_t i = 0; i < N; ++i) {
-            result.residues_[i] = ((residues_[i] - other.residues_[i]) % moduli_[i] + moduli_[i]) % moduli_[i];
+            result.residues_[i] = basis().sub(i, residues_[i], other.residues_[i]);
         }
         return result;
     }
-    
-    residue_number_system operator*(const residue_number_system& other) const {
-        residue_number_system result(moduli_);
+
+    constexpr residue_number_system operator*(const residue_number_system& other) const {
+        instrumentation::count(instrumentation::counter::rns_ops);
+        residue_number_system result;
         for (size_t i = 0; i < N; ++i) {
-            result.residues_[i] = (residues_[i] * other.residues_[i]) % moduli_[i];
+            result.residues_[i] = basis().mul(i, residues_[i], other.residues_[i]);
         }
         return result;
     }
+
+    // Residue-space ordering and scaling (no CRT reconstruction)
     
-    // Getters
-    const std::array<T, N>& residues() const { return residues_; }
-    const std::array<T, N>& moduli() const { return moduli_; }
-    T dynamic_range() const { return dynamic_range_; }
+    /// @brief Mixed-radix digits of the representative, least significant first
+    constexpr std::array<T, N> mixed_radix() const {
+        return basis().mixed_radix(residues_);
+    }
+    
+    /// @brief -1, 0 or 1; signed T uses the symmetric range [-⌊M/2⌋, ⌈M/2⌉),
+    /// unsigned T the representatives in [0, M)
+    constexpr int sign() const {
+        bool zero = true;
+        for (size_t i = 0; i < N; ++i) zero = zero && residues_[i] == 0;
+        if (zero) return 0;
+        if constexpr (std::is_signed_v<T>) {
+            return basis().is_upper_half(residues_) ? -1 : 1;
+        } else {
+            return 1;
+        }
+    }
     
-    // Comparison (expensive - requires conversion)
-    bool operator==(const residue_number_system& other) const {
-        return residues_ == other.residues_;
+    /// @brief Three-way comparison under the interpretation used by sign()
+    constexpr int compare(const residue_number_system& other) const {
+        if constexpr (std::is_signed_v<T>) {
+            bool neg = basis().is_upper_half(residues_);
+            bool other_neg = basis().is_upper_half(other.residues_);
+            // Within one half the unsigned order agrees with the signed one
+            if (neg != other_neg) return neg ? -1 : 1;
+        }
+        return basis().compare_unsigned(residues_, other.residues_);
+    }
+    
+    /// @brief Whether *this + other leaves the signed range [-⌊M/2⌋, ⌈M/2⌉)
+    /// @details Wrap-around is detectable from signs alone: it happens exactly
+    /// when both operands share a sign that the sum does not
+    constexpr bool is_overflow(const residue_number_system& other) const {
+        int a = sign(), b = other.sign();
+        if (a == 0 || b == 0 || a != b) return false;
+        return (*this + other).sign() != a;
     }
     
+    /// @brief ⌊x / mₖ⌋ for the representative x ∈ [0, M), staying in residue space
+    constexpr residue_number_system scale_by_modulus(size_t k) const {
+        residue_number_system result;
+        result.residues_ = basis().scale(residues_, k);
+        return result;
+    }
+    
+    /// @brief Base extension: the representative reduced by a modulus outside the basis
+    constexpr T base_extend(T modulus) const {
+        return basis().extend(residues_, static_cast<std::uint64_t>(modulus));
+    }
+    
+    constexpr bool operator<(const residue_number_system& other) const { return compare(other) < 0; }
+    constexpr bool operator>(const residue_number_system& other) const { return compare(other) > 0; }
+    constexpr bool operator<=(const residue_number_system& other) const { return compare(other) <= 0; }
+    constexpr bool operator>=(const residue_number_system& other) const { return compare(other) >= 0; }
+    
+    // Getters
+    constexpr const std::array<T, N>& residues() const { return residues_; }
+    static constexpr const std::array<T, N>& moduli() { return basis().moduli(); }
+    static constexpr range_type dynamic_range() { return basis().dynamic_range(); }
+
+    // Equality is exact channel-wise
+    constexpr bool operator==(const residue_number_system& other) const {
+        for (size_t i = 0; i < N; ++i) {
+            if (residues_[i] != other.residues_[i]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const residue_number_system& other) const {
+        return !(*this == other);
+    }
+
     // Output
     friend std::ostream& operator<<(std::ostream& os, const residue_number_system& rns) {
         os << "RNS(";
         for (size_t i = 0; i < N; ++i) {
-            os << rns.residues_[i] << " mod " << rns.moduli_[i];
+            os << rns.residues_[i] << " mod " << moduli()[i];
             if (i < N - 1) os << ", ";
         }
         os << ")";
@@ -179,4 +508,4 @@ using rns3 = residue_number_system<T, 3>;
 template<typename T>
 using rns4 = residue_number_system<T, 4>;
 
-} // namespace cbt
\ No newline at end of file
+} // namespace cbt
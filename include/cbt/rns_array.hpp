@@ -0,0 +1,223 @@
+/**
+ * RNS Array - Channel-Parallel Residue Arithmetic over Many Values
+ *
+ * Layout: channel-major (structure of arrays). Channel i holds the residues
+ * of every element modulo mᵢ in one contiguous array, so each batched
+ * operation is N independent loops, each with a single constant modulus.
+ *
+ * Trade-off:
+ *   Gain: Carry-free arithmetic becomes N flat, branch-free loops the
+ *         compiler can unroll and vectorize; dot products defer reduction
+ *         and pay one Barrett step per block instead of per term
+ *   Loss: Accessing one element touches N arrays (use residue_number_system)
+ *
+ * Applications:
+ *   - DSP filters and convolution accumulations
+ *   - Batched modular arithmetic
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "residue_number_system.hpp"
+#include "span.hpp"
+
+namespace cbt {
+
+template<typename T, size_t N, typename Basis = rns_default_basis<T, N>>
+class rns_array {
+public:
+    using value_type = residue_number_system<T, N, Basis>;
+    using range_type = typename rns_basis<T, N>::range_type;
+
+private:
+    std::array<std::vector<T>, N> channels_;
+
+    static constexpr const rns_basis<T, N>& basis() { return Basis::basis; }
+
+    void check_size(const rns_array& other) const {
+        if (size() != other.size()) {
+            throw std::invalid_argument("rns_array sizes must match");
+        }
+    }
+
+    template<typename Op>
+    rns_array elementwise(const rns_array& other, Op op) const {
+        check_size(other);
+        rns_array result(size());
+        for (size_t i = 0; i < N; ++i) {
+            const T* a = channels_[i].data();
+            const T* b = other.channels_[i].data();
+            T* dst = result.channels_[i].data();
+            for (size_t k = 0; k < size(); ++k) {
+                dst[k] = op(i, a[k], b[k]);
+            }
+        }
+        return result;
+    }
+
+public:
+    // Constructors
+    rns_array() = default;
+
+    /// @brief n zeros
+    explicit rns_array(size_t n) {
+        for (auto& channel : channels_) channel.assign(n, T(0));
+    }
+
+    /// @brief Batched forward conversion, one pass per channel
+    static rns_array from_integers(span<const T> values) {
+        rns_array result(values.size());
+        for (size_t i = 0; i < N; ++i) {
+            const T* src = values.data();
+            T* dst = result.channels_[i].data();
+            for (size_t k = 0; k < values.size(); ++k) {
+                dst[k] = basis().channel_from_integer(i, src[k]);
+            }
+        }
+        return result;
+    }
+
+    static rns_array from_integers(const std::vector<T>& values) {
+        return from_integers(span<const T>(values));
+    }
+
+    /// @brief Whether every residue of channel i lies in [0, mᵢ)
+    /// @details Compared as unsigned, so a negative residue of a signed T fails too
+    static bool channels_reduced(const std::array<span<const T>, N>& channels) {
+        using U = std::make_unsigned_t<T>;
+        for (size_t i = 0; i < N; ++i) {
+            const U m = static_cast<U>(basis().modulus(i));
+            const T* src = channels[i].data();
+            bool out_of_range = false;
+            for (size_t k = 0; k < channels[i].size(); ++k) out_of_range |= !(static_cast<U>(src[k]) < m);
+            if (out_of_range) return false;
+        }
+        return true;
+    }
+
+    /// @brief Adopt channel residues already reduced into [0, mᵢ) (e.g. a mapped file)
+    /// @throws std::invalid_argument if the lengths differ or a residue lies outside [0, mᵢ)
+    static rns_array from_channels(const std::array<span<const T>, N>& channels) {
+        for (size_t i = 0; i < N; ++i) {
+            if (channels[i].size() != channels[0].size()) {
+                throw std::invalid_argument("rns_array channels must have equal length");
+            }
+        }
+        if (!channels_reduced(channels)) {
+            throw std::invalid_argument("rns_array residue lies outside [0, modulus)");
+        }
+        rns_array result;
+        for (size_t i = 0; i < N; ++i) result.channels_[i].assign(channels[i].begin(), channels[i].end());
+        return result;
+    }
+
+    /// @brief Batched CRT reconstruction, narrowed to T
+    std::vector<T> to_integers() const {
+        std::vector<range_type> wide = to_range_type();
+        std::vector<T> result(wide.size());
+        for (size_t k = 0; k < wide.size(); ++k) {
+            result[k] = static_cast<T>(wide[k]);
+        }
+        return result;
+    }
+
+    /// @brief Batched CRT reconstruction in [0, M)
+    /// @details Accumulates Mᵢ·((rᵢ·Mᵢ⁻¹) mod mᵢ) channel by channel so every
+    /// inner loop streams one residue array with constant CRT coefficients
+    std::vector<range_type> to_range_type() const {
+        const range_type range = basis().dynamic_range();
+        std::vector<range_type> result(size(), range_type(0));
+        range_type* dst = result.data();
+        for (size_t i = 0; i < N; ++i) {
+            const T* src = channels_[i].data();
+            const T inv = basis().mi_inverse(i);
+            const range_type mi = basis().mi(i);
+            for (size_t k = 0; k < size(); ++k) {
+                range_type acc = dst[k] + mi * static_cast<range_type>(basis().mul(i, src[k], inv));
+                dst[k] = acc >= range ? acc - range : acc;
+            }
+        }
+        return result;
+    }
+
+    // Element access
+    size_t size() const { return channels_[0].size(); }
+    bool empty() const { return size() == 0; }
+
+    value_type get(size_t k) const {
+        std::array<T, N> residues;
+        for (size_t i = 0; i < N; ++i) residues[i] = channels_[i][k];
+        return value_type::from_residues(residues);
+    }
+
+    void set(size_t k, const value_type& value) {
+        for (size_t i = 0; i < N; ++i) channels_[i][k] = value.residues()[i];
+    }
+
+    /// @brief Contiguous residues of channel i (all values mod mᵢ)
+    span<const T> channel(size_t i) const { return span<const T>(channels_[i]); }
+
+    // Batched arithmetic
+    rns_array operator+(const rns_array& other) const {
+        return elementwise(other, [](size_t i, T a, T b) { return basis().add(i, a, b); });
+    }
+
+    rns_array operator-(const rns_array& other) const {
+        return elementwise(other, [](size_t i, T a, T b) { return basis().sub(i, a, b); });
+    }
+
+    rns_array operator*(const rns_array& other) const {
+        return elementwise(other, [](size_t i, T a, T b) { return basis().mul(i, a, b); });
+    }
+
+    /// @brief In place: this[k] += a[k]·b[k]
+    rns_array& multiply_accumulate(const rns_array& a, const rns_array& b) {
+        check_size(a);
+        check_size(b);
+        for (size_t i = 0; i < N; ++i) {
+            const T* pa = a.channels_[i].data();
+            const T* pb = b.channels_[i].data();
+            T* acc = channels_[i].data();
+            for (size_t k = 0; k < size(); ++k) {
+                acc[k] = basis().add(i, acc[k], basis().mul(i, pa[k], pb[k]));
+            }
+        }
+        return *this;
+    }
+
+    /// @brief Σ a[k]·b[k] as a single RNS value
+    /// @details Products of residues below 2³² are summed unreduced in 64 bits
+    /// for as many terms as cannot overflow, then reduced once per block
+    friend value_type dot(const rns_array& a, const rns_array& b) {
+        a.check_size(b);
+        std::array<T, N> residues{};
+        for (size_t i = 0; i < N; ++i) {
+            const std::uint64_t m1 = static_cast<std::uint64_t>(basis().modulus(i)) - 1;
+            const std::uint64_t max_product = m1 * m1;
+            const size_t block = max_product == 0
+                ? a.size() + 1
+                : static_cast<size_t>((~std::uint64_t(0) - m1) / max_product);
+            const T* pa = a.channels_[i].data();
+            const T* pb = b.channels_[i].data();
+            T total = 0;
+            for (size_t start = 0; start < a.size(); start += block) {
+                size_t end = std::min(a.size(), start + block);
+                std::uint64_t sum = 0;
+                for (size_t k = start; k < end; ++k) {
+                    sum += static_cast<std::uint64_t>(pa[k]) * static_cast<std::uint64_t>(pb[k]);
+                }
+                total = basis().add(i, total, basis().reduce(i, sum));
+            }
+            residues[i] = total;
+        }
+        return value_type::from_residues(residues);
+    }
+};
+
+} // namespace cbt
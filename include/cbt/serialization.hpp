@@ -0,0 +1,516 @@
+/**
+ * Serialization - Zero-Copy Memory-Mapped Arrays of Transformed Values
+ *
+ * Transform: SoA container → versioned file of its columns, stored as is
+ *
+ * save_array writes an lg_vector, log_odds values, a multiscale_array or an
+ * rns_array in transformed form: a 64-byte header, a column offset table,
+ * the transform parameters (RNS moduli), then each column (logs, mantissas,
+ * scales, residue channels) at a 64-byte aligned offset. The mapped_* views
+ * mmap the file and read the columns in place: opening is O(1) in the array
+ * size, pages are faulted in on first touch, and nothing is recomputed.
+ *
+ * The header records the transform, scalar type, SCALE_FACTOR, the moduli
+ * and the writer's byte order; a view accepts a file only when all of them
+ * match its template parameters (std::invalid_argument otherwise). Files are
+ * native-endian so columns can be used without conversion: one written on a
+ * machine of the other byte order is rejected, as are truncated or foreign
+ * files (std::runtime_error). Column contents are not scanned on opening;
+ * RNS residues are checked against the moduli as they are read (get(),
+ * to_array()). Views are read-only and share the mapping, so
+ * copies are cheap and keep it alive; to_array() copies the columns into an
+ * owning container when it needs to be modified.
+ *
+ * Trade-off:
+ *   Gain: Loading a precomputed table costs a page fault per 4 KiB touched
+ *         instead of a log (lg) or normalization (multiscale) per element,
+ *         and processes mapping one file share its physical pages
+ *   Loss: Native byte order only; the file must not be modified while
+ *         mapped; without POSIX mmap the file is read into memory instead
+ *
+ * Applications:
+ *   - Precomputed log-probability and emission tables loaded at startup
+ *   - Sharing large transformed datasets between processes
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "lg_vector.hpp"
+#include "multiscale_array.hpp"
+#include "odds_ratio.hpp"
+#include "rns_array.hpp"
+#include "span.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CBT_HAS_MMAP 1
+#else
+#define CBT_HAS_MMAP 0
+#endif
+
+namespace cbt {
+
+/// @brief Which container a file holds
+enum class array_kind : std::uint16_t { lg = 1, log_odds = 2, multiscale = 3, rns = 4 };
+
+/// @brief Element type of the value columns
+enum class scalar_kind : std::uint16_t {
+    float32 = 1, float64 = 2,
+    int8 = 3, uint8 = 4, int16 = 5, uint16 = 6, int32 = 7, uint32 = 8, int64 = 9, uint64 = 10,
+};
+
+/**
+ * @brief On-disk header, the first 64 bytes of every file
+ * @details Followed by `columns` uint64 column offsets and `parameters`
+ * uint64 transform parameters (the RNS moduli); all fields native-endian
+ */
+struct array_header {
+    char magic[8];               ///< "CBTARRAY"
+    std::uint32_t byte_order;    ///< 0x01020304 as the writer stored it
+    std::uint16_t version;
+    std::uint16_t kind;          ///< array_kind
+    std::uint16_t scalar;        ///< scalar_kind of the value columns
+    std::uint16_t scalar_bytes;
+    std::int32_t scale_factor;   ///< multiscale SCALE_FACTOR, 0 otherwise
+    std::uint64_t count;         ///< elements per column
+    std::uint32_t columns;
+    std::uint32_t parameters;
+    std::uint64_t reserved[3];
+};
+
+static_assert(sizeof(array_header) == 64, "array_header must stay 64 bytes");
+
+constexpr std::uint16_t array_format_version = 1;
+constexpr std::size_t array_alignment = 64;
+
+namespace detail {
+
+constexpr char array_magic[8] = {'C', 'B', 'T', 'A', 'R', 'R', 'A', 'Y'};
+constexpr std::uint32_t array_byte_order = 0x01020304u;
+constexpr std::uint32_t array_byte_order_swapped = 0x04030201u;
+
+template<typename T>
+constexpr scalar_kind scalar_kind_of() {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double> &&
+                      (std::is_integral_v<T> || sizeof(T) == 4 || sizeof(T) == 8),
+                  "serialized columns hold fixed-width integers, float or double");
+    if constexpr (std::is_floating_point_v<T>) {
+        return sizeof(T) == 4 ? scalar_kind::float32 : scalar_kind::float64;
+    } else {
+        constexpr std::uint16_t width = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+        return static_cast<scalar_kind>(3 + 2 * width + (std::is_unsigned_v<T> ? 1 : 0));
+    }
+}
+
+constexpr std::uint64_t align_up(std::uint64_t offset) {
+    return (offset + array_alignment - 1) / array_alignment * array_alignment;
+}
+
+struct column_source {
+    const void* data;
+    std::size_t bytes;
+};
+
+template<typename T>
+array_header make_header(array_kind kind, std::uint64_t count, std::int32_t scale_factor = 0) {
+    array_header header{};
+    std::memcpy(header.magic, array_magic, sizeof(header.magic));
+    header.byte_order = array_byte_order;
+    header.version = array_format_version;
+    header.kind = static_cast<std::uint16_t>(kind);
+    header.scalar = static_cast<std::uint16_t>(scalar_kind_of<T>());
+    header.scalar_bytes = static_cast<std::uint16_t>(sizeof(T));
+    header.scale_factor = scale_factor;
+    header.count = count;
+    return header;
+}
+
+/// Header, offset table and parameters, then each column zero-padded to
+/// the next 64-byte boundary
+inline void write_array_file(const std::string& path, array_header header,
+                             const std::vector<std::uint64_t>& parameters,
+                             const std::vector<column_source>& columns) {
+    header.columns = static_cast<std::uint32_t>(columns.size());
+    header.parameters = static_cast<std::uint32_t>(parameters.size());
+    std::vector<std::uint64_t> offsets(columns.size());
+    std::uint64_t end = sizeof(array_header) + 8 * (columns.size() + parameters.size());
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        offsets[c] = align_up(end);
+        end = offsets[c] + columns[c].bytes;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("cannot open " + path + " for writing");
+    std::uint64_t position = 0;
+    auto write = [&](const void* data, std::size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        position += bytes;
+    };
+    auto pad_to = [&](std::uint64_t offset) {
+        static const char zeros[array_alignment] = {};
+        write(zeros, static_cast<std::size_t>(offset - position));
+    };
+    write(&header, sizeof(header));
+    write(offsets.data(), 8 * offsets.size());
+    write(parameters.data(), 8 * parameters.size());
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        pad_to(offsets[c]);
+        write(columns[c].data, columns[c].bytes);
+    }
+    pad_to(align_up(position));
+    out.flush();
+    if (!out) throw std::runtime_error("failed writing " + path);
+}
+
+} // namespace detail
+
+/**
+ * @brief Read-only mapping of a whole file
+ * @details POSIX mmap where available, otherwise the file is read into a
+ * 64-byte aligned buffer; either way data() is aligned for every column.
+ */
+class mapped_file {
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !CBT_HAS_MMAP
+    struct aligned_delete {
+        void operator()(std::byte* p) const { ::operator delete[](p, std::align_val_t(array_alignment)); }
+    };
+    std::unique_ptr<std::byte[], aligned_delete> buffer_;
+#endif
+
+    void release() {
+#if CBT_HAS_MMAP
+        if (data_ != nullptr) ::munmap(const_cast<std::byte*>(data_), size_);
+#else
+        buffer_.reset();
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+public:
+    explicit mapped_file(const std::string& path) {
+#if CBT_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            data_ = static_cast<const std::byte*>(p);
+        }
+        ::close(fd);   // the mapping keeps the file referenced
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        size_ = static_cast<std::size_t>(in.tellg());
+        buffer_.reset(static_cast<std::byte*>(::operator new[](size_, std::align_val_t(array_alignment))));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(buffer_.get()), static_cast<std::streamsize>(size_))) {
+            throw std::runtime_error("failed reading " + path);
+        }
+        data_ = buffer_.get();
+#endif
+    }
+
+    ~mapped_file() { release(); }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const std::byte* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    static constexpr bool memory_mapped() { return CBT_HAS_MMAP != 0; }
+};
+
+namespace detail {
+
+/// A validated file: its header and the start of every column
+class mapped_columns {
+    std::shared_ptr<const mapped_file> file_;
+    array_header header_{};
+
+    std::uint64_t table(std::size_t i) const {
+        std::uint64_t value;
+        std::memcpy(&value, file_->data() + sizeof(array_header) + 8 * i, sizeof(value));
+        return value;
+    }
+
+public:
+    mapped_columns() = default;
+
+    /// Checks format, byte order, version, transform and scalar type, and
+    /// that every column (element sizes in column_bytes) lies inside the file
+    mapped_columns(std::shared_ptr<const mapped_file> file, array_kind kind, scalar_kind scalar,
+                   std::size_t scalar_bytes, std::int32_t scale_factor,
+                   const std::vector<std::size_t>& column_bytes)
+        : file_(std::move(file)) {
+        const std::size_t size = file_->size();
+        if (size < sizeof(array_header) ||
+            std::memcmp(file_->data(), array_magic, sizeof(array_magic)) != 0) {
+            throw std::runtime_error("not a CBT array file");
+        }
+        std::memcpy(&header_, file_->data(), sizeof(header_));
+        if (header_.byte_order == array_byte_order_swapped) {
+            throw std::runtime_error("CBT array file was written with the opposite byte order");
+        }
+        if (header_.byte_order != array_byte_order) throw std::runtime_error("corrupt CBT array header");
+        if (header_.version == 0 || header_.version > array_format_version) {
+            throw std::runtime_error("unsupported CBT array format version " + std::to_string(header_.version));
+        }
+        if (header_.kind != static_cast<std::uint16_t>(kind)) {
+            throw std::invalid_argument("CBT array file holds a different transform");
+        }
+        if (header_.scalar != static_cast<std::uint16_t>(scalar) || header_.scalar_bytes != scalar_bytes) {
+            throw std::invalid_argument("CBT array file holds a different scalar type");
+        }
+        if (header_.scale_factor != scale_factor) {
+            throw std::invalid_argument("CBT array file has a different SCALE_FACTOR");
+        }
+        if (header_.columns != column_bytes.size()) throw std::runtime_error("corrupt CBT array header");
+        const std::uint64_t tables = 8 * (std::uint64_t(header_.columns) + header_.parameters);
+        if (tables > size - sizeof(array_header)) throw std::runtime_error("truncated CBT array file");
+        for (std::size_t c = 0; c < column_bytes.size(); ++c) {
+            const std::uint64_t offset = table(c);
+            if (offset % array_alignment != 0 || offset > size ||
+                header_.count > (size - offset) / column_bytes[c]) {
+                throw std::runtime_error("truncated CBT array file");
+            }
+        }
+    }
+
+    const array_header& header() const { return header_; }
+    std::size_t size() const { return static_cast<std::size_t>(header_.count); }
+    std::uint64_t parameter(std::size_t i) const { return table(header_.columns + i); }
+
+    template<typename U>
+    span<const U> column(std::size_t c) const {
+        return span<const U>(reinterpret_cast<const U*>(file_->data() + table(c)), size());
+    }
+};
+
+} // namespace detail
+
+// Writers: columns in their transformed form, no conversion
+
+template<typename T>
+void save_array(const std::string& path, const lg_vector<T>& values) {
+    detail::write_array_file(path, detail::make_header<T>(array_kind::lg, values.size()), {},
+                             {{values.data(), sizeof(T) * values.size()}});
+}
+
+template<typename T>
+void save_array(const std::string& path, span<const log_odds<T>> values) {
+    std::vector<T> logits(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) logits[i] = values[i].value();
+    detail::write_array_file(path, detail::make_header<T>(array_kind::log_odds, values.size()), {},
+                             {{logits.data(), sizeof(T) * logits.size()}});
+}
+
+template<typename T>
+void save_array(const std::string& path, const std::vector<log_odds<T>>& values) {
+    save_array(path, span<const log_odds<T>>(values));
+}
+
+template<typename T, int SCALE_FACTOR>
+void save_array(const std::string& path, const multiscale_array<T, SCALE_FACTOR>& values) {
+    detail::write_array_file(path, detail::make_header<T>(array_kind::multiscale, values.size(), SCALE_FACTOR), {},
+                             {{values.mantissas().data(), sizeof(T) * values.size()},
+                              {values.scales().data(), values.size()}});
+}
+
+template<typename T, std::size_t N, typename Basis>
+void save_array(const std::string& path, const rns_array<T, N, Basis>& values) {
+    std::vector<std::uint64_t> moduli(N);
+    std::vector<detail::column_source> channels(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        moduli[i] = static_cast<std::uint64_t>(Basis::basis.modulus(i));
+        channels[i] = {values.channel(i).data(), sizeof(T) * values.size()};
+    }
+    detail::write_array_file(path, detail::make_header<T>(array_kind::rns, values.size()), moduli, channels);
+}
+
+/**
+ * @brief lg_vector saved by save_array, read in place
+ * @details An lg_vector expression: `lg_vector<T> r = mapped * other` and
+ * reduce_product(mapped) read the mapped logs directly.
+ */
+template<typename T>
+class mapped_lg_vector : public lg_expr<mapped_lg_vector<T>> {
+    static_assert(std::is_floating_point_v<T>, "mapped_lg_vector requires floating-point type");
+
+    detail::mapped_columns columns_;
+    span<const T> logs_;
+
+public:
+    using value_type = T;
+
+    explicit mapped_lg_vector(std::shared_ptr<const mapped_file> file)
+        : columns_(std::move(file), array_kind::lg, detail::scalar_kind_of<T>(), sizeof(T), 0, {sizeof(T)}),
+          logs_(columns_.column<T>(0)) {}
+
+    explicit mapped_lg_vector(const std::string& path)
+        : mapped_lg_vector(std::make_shared<const mapped_file>(path)) {}
+
+    std::size_t size() const { return logs_.size(); }
+    bool empty() const { return logs_.empty(); }
+    T log_at(std::size_t i) const { return logs_[i]; }
+    lg<T> operator[](std::size_t i) const { return lg<T>::from_log(logs_[i]); }
+
+    const T* data() const { return logs_.data(); }
+    span<const T> logs() const { return logs_; }
+
+    lg_vector<T> to_array() const { return lg_vector<T>(*this); }
+};
+
+namespace detail {
+
+/// Mapped views are captured by reference like the containers they mirror
+template<typename T>
+struct lg_expr_storage<mapped_lg_vector<T>> { using type = const mapped_lg_vector<T>&; };
+
+} // namespace detail
+
+/// @brief log_odds values saved by save_array, read in place
+template<typename T>
+class mapped_log_odds_array {
+    static_assert(std::is_floating_point_v<T>, "mapped_log_odds_array requires floating-point type");
+
+    detail::mapped_columns columns_;
+    span<const T> values_;
+
+public:
+    explicit mapped_log_odds_array(std::shared_ptr<const mapped_file> file)
+        : columns_(std::move(file), array_kind::log_odds, detail::scalar_kind_of<T>(), sizeof(T), 0, {sizeof(T)}),
+          values_(columns_.column<T>(0)) {}
+
+    explicit mapped_log_odds_array(const std::string& path)
+        : mapped_log_odds_array(std::make_shared<const mapped_file>(path)) {}
+
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    log_odds<T> operator[](std::size_t i) const { return log_odds<T>(values_[i]); }
+
+    /// @brief The log-odds themselves
+    span<const T> values() const { return values_; }
+
+    std::vector<log_odds<T>> to_array() const {
+        std::vector<log_odds<T>> result;
+        result.reserve(size());
+        for (T v : values_) result.emplace_back(v);
+        return result;
+    }
+};
+
+/// @brief multiscale_array saved by save_array, read in place
+template<typename T, int SCALE_FACTOR = 3>
+class mapped_multiscale_array {
+    static_assert(std::is_floating_point_v<T>, "mapped_multiscale_array requires floating-point type");
+
+    detail::mapped_columns columns_;
+    span<const T> mantissas_;
+    span<const std::int8_t> scales_;
+
+public:
+    using value_type = multiscale<T, SCALE_FACTOR>;
+
+    explicit mapped_multiscale_array(std::shared_ptr<const mapped_file> file)
+        : columns_(std::move(file), array_kind::multiscale, detail::scalar_kind_of<T>(), sizeof(T), SCALE_FACTOR,
+                   {sizeof(T), 1}),
+          mantissas_(columns_.column<T>(0)),
+          scales_(columns_.column<std::int8_t>(1)) {}
+
+    explicit mapped_multiscale_array(const std::string& path)
+        : mapped_multiscale_array(std::make_shared<const mapped_file>(path)) {}
+
+    std::size_t size() const { return mantissas_.size(); }
+    bool empty() const { return mantissas_.empty(); }
+    value_type get(std::size_t i) const { return value_type::from_normalized(mantissas_[i], scales_[i]); }
+
+    span<const T> mantissas() const { return mantissas_; }
+    span<const std::int8_t> scales() const { return scales_; }
+
+    multiscale_array<T, SCALE_FACTOR> to_array() const {
+        return multiscale_array<T, SCALE_FACTOR>::from_normalized(mantissas_, scales_);
+    }
+};
+
+/// @brief rns_array saved by save_array, read in place; the moduli must match Basis
+/// @details Residues are not scanned when mapping: get() and to_array() check
+///          the ones they read against the moduli and throw std::runtime_error
+///          for a residue outside [0, mᵢ) (a corrupt file); channel(i)
+///          returns the column as stored
+template<typename T, std::size_t N, typename Basis = rns_default_basis<T, N>>
+class mapped_rns_array {
+    detail::mapped_columns columns_;
+    std::array<span<const T>, N> channels_;
+
+    static void throw_unreduced() {
+        throw std::runtime_error("CBT array file has a residue outside [0, modulus)");
+    }
+
+public:
+    using value_type = residue_number_system<T, N, Basis>;
+
+    explicit mapped_rns_array(std::shared_ptr<const mapped_file> file)
+        : columns_(std::move(file), array_kind::rns, detail::scalar_kind_of<T>(), sizeof(T), 0,
+                   std::vector<std::size_t>(N, sizeof(T))) {
+        if (columns_.header().parameters != N) {
+            throw std::invalid_argument("CBT array file has a different number of RNS moduli");
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            if (columns_.parameter(i) != static_cast<std::uint64_t>(Basis::basis.modulus(i))) {
+                throw std::invalid_argument("CBT array file has different RNS moduli");
+            }
+            channels_[i] = columns_.column<T>(i);
+        }
+    }
+
+    explicit mapped_rns_array(const std::string& path)
+        : mapped_rns_array(std::make_shared<const mapped_file>(path)) {}
+
+    std::size_t size() const { return columns_.size(); }
+    bool empty() const { return size() == 0; }
+
+    value_type get(std::size_t k) const {
+        std::array<T, N> residues;
+        for (std::size_t i = 0; i < N; ++i) {
+            residues[i] = channels_[i][k];
+            using U = std::make_unsigned_t<T>;   // negative residues fail too
+            if (!(static_cast<U>(residues[i]) < static_cast<U>(Basis::basis.modulus(i)))) throw_unreduced();
+        }
+        return value_type::from_residues(residues);
+    }
+
+    /// @brief Contiguous residues of channel i (all values mod mᵢ)
+    span<const T> channel(std::size_t i) const { return channels_[i]; }
+
+    rns_array<T, N, Basis> to_array() const {
+        if (!rns_array<T, N, Basis>::channels_reduced(channels_)) throw_unreduced();
+        return rns_array<T, N, Basis>::from_channels(channels_);
+    }
+};
+
+} // namespace cbt
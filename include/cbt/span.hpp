@@ -0,0 +1,72 @@
+/**
+ * Span - Non-owning View over Contiguous Storage
+ *
+ * The batched kernels in CBT operate on contiguous runs of values. C++17 has
+ * no std::span, so this is the minimal subset the library needs: a pointer
+ * and a length, constructible from raw arrays, std::array and std::vector.
+ *
+ * span<const X> is the read-only view; span<X> allows in-place updates.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace cbt {
+
+template<typename T>
+class span {
+private:
+    T* data_;
+    std::size_t size_;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    // Constructors
+    constexpr span() : data_(nullptr), size_(0) {}
+    constexpr span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    template<std::size_t N>
+    constexpr span(T (&data)[N]) : data_(data), size_(N) {}
+
+    template<typename U, std::size_t N,
+             typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(std::array<U, N>& data) : data_(data.data()), size_(N) {}
+
+    template<typename U, std::size_t N,
+             typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    constexpr span(const std::array<U, N>& data) : data_(data.data()), size_(N) {}
+
+    template<typename U, typename A,
+             typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    span(std::vector<U, A>& data) : data_(data.data()), size_(data.size()) {}
+
+    template<typename U, typename A,
+             typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    span(const std::vector<U, A>& data) : data_(data.data()), size_(data.size()) {}
+
+    // Read-only view of a mutable span
+    template<typename U,
+             typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(const span<U>& other) : data_(other.data()), size_(other.size()) {}
+
+    // Getters
+    constexpr T* data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+    constexpr T& operator[](std::size_t i) const { return data_[i]; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+    constexpr span subspan(std::size_t offset, std::size_t count) const {
+        return span(data_ + offset, count);
+    }
+};
+
+} // namespace cbt
@@ -4,6 +4,16 @@
  * Transform: ℝ → Tree position in Stern-Brocot tree
  * Representation: All positive rationals in lowest terms
  * 
+ * Arithmetic cancels common factors before multiplying (Knuth's gcd-first
+ * method) and forms cross products in twice the width of T, so a result
+ * that fits in T is exact and one that does not throws std::overflow_error.
+ * stern_brocot<big_integer> (big_integer.hpp) removes the bound; small
+ * values stay inline there too.
+ *
+ * approximate_many() finds best approximations for a batch of doubles in
+ * vectorizable lanes. path_key() encodes the tree path so that bytewise
+ * order of keys is numeric order.
+ *
  * Trade-off:
  *   Gain: Exact rational arithmetic, optimal approximations
  *   Loss: Irrational numbers require infinite representation
@@ -13,83 +23,402 @@
  *   - Music theory (frequency ratios)
  *   - Continued fractions
  *   - Farey sequences
+ *   - Sorted indexes of rationals (path keys)
  */
 
 #pragma once
+#include <algorithm>
+#include <cstddef>
 #include <numeric>
 #include <vector>
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <stdexcept>
 #include <type_traits>
+#include "big_integer.hpp"
+#include "interval.hpp"
+#include "logarithmic.hpp"
+#include "span.hpp"
 
 namespace cbt {
 
+namespace detail {
+
+/// Type for the degree-2 intermediates of rational arithmetic (n₁·d₂ + n₂·d₁):
+/// twice the width of T where the platform has it, otherwise T itself
+template<typename T, typename = void>
+struct rational_wide { using type = T; };
+
+template<typename T>
+struct rational_wide<T, std::enable_if_t<std::is_integral_v<T> && (sizeof(T) <= 4)>> {
+    using type = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+};
+
+#ifdef __SIZEOF_INT128__
+template<typename T>
+struct rational_wide<T, std::enable_if_t<std::is_integral_v<T> && sizeof(T) == 8>> {
+    using type = std::conditional_t<std::is_signed_v<T>, __int128, unsigned __int128>;
+};
+#endif
+
+template<typename W>
+struct wide_unsigned { using type = std::make_unsigned_t<W>; };
+
+#ifdef __SIZEOF_INT128__
+template<>
+struct wide_unsigned<__int128> { using type = unsigned __int128; };
+template<>
+struct wide_unsigned<unsigned __int128> { using type = unsigned __int128; };
+#endif
+
+/// |v| as the unsigned type of the same width (exact for the most negative value)
+template<typename W>
+typename wide_unsigned<W>::type unsigned_magnitude(W v) {
+    using U = typename wide_unsigned<W>::type;
+    return v < W(0) ? U(U(0) - U(v)) : U(v);
+}
+
+/// Trailing zero bits of a nonzero unsigned value of up to 128 bits
+template<typename U>
+int trailing_zeros(U v) {
+    if constexpr (sizeof(U) <= sizeof(unsigned long long)) {
+        return __builtin_ctzll(v);
+    } else {
+        auto low = static_cast<unsigned long long>(v);
+        return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<unsigned long long>(v >> 64));
+    }
+}
+
+/// Stein's binary gcd: shifts and subtractions only, no division, and the
+/// ordering swap compiles to conditional moves
+template<typename U>
+U binary_gcd(U a, U b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int shift = trailing_zeros(U(a | b));
+    a >>= trailing_zeros(a);
+    do {
+        b >>= trailing_zeros(b);
+        U low = a < b ? a : b;
+        b = (a < b ? b : a) - low;
+        a = low;
+    } while (b != 0);
+    return a << shift;
+}
+
+/// gcd(|a|, |b|) as a T (also for the most negative value of a signed type)
+template<typename T>
+T integer_gcd(const T& a, const T& b) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<T>(binary_gcd(unsigned_magnitude(a), unsigned_magnitude(b)));
+    } else {
+        return gcd(a, b);   // found by argument-dependent lookup
+    }
+}
+
+/// Lamé's bound on continued-fraction terms for builtin T (0 otherwise)
+template<typename T>
+constexpr std::size_t continued_fraction_capacity() {
+    if constexpr (std::is_integral_v<T>) return std::numeric_limits<T>::digits * 3 / 2 + 2; else return 0;
+}
+
+} // namespace detail
+
+/// Continued fraction [a₀; a₁, …, aₙ] held inline, with no allocation.
+/// The capacity is Lamé's bound: Euclid's algorithm on values below
+/// 2^digits takes at most log_φ(2^digits) + 2 < 1.5·digits + 2 steps.
+template<typename T>
+class continued_fraction {
+    static_assert(std::is_integral_v<T>, "continued_fraction requires a builtin integer type");
+
+public:
+    using value_type = T;
+    static constexpr std::size_t capacity = detail::continued_fraction_capacity<T>();
+
+private:
+    T terms_[capacity];
+    std::size_t size_ = 0;
+
+public:
+    /// @throws std::length_error beyond capacity
+    void push_back(T term) {
+        if (size_ == capacity) throw std::length_error("continued_fraction capacity exceeded");
+        terms_[size_++] = term;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](std::size_t i) const { return terms_[i]; }
+    const T* data() const { return terms_; }
+    const T* begin() const { return terms_; }
+    const T* end() const { return terms_ + size_; }
+    span<const T> terms() const { return span<const T>(terms_, size_); }
+};
+
 template<typename T>
 class stern_brocot {
-    static_assert(std::is_integral_v<T>, "stern_brocot requires integral type");
+    static_assert(is_exact_integer_v<T>, "stern_brocot requires an exact integer type");
     
 private:
-    T num_, den_;
-    
-    void reduce() {
-        T g = std::gcd(num_, den_);
-        if (g > 1) {
-            num_ /= g;
-            den_ /= g;
+    using wide = typename detail::rational_wide<T>::type;
+
+    // A product of two T values always fits twice the width. For signed T the
+    // sum of two such products does too (each is below 2^(2w-2) in magnitude),
+    // but unsigned products reach 2^(2w) - 2^(w+1) + 1, so their sums and
+    // differences are checked; builtin types without a wider type are checked
+    // throughout
+    static constexpr bool widened = !std::is_same_v<wide, T>;
+    static constexpr bool checked = !widened && std::is_integral_v<T>;
+    static constexpr bool checked_sum = checked || (widened && std::is_unsigned_v<T>);
+
+    T num_, den_;   // lowest terms, den_ > 0
+
+    struct reduced_tag {};
+    stern_brocot(T n, T d, reduced_tag) : num_(std::move(n)), den_(std::move(d)) {}
+
+    static wide mul(const wide& a, const wide& b) {
+        if constexpr (checked) return detail::checked_mul(a, b); else return a * b;
+    }
+    static wide add(const wide& a, const wide& b) {
+        if constexpr (checked_sum) return detail::checked_add(a, b); else return a + b;
+    }
+    static wide sub(const wide& a, const wide& b) {
+        if constexpr (checked_sum) return detail::checked_sub(a, b); else return a - b;
+    }
+    static wide neg(const wide& a) {
+        if constexpr (checked) return detail::checked_neg(a); else return -a;
+    }
+
+    static bool fits(const wide& value) {
+        if constexpr (widened) {
+            return !(value < wide(std::numeric_limits<T>::min()) || value > wide(std::numeric_limits<T>::max()));
+        } else {
+            return true;
+        }
+    }
+
+    static T narrow(const wide& value) {
+        if (!fits(value)) throw std::overflow_error("stern_brocot result does not fit the integer type");
+        return static_cast<T>(value);
+    }
+
+    /// n/d already in lowest terms, d possibly negative
+    static stern_brocot from_reduced(wide n, wide d) {
+        if constexpr (!std::is_unsigned_v<T>) {
+            if (d < wide(0)) {
+                n = neg(n);
+                d = neg(d);
+            }
+        }
+        return stern_brocot(narrow(n), narrow(d), reduced_tag{});
+    }
+
+    /// x / g, skipping the (costly) division in the common case g = 1
+    static T divide(const T& x, const T& g) { return g == T(1) ? x : x / g; }
+
+    // Error-free transforms and bitwise selects for the approximation kernel
+    using rounding = detail::interval_rounding<double>;
+
+    /// x·q - p, correct to one rounding
+    static double residual(double x, double p, double q) {
+        double high, low;
+        rounding::two_product(x, q, high, low);
+        return (high - p) + low;
+    }
+
+    /// ⌊v⌋ for |v| < 2^52, and some value ≥ 2^52 - 2 for larger v; unlike
+    /// std::floor it vectorizes without SSE4.1 or -fno-trapping-math
+    static double lane_floor(double v) {
+        constexpr double shift = 0x1p52;
+        double nearest = (v + shift) - shift;
+        return nearest - rounding::keep_if(nearest > v, 1.0);
+    }
+
+    /// Best approximations of x[0..lanes) ≥ 0 with |x|·max_den < 2^51
+    ///
+    /// Each lane keeps the residuals rₖ = x·qₖ - pₖ of its last two
+    /// convergents, recomputed by TwoProduct rather than by the recurrence,
+    /// so no error accumulates with depth. The floor of the rounded quotient
+    /// -rₖ₋₂/rₖ₋₁ can miss by one next to an integer; the new residual
+    /// (a·rₖ₋₁ + rₖ₋₂, which must be smaller than rₖ₋₁ and of opposite sign)
+    /// detects and corrects that.
+    template<std::size_t lanes>
+    static void approximate_lanes(const double* x, double max_den, double* num, double* den) {
+        double r0[lanes], p0[lanes], q0[lanes], r1[lanes], p1[lanes], q1[lanes];
+        std::uint64_t live[lanes];   // 1 while the lane runs; as wide as a double for the vectorizer
+        for (std::size_t l = 0; l < lanes; ++l) {
+            p0[l] = 0; q0[l] = 1; r0[l] = x[l];   // convergent k - 2
+            p1[l] = 1; q1[l] = 0; r1[l] = -1;     // convergent k - 1
+            live[l] = 1;
+        }
+        // Denominators grow at least like Fibonacci numbers: 80 steps pass 2^51.
+        // A lane stops (and keeps its state) at x = p₁/q₁ or when the next
+        // convergent would pass max_den.
+        for (int step = 0; step < 80; ++step) {
+            std::uint64_t active = 0;
+            for (std::size_t l = 0; l < lanes; ++l) {
+                double a = lane_floor(-r0[l] / r1[l]);
+                double rn = residual(x[l], a * p1[l] + p0[l], a * q1[l] + q0[l]);
+                bool too_large = rn * r1[l] > 0, too_small = !too_large & (std::abs(rn) >= std::abs(r1[l]));
+                a += rounding::keep_if(too_small, 1.0) - rounding::keep_if(too_large, 1.0);
+                double pn = a * p1[l] + p0[l], qn = a * q1[l] + q0[l];
+                rn = residual(x[l], pn, qn);
+
+                bool advance = (live[l] != 0) & (qn <= max_den);
+                p0[l] = advance ? p1[l] : p0[l];
+                q0[l] = advance ? q1[l] : q0[l];
+                r0[l] = advance ? r1[l] : r0[l];
+                p1[l] = advance ? pn : p1[l];
+                q1[l] = advance ? qn : q1[l];
+                r1[l] = advance ? rn : r1[l];
+                live[l] = advance & (rn != 0);
+                active |= live[l];
+            }
+            if (active == 0) break;
+        }
+
+        // At the bound: the largest semiconvergent (t p₁ + p₀)/(t q₁ + q₀)
+        // against the last convergent, |rₛ|/qₛ versus |r₁|/q₁; ties keep the
+        // convergent. A lane that stopped at x itself has r₁ = 0.
+        for (std::size_t l = 0; l < lanes; ++l) {
+            double t = lane_floor((max_den - q0[l]) / q1[l]);
+            double ps = t * p1[l] + p0[l], qs = t * q1[l] + q0[l];
+            bool semi = (r1[l] != 0) & (t > 0) &
+                        (std::abs(residual(x[l], ps, qs)) * q1[l] < std::abs(r1[l]) * qs);
+            num[l] = semi ? ps : p1[l];
+            den[l] = semi ? qs : q1[l];
+        }
+    }
+
+    /// Inputs whose convergents approximate_lanes holds exactly
+    static bool lane_exact(double magnitude, double bound) {
+        constexpr double exact_limit = 0x1p51;
+        return magnitude * bound < exact_limit && bound < exact_limit;
+    }
+
+    /// A lane's convergent num/den (coprime, den ≤ max_den) with x's sign;
+    /// lane_exact bounds num by 2^51, not by T, so narrowing is checked
+    static stern_brocot from_lane(double num, double den, bool negative) {
+        if (num > static_cast<double>(std::numeric_limits<T>::max()) ||
+            (std::is_unsigned_v<T> && negative && num != 0)) {
+            throw std::overflow_error("stern_brocot result does not fit the integer type");
+        }
+        const T n = static_cast<T>(num);
+        return stern_brocot(negative ? T(-n) : n, static_cast<T>(den), reduced_tag{});
+    }
+
+    static stern_brocot reduce(const T& n, const T& d) {
+        if (d == T(0)) throw std::invalid_argument("Denominator cannot be zero");
+        T g = detail::integer_gcd(n, d);
+        if constexpr (std::is_integral_v<T>) {
+            T rn = n, rd = d;
+            if (g != 1) {
+                rn /= g;
+                rd /= g;
+            }
+            if constexpr (std::is_signed_v<T>) {
+                if (rd < 0) {
+                    if (rn == std::numeric_limits<T>::min() || rd == std::numeric_limits<T>::min()) {
+                        throw std::overflow_error("stern_brocot result does not fit the integer type");
+                    }
+                    rn = -rn;
+                    rd = -rd;
+                }
+            }
+            return stern_brocot(rn, rd, reduced_tag{});
+        } else {
+            return from_reduced(divide(n, g), divide(d, g));
         }
-        if (den_ < 0) {
-            num_ = -num_;
-            den_ = -den_;
+    }
+
+    /// a ± b, falling back to the gcd taken before multiplying (Knuth, TAOCP 4.5.1):
+    /// with g = gcd(d₁, d₂), t = n₁·(d₂/g) ± n₂·(d₁/g) and g₂ = gcd(t, g),
+    /// the result (t/g₂) / ((d₁/g)·(d₂/g₂)) is already in lowest terms
+    static stern_brocot sum(const stern_brocot& a, const stern_brocot& b, bool subtract) {
+        if constexpr (std::is_integral_v<T>) {
+            // While the plain cross products fit, one gcd over T is cheapest
+            T left, right, n, d;
+            if (!__builtin_mul_overflow(a.num_, b.den_, &left) && !__builtin_mul_overflow(b.num_, a.den_, &right) &&
+                !(subtract ? __builtin_sub_overflow(left, right, &n) : __builtin_add_overflow(left, right, &n)) &&
+                !__builtin_mul_overflow(a.den_, b.den_, &d)) {
+                return reduce(n, d);
+            }
         }
+        T g = detail::integer_gcd(a.den_, b.den_);
+        T a_scale = divide(b.den_, g), b_scale = divide(a.den_, g);
+        wide left = mul(wide(a.num_), wide(a_scale));
+        wide right = mul(wide(b.num_), wide(b_scale));
+        wide t = subtract ? sub(left, right) : add(left, right);
+        if (t == wide(0)) return stern_brocot();
+        if (g == T(1)) return from_reduced(t, mul(wide(a.den_), wide(b.den_)));
+        // |t mod g| < g, so the second gcd runs on T
+        T g2 = detail::integer_gcd(static_cast<T>(t % wide(g)), g);
+        return from_reduced(t / wide(g2), mul(wide(b_scale), wide(divide(b.den_, g2))));
     }
     
 public:
     // Constructors
     stern_brocot() : num_(0), den_(1) {}
     
-    stern_brocot(T n, T d) : num_(n), den_(d) {
-        if (den_ == 0) throw std::invalid_argument("Denominator cannot be zero");
-        reduce();
-    }
+    /// @throws std::invalid_argument if d is zero
+    /// @throws std::overflow_error if the reduced value is not representable
+    ///         (the most negative n or d of a signed type with d < 0)
+    stern_brocot(T n, T d) : stern_brocot(reduce(n, d)) {}
     
-    explicit stern_brocot(T n) : num_(n), den_(1) {}
+    explicit stern_brocot(T n) : num_(std::move(n)), den_(1) {}
     
     // Getters
     T numerator() const { return num_; }
     T denominator() const { return den_; }
     
     double to_double() const {
-        return static_cast<double>(num_) / den_;
+        return static_cast<double>(static_cast<long double>(num_) / static_cast<long double>(den_));
     }
     
-    // Arithmetic
-    stern_brocot operator+(const stern_brocot& other) const {
-        return stern_brocot(num_ * other.den_ + other.num_ * den_,
-                           den_ * other.den_);
-    }
+    // Arithmetic: exact, in lowest terms, and std::overflow_error instead of
+    // wrapping when the result does not fit in T
+    stern_brocot operator+(const stern_brocot& other) const { return sum(*this, other, false); }
     
-    stern_brocot operator-(const stern_brocot& other) const {
-        return stern_brocot(num_ * other.den_ - other.num_ * den_,
-                           den_ * other.den_);
-    }
+    stern_brocot operator-(const stern_brocot& other) const { return sum(*this, other, true); }
     
     stern_brocot operator*(const stern_brocot& other) const {
-        return stern_brocot(num_ * other.num_, den_ * other.den_);
+        if constexpr (std::is_integral_v<T>) {
+            T n, d;
+            if (!__builtin_mul_overflow(num_, other.num_, &n) && !__builtin_mul_overflow(den_, other.den_, &d)) return reduce(n, d);
+        }
+        // Cross-cancel first: the product of the reduced parts is in lowest terms
+        T g1 = detail::integer_gcd(num_, other.den_);
+        T g2 = detail::integer_gcd(other.num_, den_);
+        return from_reduced(mul(wide(divide(num_, g1)), wide(divide(other.num_, g2))),
+                            mul(wide(divide(den_, g2)), wide(divide(other.den_, g1))));
     }
     
     stern_brocot operator/(const stern_brocot& other) const {
-        if (other.num_ == 0) throw std::invalid_argument("Division by zero");
-        return stern_brocot(num_ * other.den_, den_ * other.num_);
+        if (other.num_ == T(0)) throw std::invalid_argument("Division by zero");
+        if constexpr (std::is_integral_v<T>) {
+            T n, d;
+            if (!__builtin_mul_overflow(num_, other.den_, &n) && !__builtin_mul_overflow(den_, other.num_, &d)) return reduce(n, d);
+        }
+        T g1 = detail::integer_gcd(num_, other.num_);
+        T g2 = detail::integer_gcd(den_, other.den_);
+        return from_reduced(mul(wide(divide(num_, g1)), wide(divide(other.den_, g2))),
+                            mul(wide(divide(den_, g2)), wide(divide(other.num_, g1))));
     }
     
     // Mediant (fundamental Stern-Brocot operation)
     stern_brocot mediant(const stern_brocot& other) const {
-        return stern_brocot(num_ + other.num_, den_ + other.den_);
+        return stern_brocot(narrow(add(wide(num_), wide(other.num_))),
+                            narrow(add(wide(den_), wide(other.den_))));
     }
     
     // Find best rational approximation with denominator ≤ max_den
+    //
+    // Builtin T with |x|·max_den < 2^51 runs the exact double kernel below;
+    // other inputs follow the continued fraction in long double.
+    // Throws std::overflow_error if the best numerator does not fit in T.
     static stern_brocot approximate(double x, T max_den) {
         if (max_den <= 0) {
             throw std::invalid_argument("max_den must be positive");
@@ -103,6 +432,15 @@ public:
         }
         
         bool negative = x < 0;
+        if constexpr (std::is_integral_v<T>) {
+            const double bound = static_cast<double>(max_den);
+            if (lane_exact(std::abs(x), bound)) {
+                double magnitude = std::abs(x), num, den;
+                approximate_lanes<1>(&magnitude, bound, &num, &den);
+                return from_lane(num, den, negative);
+            }
+        }
+
         long double value = std::abs(static_cast<long double>(x));
         const long double epsilon = std::numeric_limits<long double>::epsilon();
         
@@ -114,38 +452,42 @@ public:
         long double cf_value = value;
         
         for (int iterations = 0; iterations < 256; ++iterations) {
-            T a = static_cast<T>(std::floor(cf_value));
-            T next_num = a * curr_num + prev_num;
-            T next_den = a * curr_den + prev_den;
-            
-            if (next_den > max_den) {
-                if (curr_den != 0) {
-                    T t = (max_den - prev_den) / curr_den;
-                    if (t > 0) {
-                        T candidate_num = t * curr_num + prev_num;
-                        T candidate_den = t * curr_den + prev_den;
-                        
-                        long double candidate_val = static_cast<long double>(candidate_num) / candidate_den;
-                        long double current_val = static_cast<long double>(curr_num) / curr_den;
-                        
-                        auto candidate_error = std::abs(value - candidate_val);
-                        auto current_error = std::abs(value - current_val);
-                        
-                        if (candidate_den > 0 && candidate_error < current_error) {
-                            curr_num = candidate_num;
-                            curr_den = candidate_den;
-                        }
+            long double a_value = std::floor(cf_value);
+            if (curr_den != T(0)) {
+                // Compare before multiplying: a huge partial quotient would overflow T
+                T t = (max_den - prev_den) / curr_den;
+                if (a_value > static_cast<long double>(t)) {
+                    // The semiconvergent t is nearer to x than curr exactly
+                    // when cf_value < 2t + prev_den/curr_den
+                    long double scale = static_cast<long double>(curr_den);
+                    if (t > T(0) && cf_value * scale < 2 * static_cast<long double>(t) * scale +
+                                                           static_cast<long double>(prev_den)) {
+                        curr_num = t * curr_num + prev_num;
+                        curr_den = t * curr_den + prev_den;
                     }
+                    break;
                 }
-                break;
             }
+            if constexpr (std::is_integral_v<T>) {
+                if (a_value >= static_cast<long double>(std::numeric_limits<T>::max())) {
+                    throw std::overflow_error("stern_brocot result does not fit the integer type");
+                }
+            }
+            T a = static_cast<T>(a_value);
+            T next_num, next_den;
+            if constexpr (std::is_integral_v<T>) {
+                next_num = detail::checked_add(detail::checked_mul(a, curr_num), prev_num);
+            } else {
+                next_num = a * curr_num + prev_num;
+            }
+            next_den = a * curr_den + prev_den;
             
             prev_num = curr_num;
             prev_den = curr_den;
             curr_num = next_num;
             curr_den = next_den;
             
-            long double remainder = cf_value - static_cast<long double>(a);
+            long double remainder = cf_value - a_value;
             if (std::abs(remainder) <= epsilon) {
                 break;
             }
@@ -162,9 +504,64 @@ public:
         }
         
         auto result = stern_brocot(curr_num, curr_den);
+        if constexpr (std::is_unsigned_v<T>) {
+            if (negative && result.num_ != T(0)) {
+                throw std::overflow_error("stern_brocot result does not fit the integer type");
+            }
+        }
         return negative ? stern_brocot(-result.num_, result.den_) : result;
     }
     
+    /// @brief approximate() for every element; results match the scalar call
+    ///
+    /// Builtin T runs the continued-fraction search on detail::lg_lanes
+    /// inputs at once in double: each lane takes the same (masked) steps, so
+    /// the lane loops vectorize. Doubles hold the convergents exactly while
+    /// |x|·max_den < 2^51; inputs beyond that take the scalar path.
+    /// @throws std::invalid_argument if max_den ≤ 0 or some input is not finite
+    /// @throws std::overflow_error if some best numerator does not fit in T
+    static std::vector<stern_brocot> approximate_many(span<const double> xs, T max_den) {
+        if (max_den <= 0) {
+            throw std::invalid_argument("max_den must be positive");
+        }
+        for (double x : xs) {
+            if (!std::isfinite(x)) throw std::invalid_argument("Cannot approximate NaN or infinity");
+        }
+        std::vector<stern_brocot> result(xs.size());
+        if constexpr (std::is_integral_v<T>) {
+            constexpr std::size_t lanes = detail::lg_lanes;
+            const double bound = static_cast<double>(max_den);
+            double block[lanes], num[lanes], den[lanes];
+            std::size_t where[lanes];
+            std::size_t filled = 0;
+            auto flush = [&] {
+                std::fill(block + filled, block + lanes, 0.0);
+                approximate_lanes<lanes>(block, bound, num, den);
+                for (std::size_t l = 0; l < filled; ++l) {
+                    result[where[l]] = from_lane(num[l], den[l], xs[where[l]] < 0);
+                }
+                filled = 0;
+            };
+            for (std::size_t i = 0; i < xs.size(); ++i) {
+                if (!lane_exact(std::abs(xs[i]), bound)) {
+                    result[i] = approximate(xs[i], max_den);
+                    continue;
+                }
+                block[filled] = std::abs(xs[i]);
+                where[filled] = i;
+                if (++filled == lanes) flush();
+            }
+            if (filled) flush();
+        } else {
+            for (std::size_t i = 0; i < xs.size(); ++i) result[i] = approximate(xs[i], max_den);
+        }
+        return result;
+    }
+
+    static std::vector<stern_brocot> approximate_many(const std::vector<double>& xs, T max_den) {
+        return approximate_many(span<const double>(xs), max_den);
+    }
+
     // Continued fraction representation
     std::vector<T> to_continued_fraction() const {
         std::vector<T> cf;
@@ -180,14 +577,137 @@ public:
         
         return cf;
     }
+
+    /// Continued fraction into an inline buffer (builtin T; no allocation)
+    continued_fraction<T> to_continued_fraction_inline() const {
+        continued_fraction<T> cf;
+        T n = num_, d = den_;
+        while (d != 0) {
+            T q = n / d;
+            cf.push_back(q);
+            T r = n - q * d;
+            n = d;
+            d = r;
+        }
+        return cf;
+    }
+
+    // Stern-Brocot path keys (builtin T)
+    //
+    // The path from 1/1 to |x| is R^{a₀} L^{a₁} R^{a₂} … with the last run
+    // one shorter, for |x| = [a₀; a₁, …, aₙ]. The key is a sign byte (0
+    // negative, 1 zero, 2 positive) followed by each run length as a length
+    // byte and big-endian count. L runs are complemented, since more left
+    // turns mean a smaller value, and a zero-length run closes the key. The
+    // codes are prefix-free, so memcmp (or std::string <) order of keys is
+    // numeric order; a negative value complements its whole path.
+
+    /// Bytes in the longest key
+    static constexpr std::size_t path_key_capacity = 2 + detail::continued_fraction_capacity<T>() * (1 + sizeof(T));
+
+    /// @brief Write the key to out (path_key_capacity bytes); returns its length
+    std::size_t encode_path(unsigned char* out) const {
+        static_assert(std::is_integral_v<T>, "path keys require a builtin integer type");
+        using U = std::make_unsigned_t<T>;
+        std::size_t size = 0;
+        if (num_ == 0) {
+            out[size++] = 1;
+            return size;
+        }
+        const bool negative = num_ < 0;
+        out[size++] = negative ? 0 : 2;
+
+        auto put_run = [&](U count, std::size_t run) {
+            const unsigned char flip = ((run & 1) != 0) != negative ? 0xFF : 0x00;
+            unsigned char bytes[sizeof(U)];
+            std::size_t length = 0;
+            for (; count != 0; count = static_cast<U>(count >> 8)) bytes[length++] = static_cast<unsigned char>(count);
+            out[size++] = static_cast<unsigned char>(length) ^ flip;
+            while (length > 0) out[size++] = bytes[--length] ^ flip;
+        };
+
+        // Euclid on the magnitude; each quotient is one run, the last one shortened
+        U n = detail::unsigned_magnitude(num_), d = static_cast<U>(den_);
+        std::size_t run = 0;
+        while (true) {
+            U q = n / d, r = n % d;
+            if (r == 0) {
+                put_run(static_cast<U>(q - 1), run++);
+                break;
+            }
+            put_run(q, run++);
+            n = d;
+            d = r;
+        }
+        put_run(0, run);
+        return size;
+    }
+
+    /// @brief The key as a std::string (compare with <, or memcmp its bytes)
+    std::string path_key() const {
+        unsigned char buffer[path_key_capacity];
+        std::size_t size = encode_path(buffer);
+        return std::string(reinterpret_cast<const char*>(buffer), size);
+    }
+
+    /// @brief Inverse of encode_path
+    /// @throws std::invalid_argument on a malformed key
+    /// @throws std::overflow_error if the encoded value does not fit in T
+    static stern_brocot from_path_key(span<const unsigned char> key) {
+        static_assert(std::is_integral_v<T>, "path keys require a builtin integer type");
+        using U = std::make_unsigned_t<T>;
+        auto malformed = [] { return std::invalid_argument("malformed Stern-Brocot path key"); };
+        if (key.empty() || key[0] > 2) throw malformed();
+        if (key[0] == 1) {
+            if (key.size() != 1) throw malformed();
+            return stern_brocot();
+        }
+        const bool negative = key[0] == 0;
+
+        U runs[continued_fraction<T>::capacity];
+        std::size_t count = 0, pos = 1;
+        while (true) {
+            const unsigned char flip = ((count & 1) != 0) != negative ? 0xFF : 0x00;
+            if (pos == key.size()) throw malformed();
+            std::size_t length = key[pos++] ^ flip;
+            if (length > sizeof(U) || pos + length > key.size()) throw malformed();
+            if (length == 0 && count > 0) break;   // closing run
+            if (count == continued_fraction<T>::capacity) throw malformed();
+            U value = 0;
+            for (std::size_t i = 0; i < length; ++i) value = static_cast<U>((value << 8) | (key[pos++] ^ flip));
+            runs[count++] = value;
+        }
+        if (pos != key.size()) throw malformed();
+
+        // [a₀; …, aₙ] from the runs, evaluated from the back
+        U n = detail::checked_add(runs[count - 1], U(1)), d = 1;
+        for (std::size_t i = count - 1; i-- > 0;) {
+            U next = detail::checked_add(detail::checked_mul(runs[i], n), d);
+            d = n;
+            n = next;
+        }
+        if (negative) {
+            if (n > detail::unsigned_magnitude(std::numeric_limits<T>::min())) throw malformed();
+            return stern_brocot(static_cast<T>(U(0) - n), static_cast<T>(d), reduced_tag{});
+        }
+        if (n > static_cast<U>(std::numeric_limits<T>::max()) || d > static_cast<U>(std::numeric_limits<T>::max())) {
+            throw malformed();
+        }
+        return stern_brocot(static_cast<T>(n), static_cast<T>(d), reduced_tag{});
+    }
+
+    static stern_brocot from_path_key(const std::string& key) {
+        return from_path_key(span<const unsigned char>(reinterpret_cast<const unsigned char*>(key.data()), key.size()));
+    }
     
     // Comparison
     bool operator==(const stern_brocot& other) const {
-        return num_ * other.den_ == other.num_ * den_;
+        // Lowest terms with a positive denominator is a canonical form
+        return num_ == other.num_ && den_ == other.den_;
     }
     
     bool operator<(const stern_brocot& other) const {
-        return num_ * other.den_ < other.num_ * den_;
+        return mul(wide(num_), wide(other.den_)) < mul(wide(other.num_), wide(den_));
     }
     
     // Output
@@ -0,0 +1,196 @@
+/**
+ * Lazy Stern-Brocot Rationals - Deferred Reduction for Arithmetic Chains
+ *
+ * Transform: stern_brocot<T> → (n, d) with any common factor, d > 0
+ *
+ * Arithmetic is exact in twice the width of T and keeps the unreduced
+ * result while it fits in T; only a result that would not fit is reduced,
+ * with a binary gcd over the wide value. Adding equal denominators is a
+ * numerator addition. Observing the value (numerator(), denominator(),
+ * value(), printing) reduces a copy.
+ *
+ * Trade-off:
+ *   Gain: Accumulation loops pay a gcd only every several operations (or
+ *         never, when denominators repeat) instead of on every one;
+ *         sum() combines tree-wise, so operands grow evenly
+ *   Loss: Stored components can be larger than necessary, so a lazy value
+ *         reaches the reduction threshold sooner than a reduced one; T
+ *         without a double-width type falls back to eager reduction
+ *
+ * Applications:
+ *   - Exact sums of many prices, rates or probabilities
+ *   - Long rational recurrences where only the final value is read
+ */
+
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "span.hpp"
+#include "stern_brocot.hpp"
+
+namespace cbt {
+
+template<typename T>
+class stern_brocot_lazy {
+    static_assert(std::is_integral_v<T>, "stern_brocot_lazy requires a builtin integer type");
+
+private:
+    using wide = typename detail::rational_wide<T>::type;
+    static constexpr bool widened = !std::is_same_v<wide, T>;
+
+    T num_, den_;   // den_ > 0, not necessarily coprime
+
+    struct raw_tag {};
+    stern_brocot_lazy(T n, T d, raw_tag) : num_(n), den_(d) {}
+
+    static bool fits(const wide& value) {
+        return !(value < wide(std::numeric_limits<T>::min()) || value > wide(std::numeric_limits<T>::max()));
+    }
+
+    /// Store n/d unreduced if it fits, otherwise reduce it first
+    static stern_brocot_lazy settle(wide n, wide d) {
+        if constexpr (std::is_signed_v<T>) {
+            if (d < 0) {   // |d| < 2^(2·digits): negation cannot overflow
+                n = -n;
+                d = -d;
+            }
+        }
+        if (!(fits(n) && fits(d))) {
+            wide g = static_cast<wide>(detail::binary_gcd(detail::unsigned_magnitude(n), detail::unsigned_magnitude(d)));
+            n /= g;
+            d /= g;
+            if (!(fits(n) && fits(d))) {
+                throw std::overflow_error("stern_brocot_lazy result does not fit the integer type");
+            }
+        }
+        return stern_brocot_lazy(static_cast<T>(n), static_cast<T>(d), raw_tag{});
+    }
+
+    static wide difference(const wide& left, const wide& right) {
+        if constexpr (std::is_unsigned_v<T>) {
+            if (left < right) throw std::overflow_error("stern_brocot_lazy result does not fit the integer type");
+        }
+        return left - right;
+    }
+
+    static stern_brocot_lazy add_or_subtract(const stern_brocot_lazy& a, const stern_brocot_lazy& b, bool subtract) {
+        if constexpr (widened) {
+            if (a.den_ == b.den_) {   // two T values: the sum is below 2^(w+1)
+                wide n = subtract ? difference(a.num_, b.num_) : wide(a.num_) + wide(b.num_);
+                return settle(n, wide(a.den_));
+            }
+            wide left = wide(a.num_) * wide(b.den_), right = wide(b.num_) * wide(a.den_), n;
+            if (subtract) return settle(difference(left, right), wide(a.den_) * wide(b.den_));
+            // Unsigned cross products reach 2^(2w) - 2^(w+1) + 1, so their sum can
+            // wrap; reduce the operands first and let stern_brocot cancel gcd(d₁, d₂)
+            if (__builtin_add_overflow(left, right, &n)) return stern_brocot_lazy(a.value() + b.value());
+            return settle(n, wide(a.den_) * wide(b.den_));
+        } else {
+            return stern_brocot_lazy(subtract ? a.value() - b.value() : a.value() + b.value());
+        }
+    }
+
+public:
+    // Constructors
+    stern_brocot_lazy() : num_(0), den_(1) {}
+
+    /// @throws std::invalid_argument if d is zero
+    stern_brocot_lazy(T n, T d) : num_(n), den_(d) {
+        if (d == 0) throw std::invalid_argument("Denominator cannot be zero");
+        if constexpr (std::is_signed_v<T>) {
+            if (d < 0) {
+                if constexpr (widened) *this = settle(-wide(n), -wide(d));
+                else *this = stern_brocot_lazy(stern_brocot<T>(n, d));
+            }
+        }
+    }
+
+    explicit stern_brocot_lazy(T n) : num_(n), den_(1) {}
+
+    stern_brocot_lazy(const stern_brocot<T>& value) : num_(value.numerator()), den_(value.denominator()) {}
+
+    /// @brief Exact sum, combining neighbours pairwise (a balanced tree)
+    ///        rather than folding left, with lazy reduction at every node
+    static stern_brocot<T> sum(span<const stern_brocot<T>> values) {
+        // Binary-counter pairwise summation: pending[k] holds the sum of a
+        // block of 2^k inputs, so the stack never exceeds log₂(n) + 1 entries
+        stern_brocot_lazy pending[std::numeric_limits<std::size_t>::digits];
+        std::size_t depth = 0;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            stern_brocot_lazy block = values[i];
+            for (std::size_t merged = i; merged & 1; merged >>= 1) block = pending[--depth] + block;
+            pending[depth++] = block;
+        }
+        stern_brocot_lazy total;
+        while (depth > 0) total = pending[--depth] + total;
+        return total.value();
+    }
+
+    static stern_brocot<T> sum(const std::vector<stern_brocot<T>>& values) {
+        return sum(span<const stern_brocot<T>>(values));
+    }
+
+    // Observation (reduces a copy)
+    stern_brocot<T> value() const { return stern_brocot<T>(num_, den_); }
+    T numerator() const { return value().numerator(); }
+    T denominator() const { return value().denominator(); }
+
+    /// Stored (possibly unreduced) components
+    T raw_numerator() const { return num_; }
+    T raw_denominator() const { return den_; }
+
+    double to_double() const {
+        return static_cast<double>(static_cast<long double>(num_) / static_cast<long double>(den_));
+    }
+
+    // Arithmetic: exact; std::overflow_error only if even the reduced result does not fit
+    stern_brocot_lazy operator+(const stern_brocot_lazy& other) const { return add_or_subtract(*this, other, false); }
+    stern_brocot_lazy operator-(const stern_brocot_lazy& other) const { return add_or_subtract(*this, other, true); }
+
+    stern_brocot_lazy operator*(const stern_brocot_lazy& other) const {
+        if constexpr (widened) {
+            return settle(wide(num_) * wide(other.num_), wide(den_) * wide(other.den_));
+        } else {
+            return stern_brocot_lazy(value() * other.value());
+        }
+    }
+
+    stern_brocot_lazy operator/(const stern_brocot_lazy& other) const {
+        if (other.num_ == 0) throw std::invalid_argument("Division by zero");
+        if constexpr (widened) {
+            return settle(wide(num_) * wide(other.den_), wide(den_) * wide(other.num_));
+        } else {
+            return stern_brocot_lazy(value() / other.value());
+        }
+    }
+
+    stern_brocot_lazy& operator+=(const stern_brocot_lazy& other) { return *this = *this + other; }
+    stern_brocot_lazy& operator-=(const stern_brocot_lazy& other) { return *this = *this - other; }
+    stern_brocot_lazy& operator*=(const stern_brocot_lazy& other) { return *this = *this * other; }
+    stern_brocot_lazy& operator/=(const stern_brocot_lazy& other) { return *this = *this / other; }
+
+    // Comparison (exact without reducing)
+    bool operator==(const stern_brocot_lazy& other) const {
+        if constexpr (widened) {
+            return wide(num_) * wide(other.den_) == wide(other.num_) * wide(den_);
+        } else {
+            return value() == other.value();
+        }
+    }
+
+    bool operator<(const stern_brocot_lazy& other) const {
+        if constexpr (widened) {
+            return wide(num_) * wide(other.den_) < wide(other.num_) * wide(den_);
+        } else {
+            return value() < other.value();
+        }
+    }
+
+    // Output
+    friend std::ostream& operator<<(std::ostream& os, const stern_brocot_lazy& r) { return os << r.value(); }
+};
+
+} // namespace cbt
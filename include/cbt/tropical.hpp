@@ -161,7 +161,16 @@ public:
             }
         }
     }
-    
+
+    // Tropical identity: 0 on the diagonal, ∞ elsewhere (paths of length zero)
+    static tropical_matrix identity() {
+        tropical_matrix result;
+        for (size_t i = 0; i < N; ++i) {
+            result.data_[i][i] = tropical_min<T>::one();
+        }
+        return result;
+    }
+
     // Set edge weight
     void set(size_t i, size_t j, T weight) {
         data_[i][j] = tropical_min<T>(weight);
@@ -0,0 +1,203 @@
+/**
+ * Tropical Matrix Engine - Min-Plus Linear Algebra at Graph Scale
+ *
+ * Transform: shortest paths → matrix powers over (ℝ ∪ {∞}, min, +)
+ * (A ⊗ B)ᵢⱼ = minₖ (Aᵢₖ + Bₖⱼ); (A ⊗ A)ᵢⱼ is the best path with ≤ 2 edges
+ *
+ * tropical_matrix<T, N> (tropical.hpp) is fixed-size and stack-allocated;
+ * tropical_matrix_dyn<T> is its runtime-sized counterpart for large graphs.
+ *
+ * Trade-off:
+ *   Gain: Heap storage of raw values; the GEMM kernel is a branch-free
+ *         min(c, a + b) over contiguous rows (IEEE ∞ absorbs additions, so
+ *         no infinity test), tiled for cache reuse and split across threads
+ *   Loss: All-pairs shortest paths cost O(n³ log n) by repeated squaring,
+ *         versus O(n³) for Floyd-Warshall, in exchange for GEMM throughput
+ *
+ * Applications:
+ *   - All-pairs shortest paths on dense graphs
+ *   - Reachability within k hops
+ *   - Scheduling (max-plus via negated weights)
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cbt {
+
+namespace detail {
+
+/// Tile edge for the k and j loops: a tile of B (tile² values) stays in L2
+constexpr std::size_t tropical_tile = 128;
+
+/// Below this many inner-product terms a product runs on the calling thread
+constexpr std::size_t tropical_parallel_threshold = std::size_t(1) << 21;
+
+/// C[rows] = min(C, A ⊗ B) for rows [row_begin, row_end)
+template<typename T>
+void min_plus_rows(const T* a, const T* b, T* c,
+                   std::size_t row_begin, std::size_t row_end,
+                   std::size_t inner, std::size_t cols) {
+    for (std::size_t kk = 0; kk < inner; kk += tropical_tile) {
+        const std::size_t k_end = std::min(inner, kk + tropical_tile);
+        for (std::size_t jj = 0; jj < cols; jj += tropical_tile) {
+            const std::size_t j_end = std::min(cols, jj + tropical_tile);
+            for (std::size_t i = row_begin; i < row_end; ++i) {
+                const T* a_row = a + i * inner;
+                T* c_row = c + i * cols;
+                for (std::size_t k = kk; k < k_end; ++k) {
+                    const T a_ik = a_row[k];
+                    const T* b_row = b + k * cols;
+                    // Branch-free: ∞ + w = ∞ never wins the min
+                    for (std::size_t j = jj; j < j_end; ++j) {
+                        c_row[j] = std::min(c_row[j], a_ik + b_row[j]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Runtime-sized min-plus matrix
+ * @tparam T Floating-point weight type; +∞ means "no edge"
+ */
+template<typename T>
+class tropical_matrix_dyn {
+    static_assert(std::is_floating_point_v<T>, "tropical requires floating-point type");
+
+private:
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<T> data_;  ///< Row-major raw values
+
+public:
+    using value_type = T;
+
+    static constexpr T infinity() { return std::numeric_limits<T>::infinity(); }
+
+    // Constructors
+    tropical_matrix_dyn() : rows_(0), cols_(0) {}
+
+    /// @brief rows × cols, all tropical zero (∞)
+    tropical_matrix_dyn(std::size_t rows, std::size_t cols)
+        : rows_(rows), cols_(cols), data_(rows * cols, infinity()) {}
+
+    explicit tropical_matrix_dyn(std::size_t n) : tropical_matrix_dyn(n, n) {}
+
+    /// @brief Tropical identity: 0 on the diagonal, ∞ elsewhere
+    static tropical_matrix_dyn identity(std::size_t n) {
+        tropical_matrix_dyn result(n);
+        for (std::size_t i = 0; i < n; ++i) result.set(i, i, T(0));
+        return result;
+    }
+
+    // Element access
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+
+    void set(std::size_t i, std::size_t j, T weight) { data_[i * cols_ + j] = weight; }
+    T get(std::size_t i, std::size_t j) const { return data_[i * cols_ + j]; }
+
+    const T* data() const { return data_.data(); }
+    T* data() { return data_.data(); }
+
+    /**
+     * @brief Min-plus product
+     * @param threads Worker count; 0 uses std::thread::hardware_concurrency()
+     * @details Rows are partitioned across threads, so each writes a
+     * disjoint block of the result; small products stay single-threaded
+     */
+    tropical_matrix_dyn multiply(const tropical_matrix_dyn& other, unsigned threads = 0) const {
+        if (cols_ != other.rows_) {
+            throw std::invalid_argument("tropical matrix dimensions must agree");
+        }
+        tropical_matrix_dyn result(rows_, other.cols_);
+        const T* a = data_.data();
+        const T* b = other.data_.data();
+        T* c = result.data_.data();
+        const std::size_t inner = cols_;
+        const std::size_t cols = other.cols_;
+
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t work = rows_ * inner * cols;
+        std::size_t workers = std::min<std::size_t>(threads, rows_);
+        if (workers <= 1 || work < detail::tropical_parallel_threshold) {
+            detail::min_plus_rows(a, b, c, 0, rows_, inner, cols);
+            return result;
+        }
+
+        std::vector<std::thread> pool;
+        // A std::thread that fails to start must not destroy running ones
+        struct joiner {
+            std::vector<std::thread>& pool;
+            ~joiner() {
+                for (auto& worker : pool) {
+                    if (worker.joinable()) worker.join();
+                }
+            }
+        } join_all{pool};
+        pool.reserve(workers);
+        const std::size_t chunk = (rows_ + workers - 1) / workers;
+        for (std::size_t begin = 0; begin < rows_; begin += chunk) {
+            std::size_t end = std::min(rows_, begin + chunk);
+            pool.emplace_back([=] { detail::min_plus_rows(a, b, c, begin, end, inner, cols); });
+        }
+        for (auto& worker : pool) worker.join();
+        return result;
+    }
+
+    tropical_matrix_dyn operator*(const tropical_matrix_dyn& other) const {
+        return multiply(other);
+    }
+
+    /// @brief Elementwise min (tropical addition)
+    tropical_matrix_dyn operator+(const tropical_matrix_dyn& other) const {
+        if (rows_ != other.rows_ || cols_ != other.cols_) {
+            throw std::invalid_argument("tropical matrix dimensions must agree");
+        }
+        tropical_matrix_dyn result(rows_, cols_);
+        for (std::size_t i = 0; i < data_.size(); ++i) {
+            result.data_[i] = std::min(data_[i], other.data_[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief All-pairs shortest paths by repeated squaring
+     * @details D₀ = A ⊕ I, then Dₖ₊₁ = Dₖ ⊗ Dₖ until paths of n - 1 edges are
+     * covered or the matrix stops changing (at most ⌈log₂(n-1)⌉ products)
+     * @warning Undefined with negative cycles
+     */
+    tropical_matrix_dyn all_pairs_shortest_paths(unsigned threads = 0) const {
+        if (rows_ != cols_) {
+            throw std::invalid_argument("shortest paths need a square matrix");
+        }
+        tropical_matrix_dyn dist = *this;
+        for (std::size_t i = 0; i < rows_; ++i) {
+            dist.set(i, i, std::min(dist.get(i, i), T(0)));
+        }
+        for (std::size_t length = 1; length + 1 < rows_; length *= 2) {
+            tropical_matrix_dyn next = dist.multiply(dist, threads);
+            if (next == dist) break;
+            dist = std::move(next);
+        }
+        return dist;
+    }
+
+    bool operator==(const tropical_matrix_dyn& other) const {
+        return rows_ == other.rows_ && cols_ == other.cols_ && data_ == other.data_;
+    }
+
+    bool operator!=(const tropical_matrix_dyn& other) const { return !(*this == other); }
+};
+
+} // namespace cbt
@@ -0,0 +1,406 @@
+/**
+ * Sparse Tropical Matrices - Semiring Graph Algorithms on CSR
+ *
+ * Transform: graph relaxation → sparse matrix-vector product over a semiring
+ * (A ⊗ x)ᵢ = ⊕ⱼ (Aᵢⱼ ⊗ xⱼ), with (⊕, ⊗) = (min, +) or (max, +)
+ *
+ * One kernel serves both semirings: min-plus gives shortest paths, max-plus
+ * gives longest (critical) paths. Entry (i, j) is the weight of edge i → j.
+ *
+ * Trade-off:
+ *   Gain: O(nnz) per product instead of O(n²); Bellman-Ford is repeated
+ *         SpMV over the transpose with early exit once distances settle
+ *   Loss: Single-source solvers only; for dense all-pairs use
+ *         tropical_matrix_dyn
+ *
+ * Applications:
+ *   - Single-source shortest paths (Bellman-Ford, delta-stepping)
+ *   - Critical path / earliest-start scheduling on DAGs (max-plus)
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "parallel.hpp"
+#include "span.hpp"
+#include "tropical.hpp"
+
+namespace cbt {
+
+namespace detail {
+
+/// Raw-value view of a tropical semiring: zero, one and ⊕
+template<typename S>
+struct tropical_semiring_traits;
+
+template<typename T>
+struct tropical_semiring_traits<tropical_min<T>> {
+    using value_type = T;
+    static constexpr T zero() { return std::numeric_limits<T>::infinity(); }
+    static constexpr T one() { return T(0); }
+    static T plus(T a, T b) { return std::min(a, b); }
+};
+
+template<typename T>
+struct tropical_semiring_traits<tropical_max<T>> {
+    using value_type = T;
+    static constexpr T zero() { return -std::numeric_limits<T>::infinity(); }
+    static constexpr T one() { return T(0); }
+    static T plus(T a, T b) { return std::max(a, b); }
+};
+
+/// Frontiers at least this large generate relaxation requests in parallel
+constexpr std::size_t delta_stepping_parallel_threshold = 1024;
+
+/// Largest bucket ring delta-stepping allocates (heaviest edge / delta)
+constexpr std::size_t delta_stepping_max_buckets = std::size_t(1) << 16;
+
+} // namespace detail
+
+/// @brief Weighted edge from → to, used to build sparse tropical matrices
+template<typename T>
+struct tropical_edge {
+    std::size_t from;
+    std::size_t to;
+    T weight;
+};
+
+/**
+ * @brief CSR matrix over a tropical semiring
+ * @tparam S tropical_min<T> or tropical_max<T>
+ */
+template<typename S>
+class tropical_sparse_matrix {
+public:
+    using semiring = S;
+    using traits = detail::tropical_semiring_traits<S>;
+    using value_type = typename traits::value_type;
+    using edge_type = tropical_edge<value_type>;
+
+private:
+    using T = value_type;
+
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<std::size_t> row_ptr_;   ///< Row i occupies [row_ptr_[i], row_ptr_[i+1])
+    std::vector<std::size_t> col_idx_;
+    std::vector<T> values_;
+
+    void check_vertex(std::size_t v) const {
+        if (v >= rows_ || rows_ != cols_) {
+            throw std::invalid_argument("source must be a vertex of a square matrix");
+        }
+    }
+
+public:
+    // Constructors
+    tropical_sparse_matrix() : rows_(0), cols_(0), row_ptr_(1, 0) {}
+
+    /// @brief Build from an edge list by counting sort on the source vertex
+    /// @details Parallel edges are kept; ⊕ combines them during products
+    tropical_sparse_matrix(std::size_t rows, std::size_t cols, span<const edge_type> edges)
+        : rows_(rows), cols_(cols), row_ptr_(rows + 1, 0),
+          col_idx_(edges.size()), values_(edges.size()) {
+        for (const auto& e : edges) {
+            if (e.from >= rows || e.to >= cols) {
+                throw std::invalid_argument("edge endpoint out of range");
+            }
+            ++row_ptr_[e.from + 1];
+        }
+        for (std::size_t i = 0; i < rows; ++i) row_ptr_[i + 1] += row_ptr_[i];
+        std::vector<std::size_t> cursor(row_ptr_.begin(), row_ptr_.end() - 1);
+        for (const auto& e : edges) {
+            std::size_t slot = cursor[e.from]++;
+            col_idx_[slot] = e.to;
+            values_[slot] = e.weight;
+        }
+    }
+
+    tropical_sparse_matrix(std::size_t rows, std::size_t cols, const std::vector<edge_type>& edges)
+        : tropical_sparse_matrix(rows, cols, span<const edge_type>(edges)) {}
+
+    /// @brief Square matrix for a graph on n vertices
+    tropical_sparse_matrix(std::size_t n, const std::vector<edge_type>& edges)
+        : tropical_sparse_matrix(n, n, span<const edge_type>(edges)) {}
+
+    // Getters
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t nnz() const { return values_.size(); }
+    const std::vector<std::size_t>& row_ptr() const { return row_ptr_; }
+    const std::vector<std::size_t>& col_idx() const { return col_idx_; }
+    const std::vector<T>& values() const { return values_; }
+
+    /// @brief Aᵀ: edge i → j becomes j → i
+    tropical_sparse_matrix transpose() const {
+        std::vector<edge_type> edges;
+        edges.reserve(nnz());
+        for (std::size_t i = 0; i < rows_; ++i) {
+            for (std::size_t p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+                edges.push_back({col_idx_[p], i, values_[p]});
+            }
+        }
+        return tropical_sparse_matrix(cols_, rows_, span<const edge_type>(edges));
+    }
+
+    /// @brief y = A ⊗ x, i.e. yᵢ = ⊕ⱼ (Aᵢⱼ + xⱼ)
+    /// @details Branch-free per row: the semiring zero (±∞) absorbs + and
+    /// never wins ⊕, so missing entries need no test
+    std::vector<T> multiply(span<const T> x) const {
+        if (x.size() != cols_) {
+            throw std::invalid_argument("vector size must match matrix columns");
+        }
+        std::vector<T> y(rows_);
+        for (std::size_t i = 0; i < rows_; ++i) {
+            T acc = traits::zero();
+            for (std::size_t p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+                acc = traits::plus(acc, values_[p] + x[col_idx_[p]]);
+            }
+            y[i] = acc;
+        }
+        return y;
+    }
+
+    std::vector<T> multiply(const std::vector<T>& x) const { return multiply(span<const T>(x)); }
+
+    /**
+     * @brief Single-source paths as repeated SpMV: d ← d ⊕ (Aᵀ ⊗ d)
+     * @details Stops as soon as an iteration changes nothing, so graphs of
+     * small diameter converge in a few products
+     * @throws std::runtime_error if a cycle keeps improving paths
+     * (negative for min-plus, positive for max-plus)
+     */
+    std::vector<T> bellman_ford(std::size_t source) const {
+        check_vertex(source);
+        const tropical_sparse_matrix incoming = transpose();
+        std::vector<T> dist(rows_, traits::zero());
+        dist[source] = traits::one();
+        for (std::size_t iteration = 0; iteration < rows_; ++iteration) {
+            std::vector<T> next = incoming.multiply(dist);
+            for (std::size_t i = 0; i < rows_; ++i) next[i] = traits::plus(next[i], dist[i]);
+            if (next == dist) return dist;
+            dist = std::move(next);
+        }
+        throw std::runtime_error("cycle improves path weights without bound");
+    }
+
+    /**
+     * @brief Single-source paths on a DAG in one topological sweep
+     * @throws std::runtime_error if the graph has a cycle
+     */
+    std::vector<T> dag_paths(std::size_t source) const {
+        check_vertex(source);
+        std::vector<T> dist(rows_, traits::zero());
+        dist[source] = traits::one();
+        for (std::size_t u : topological_order()) {
+            for (std::size_t p = row_ptr_[u]; p < row_ptr_[u + 1]; ++p) {
+                std::size_t v = col_idx_[p];
+                dist[v] = traits::plus(dist[v], dist[u] + values_[p]);
+            }
+        }
+        return dist;
+    }
+
+    /// @brief Kahn's algorithm over the CSR rows
+    /// @throws std::runtime_error if the graph has a cycle
+    std::vector<std::size_t> topological_order() const {
+        if (rows_ != cols_) {
+            throw std::invalid_argument("topological order needs a square matrix");
+        }
+        std::vector<std::size_t> in_degree(rows_, 0);
+        for (std::size_t c : col_idx_) ++in_degree[c];
+        std::vector<std::size_t> order;
+        order.reserve(rows_);
+        for (std::size_t v = 0; v < rows_; ++v) {
+            if (in_degree[v] == 0) order.push_back(v);
+        }
+        for (std::size_t head = 0; head < order.size(); ++head) {
+            std::size_t u = order[head];
+            for (std::size_t p = row_ptr_[u]; p < row_ptr_[u + 1]; ++p) {
+                if (--in_degree[col_idx_[p]] == 0) order.push_back(col_idx_[p]);
+            }
+        }
+        if (order.size() != rows_) {
+            throw std::runtime_error("graph has a cycle");
+        }
+        return order;
+    }
+};
+
+/**
+ * @brief Delta-stepping single-source shortest paths (min-plus)
+ *
+ * Vertices are kept in buckets of width delta. Each bucket relaxes its light
+ * edges (w ≤ delta) until it empties, then its heavy edges once. Queued
+ * distances lie within the heaviest edge of the current bucket, so the
+ * buckets form a ring of about heaviest / delta entries. Within a phase,
+ * the threads of one thread_pool, kept for the whole run, scan disjoint
+ * slices of the frontier against a read-only distance array and write
+ * relaxation requests to per-slice buffers; the requests are applied
+ * afterwards, so no locking or atomics are needed and the result is
+ * deterministic.
+ *
+ * @param delta Bucket width; around the average edge weight is a good start
+ * @param threads Worker count; 0 uses std::thread::hardware_concurrency()
+ * @throws std::invalid_argument on negative weights, non-positive delta, or
+ *         a delta below heaviest edge / detail::delta_stepping_max_buckets
+ */
+template<typename T>
+std::vector<T> delta_stepping(const tropical_sparse_matrix<tropical_min<T>>& graph,
+                              std::size_t source, T delta, unsigned threads = 0) {
+    const std::size_t n = graph.rows();
+    if (source >= n || graph.rows() != graph.cols()) {
+        throw std::invalid_argument("source must be a vertex of a square matrix");
+    }
+    if (!(delta > 0)) {
+        throw std::invalid_argument("delta must be positive");
+    }
+    const auto& row_ptr = graph.row_ptr();
+    const auto& col_idx = graph.col_idx();
+    const auto& weights = graph.values();
+    T heaviest = 0;   // infinite weights never relax anything
+    for (T w : weights) {
+        if (w < 0) throw std::invalid_argument("delta-stepping requires non-negative weights");
+        if (w < std::numeric_limits<T>::infinity()) heaviest = std::max(heaviest, w);
+    }
+    const T reach = std::floor(heaviest / delta);
+    if (!(reach < T(detail::delta_stepping_max_buckets))) {
+        throw std::invalid_argument("delta is too small for the edge weights");
+    }
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    using request = std::pair<std::size_t, T>;
+    std::vector<T> dist(n, std::numeric_limits<T>::infinity());
+    // A relaxation from bucket b lands at most reach + 1 buckets ahead; one
+    // more slot absorbs rounding in d / delta, so no slot is shared
+    const std::size_t ring = static_cast<std::size_t>(reach) + 3;
+    std::vector<std::vector<std::size_t>> buckets(ring);
+    std::size_t queued = 0;
+    auto bucket_of = [delta](T d) { return static_cast<std::size_t>(std::floor(d / delta)); };
+
+    auto relax = [&](const std::vector<request>& requests) {
+        for (const auto& r : requests) {
+            if (r.second < dist[r.first]) {
+                dist[r.first] = r.second;
+                buckets[bucket_of(r.second) % ring].push_back(r.first);
+                ++queued;
+            }
+        }
+    };
+
+    auto scan = [&](const std::vector<std::size_t>& frontier, bool light,
+                    std::size_t begin, std::size_t end, std::vector<request>& out) {
+        for (std::size_t f = begin; f < end; ++f) {
+            std::size_t u = frontier[f];
+            for (std::size_t p = row_ptr[u]; p < row_ptr[u + 1]; ++p) {
+                if ((weights[p] <= delta) == light) {
+                    T candidate = dist[u] + weights[p];
+                    if (candidate < dist[col_idx[p]]) out.push_back({col_idx[p], candidate});
+                }
+            }
+        }
+    };
+
+    // One pool for every phase, started by the first large frontier; bulk()
+    // rethrows a slice's exception (e.g. bad_alloc) after all slices finish
+    std::unique_ptr<thread_pool> pool;
+    auto generate = [&](const std::vector<std::size_t>& frontier, bool light) {
+        std::size_t workers = std::min<std::size_t>(threads, frontier.size());
+        if (workers <= 1 || frontier.size() < detail::delta_stepping_parallel_threshold) {
+            std::vector<request> requests;
+            scan(frontier, light, 0, frontier.size(), requests);
+            relax(requests);
+            return;
+        }
+        if (!pool) pool = std::make_unique<thread_pool>(threads);
+        std::vector<std::vector<request>> local(workers);
+        const std::size_t chunk = (frontier.size() + workers - 1) / workers;
+        pool->bulk(workers, [&](std::size_t w) {
+            std::size_t begin = std::min(frontier.size(), w * chunk);
+            std::size_t end = std::min(frontier.size(), begin + chunk);
+            scan(frontier, light, begin, end, local[w]);
+        });
+        for (const auto& requests : local) relax(requests);
+    };
+
+    dist[source] = T(0);
+    buckets[0].push_back(source);
+    queued = 1;
+    std::vector<char> settled_mark(n, 0);
+    for (std::size_t b = 0; queued > 0; ++b) {
+        auto& bucket = buckets[b % ring];
+        std::vector<std::size_t> settled;
+        while (!bucket.empty()) {
+            std::vector<std::size_t> frontier;
+            frontier.swap(bucket);
+            queued -= frontier.size();
+            // Drop stale entries whose distance has since moved to a lower bucket
+            frontier.erase(std::remove_if(frontier.begin(), frontier.end(),
+                                          [&](std::size_t v) { return bucket_of(dist[v]) != b; }),
+                           frontier.end());
+            for (std::size_t v : frontier) {
+                if (!settled_mark[v]) {
+                    settled_mark[v] = 1;
+                    settled.push_back(v);
+                }
+            }
+            generate(frontier, true);
+        }
+        generate(settled, false);
+    }
+    return dist;
+}
+
+/// @brief Earliest start times and one longest path of a DAG schedule
+template<typename T>
+struct critical_path_result {
+    std::vector<T> earliest_start;   ///< Longest path weight from any source
+    T length;                        ///< Makespan: max earliest_start
+    std::vector<std::size_t> path;   ///< Vertices of one critical path, in order
+};
+
+/**
+ * @brief Critical path of a task DAG in the max-plus semiring
+ * @details Edge weights are precedence lags (e.g. the duration of the
+ * predecessor). No task starts before 0, so earliest_start is
+ * max(0, ⊕ over predecessors); one sweep in topological order computes all.
+ * @throws std::runtime_error if the graph has a cycle
+ */
+template<typename T>
+critical_path_result<T> critical_path(const tropical_sparse_matrix<tropical_max<T>>& graph) {
+    const std::size_t n = graph.rows();
+    const auto& row_ptr = graph.row_ptr();
+    const auto& col_idx = graph.col_idx();
+    const auto& weights = graph.values();
+    constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    critical_path_result<T> result{std::vector<T>(n, T(0)), T(0), {}};
+    if (n == 0) return result;
+    std::vector<std::size_t> predecessor(n, none);
+    for (std::size_t u : graph.topological_order()) {
+        for (std::size_t p = row_ptr[u]; p < row_ptr[u + 1]; ++p) {
+            std::size_t v = col_idx[p];
+            T candidate = result.earliest_start[u] + weights[p];
+            if (candidate > result.earliest_start[v]) {
+                result.earliest_start[v] = candidate;
+                predecessor[v] = u;
+            }
+        }
+    }
+    std::size_t end = static_cast<std::size_t>(
+        std::max_element(result.earliest_start.begin(), result.earliest_start.end()) -
+        result.earliest_start.begin());
+    result.length = result.earliest_start[end];
+    for (std::size_t v = end; v != none; v = predecessor[v]) result.path.push_back(v);
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
+
+} // namespace cbt
@@ -3,10 +3,20 @@
  * Covers all transforms with edge cases and error conditions
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <limits>
+#include <random>
+#include <string>
+#include <thread>
 #include <vector>
 #include "../include/cbt/cbt.hpp"
 
@@ -73,6 +83,158 @@ void test_logarithmic_comprehensive() {
     auto fourth_root = sixteen.pow(0.25);
     assert(approx_equal(fourth_root.value(), 2.0));
     
+    // Log-domain addition
+    auto sum = a + b;
+    assert(approx_equal(sum.value(), 5.0));
+    auto doubled = a + a;
+    assert(approx_equal(doubled.value(), 4.0));
+    assert(approx_equal((a + lgd()).value(), 2.0));  // lg() is zero
+    assert(std::isinf((lgd() + lgd()).log()) && (lgd() + lgd()).log() < 0);
+    
+    // Addition far below the double range stays exact in log space
+    auto tiny_a = lgd::from_log(-2000.0);
+    auto tiny_sum = tiny_a + tiny_a;
+    assert(approx_equal(tiny_sum.log(), -2000.0 + std::log(2.0)));
+    
+    // Batched log-sum-exp
+    std::vector<lgd> terms;
+    double expected = 0;
+    for (int i = 1; i <= 1001; ++i) {
+        terms.push_back(lgd(i * 0.5));
+        expected += i * 0.5;
+    }
+    assert(approx_equal(lg_sum(terms).value(), expected, 1e-7));
+    assert(std::isinf(lg_sum(std::vector<lgd>{}).log()));
+    
+    std::vector<lgd> underflowing(100000, lgd::from_log(-1000.0));
+    assert(approx_equal(lg_sum(underflowing).log(), -1000.0 + std::log(100000.0), 1e-9));
+    
+    // Streaming accumulator agrees with the two-pass kernel
+    lg_accumulator<double> acc;
+    acc.add(span<const lgd>(terms.data(), 500));
+    for (size_t i = 500; i < terms.size(); ++i) acc.add(terms[i]);
+    assert(approx_equal(acc.result().log(), lg_sum(terms).log()));
+    acc.add(lgd::from_log(std::numeric_limits<double>::infinity()));
+    assert(std::isinf(acc.result().log()) && acc.result().log() > 0);
+    acc.reset();
+    assert(std::isinf(acc.result().log()) && acc.result().log() < 0);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= CONSTEXPR MATH TESTS =============
+void test_cmath_comprehensive() {
+    std::cout << "Testing constexpr math (comprehensive)... ";
+    constexpr double inf = std::numeric_limits<double>::infinity();
+
+    // Special values, evaluated by the compiler
+    static_assert(cmath::exp(0.0) == 1 && cmath::log(1.0) == 0, "");
+    static_assert(cmath::exp(710.0) == inf && cmath::exp(-746.0) == 0, "");
+    static_assert(cmath::exp(-745.0) == std::numeric_limits<double>::denorm_min(), "");
+    static_assert(cmath::log(0.0) == -inf && cmath::isnan(cmath::log(-1.0)), "");
+    static_assert(cmath::log1p(1e-20) == 1e-20 && cmath::expm1(1e-20) == 1e-20, "");
+    static_assert(cmath::log1p(-1.0) == -inf && cmath::expm1(-inf) == -1, "");
+    static_assert(cmath::pow(-2.0, 3.0) == -8 && cmath::pow(10.0, 22.0) == 1e22, "");
+    static_assert(cmath::pow(2.0, -1074.0) == std::numeric_limits<double>::denorm_min(), "");
+    static_assert(cmath::isnan(cmath::pow(-2.0, 0.5)) && cmath::pow(-1.0, inf) == 1, "");
+
+    // constexpr transforms are constant-evaluable
+    constexpr lgd two(2.0);
+    constexpr lgd sum = two + lgd(3.0);
+    static_assert(sum.value() > 4.999999999999 && sum.value() < 5.000000000001, "");
+    constexpr auto prior = log_odds<double>::from_probability(0.2);
+    static_assert(prior.to_probability() > 0.199999999999 && prior.to_probability() < 0.200000000001, "");
+    static_assert(odds_ratio<double>(std::numeric_limits<double>::infinity()).to_probability() == 1, "");
+    static_assert(ntt998::primitive_root().value() == 3, "");
+
+    // A compile-time table agrees with the runtime libm to within one ulp
+    constexpr std::size_t n = 64;
+    constexpr auto table = [] {
+        std::array<double, 4 * n> t{};
+        for (std::size_t i = 0; i < n; ++i) {
+            double x = 0.37 * double(i) - 11.0;
+            t[4 * i] = cmath::exp(x);
+            t[4 * i + 1] = cmath::log(x * x + 1e-300);
+            t[4 * i + 2] = cmath::log1p(x / 16);
+            t[4 * i + 3] = cmath::pow(1.5, x);
+        }
+        return t;
+    }();
+    auto within_ulp = [](double a, double b) { return std::abs(a - b) <= std::abs(b) * 2.3e-16; };
+    for (std::size_t i = 0; i < n; ++i) {
+        double x = 0.37 * double(i) - 11.0;
+        assert(within_ulp(table[4 * i], std::exp(x)));
+        assert(within_ulp(table[4 * i + 1], std::log(x * x + 1e-300)));
+        assert(within_ulp(table[4 * i + 2], std::log1p(x / 16)));
+        assert(within_ulp(table[4 * i + 3], std::pow(1.5, x)));
+    }
+
+    // At run time the same calls go to <cmath>
+    volatile double runtime = 7.25;
+    assert(cmath::log(runtime) == std::log(7.25));
+    assert(cmath::exp(runtime) == std::exp(7.25));
+
+    std::cout << "PASSED\n";
+}
+
+// ============= LG_VECTOR (SoA) TESTS =============
+void test_lg_vector_comprehensive() {
+    std::cout << "Testing lg_vector batched kernels (comprehensive)... ";
+    
+    std::vector<double> pa, pb, pc;
+    for (int i = 1; i <= 37; ++i) {
+        pa.push_back(i * 1e-3);
+        pb.push_back(1.0 / (i + 1));
+        pc.push_back(0.5 + i * 1e-2);
+    }
+    lg_vector<double> a(pa), b(pb), c(pc);
+    assert(a.size() == 37);
+    assert(approx_equal(a[4].value(), 5e-3));
+    
+    // Fused a*b/c in one pass
+    lg_vector<double> r = a * b / c;
+    for (size_t i = 0; i < r.size(); ++i) {
+        assert(approx_equal(r[i].value(), pa[i] * pb[i] / pc[i], 1e-15));
+    }
+    
+    // Scalar broadcast and power
+    lg_vector<double> scaled = pow(a, 2.0) * lgd(4.0);
+    for (size_t i = 0; i < scaled.size(); ++i) {
+        assert(approx_equal(scaled[i].value(), 4 * pa[i] * pa[i], 1e-12));
+    }
+    
+    // Reductions
+    double expected_product = 1, expected_dot = 0, expected_sum = 0;
+    for (size_t i = 0; i < pa.size(); ++i) {
+        expected_product *= pa[i] * pb[i];
+        expected_dot += pa[i] * pb[i];
+        expected_sum += pa[i];
+    }
+    assert(approx_equal(reduce_product(a * b).log(), std::log(expected_product), 1e-9));
+    assert(approx_equal(dot(a, b).value(), expected_dot, 1e-12));
+    assert(approx_equal(a.sum().value(), expected_sum, 1e-12));
+    assert(approx_equal(a.product().log(), reduce_product(a).log()));
+    
+    // Products that underflow doubles stay finite in log space
+    lg_vector<double> tiny(std::vector<double>(100000, 1e-10));
+    assert(approx_equal(tiny.product().log(), 100000 * std::log(1e-10), 1e-3));
+    
+    // Non-positive inputs map to lg zero; inverse transform round-trips
+    lg_vector<double> with_zero(std::vector<double>{0.0, -1.0, 2.0});
+    assert(std::isinf(with_zero.log_at(0)) && std::isinf(with_zero.log_at(1)));
+    auto back = with_zero.to_values();
+    assert(back[0] == 0.0 && back[1] == 0.0 && approx_equal(back[2], 2.0));
+    
+    // Size mismatch is rejected when the expression is built
+    bool threw = false;
+    try {
+        lg_vector<double> bad = a * with_zero;
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
     std::cout << "PASSED\n";
 }
 
@@ -183,6 +345,333 @@ void test_stern_brocot_comprehensive() {
     std::cout << "PASSED\n";
 }
 
+void test_stern_brocot_overflow_comprehensive() {
+    std::cout << "Testing stern_brocot overflow safety (comprehensive)... ";
+    
+    // Denominators near 3·10⁹: the cross products overflow int64_t, the result does not
+    stern_brocot<int64_t> a(1, 3000000019LL);
+    stern_brocot<int64_t> b(1, 3000000037LL);
+    auto sum = a + b;
+    assert(sum.numerator() == 6000000056LL && sum.denominator() == 9000000168000000703LL);
+    auto diff = a - b;
+    assert(diff.numerator() == 18 && diff.denominator() == 9000000168000000703LL);
+    
+    // Shared factors cancel before multiplying
+    const int64_t p = 3000000019LL, q = 3000000037LL;
+    auto cancel = stern_brocot<int64_t>(p, q) * stern_brocot<int64_t>(q, p);
+    assert(cancel.numerator() == 1 && cancel.denominator() == 1);
+    auto same_den = stern_brocot<int64_t>(1, p * 3) + stern_brocot<int64_t>(2, p * 3);
+    assert(same_den.numerator() == 1 && same_den.denominator() == p);
+    auto ratio = stern_brocot<int64_t>(p, q) / stern_brocot<int64_t>(p, 2 * q);
+    assert(ratio.numerator() == 2 && ratio.denominator() == 1);
+    
+    // Comparison widens instead of overflowing: n/(n+2) increases with n
+    stern_brocot<int64_t> c(4000000001LL, 4000000003LL);
+    stern_brocot<int64_t> d(4000000003LL, 4000000005LL);
+    assert(c < d && !(d < c) && !(c == d));
+    assert(stern_brocot<int64_t>(2 * p, 2 * q) == stern_brocot<int64_t>(p, q));
+    
+    // 32-bit types widen to 64 bits
+    auto narrow = stern_brocot<int32_t>(46341, 46343) * stern_brocot<int32_t>(46343, 46341);
+    assert(narrow.numerator() == 1 && narrow.denominator() == 1);
+    assert((stern_brocot<int32_t>(2147483645, 2147483646) < stern_brocot<int32_t>(2147483646, 2147483647)));
+    
+    // A result that does not fit is reported, never wrapped
+    bool threw = false;
+    try {
+        auto bad = stern_brocot<int64_t>(1, 4000000007LL) + stern_brocot<int64_t>(1, 4000000009LL);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    threw = false;
+    try {
+        stern_brocot<int32_t> bad(std::numeric_limits<int32_t>::min(), -1);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    threw = false;
+    try {
+        auto bad = stern_brocot<uint32_t>(1, 3) - stern_brocot<uint32_t>(1, 2);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Unsigned cross products near 2^128 are summed with a checked add
+    threw = false;
+    try {
+        auto bad = stern_brocot<uint64_t>(18446744073709551556ULL, 18446744073709551557ULL) +
+                   stern_brocot<uint64_t>(18446744073709551532ULL, 18446744073709551533ULL);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+void test_stern_brocot_lazy_comprehensive() {
+    std::cout << "Testing stern_brocot_lazy deferred reduction (comprehensive)... ";
+    
+    // Binary gcd agrees with std::gcd, including 128-bit operands
+    std::mt19937_64 gen(42);
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t a = gen() >> (gen() % 64), b = gen() >> (gen() % 64);
+        assert(detail::binary_gcd(a, b) == std::gcd(a, b));
+    }
+    assert(detail::integer_gcd(std::numeric_limits<int64_t>::min(), int64_t(6)) == 2);
+    
+    // Results stay unreduced while they fit, and compare exactly
+    using lazy = stern_brocot_lazy<int64_t>;
+    lazy half(2, 4), third(1, 3);
+    assert(half.raw_numerator() == 2 && half.raw_denominator() == 4);
+    assert(half.numerator() == 1 && half.denominator() == 2);
+    auto sum = half + third;
+    assert(sum.raw_denominator() == 12 && sum == lazy(5, 6));
+    assert(third < half && !(half < third));
+    assert((half - third).value() == (stern_brocot<int64_t>(1, 6)));
+    assert((half * third).value() == (stern_brocot<int64_t>(1, 6)));
+    assert((half / third).value() == (stern_brocot<int64_t>(3, 2)));
+    assert(lazy(3, -6).value() == (stern_brocot<int64_t>(-1, 2)));
+    
+    // Equal denominators accumulate without growing
+    lazy cents(0, 100);
+    for (int i = 0; i < 1000; ++i) cents += lazy(7, 100);
+    assert(cents.raw_denominator() == 100 && cents.value() == (stern_brocot<int64_t>(70, 1)));
+    
+    // A result beyond int64_t is reduced instead of wrapping...
+    lazy big(3000000019LL * 4, 3000000037LL * 4);
+    auto square = big * big;
+    assert(square.value() == (stern_brocot<int64_t>(3000000019LL, 3000000037LL) *
+                              stern_brocot<int64_t>(3000000019LL, 3000000037LL)));
+    // ...and reported when even the reduced value does not fit
+    bool threw = false;
+    try {
+        auto bad = lazy(1, 4000000007LL) + lazy(1, 4000000009LL);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Unsigned cross products whose sum wraps the wide type are reduced first
+    using lazy32 = stern_brocot_lazy<uint32_t>;
+    auto two = lazy32(4294967294u, 4294967294u) + lazy32(4294967292u, 4294967292u);
+    assert(two.value() == (stern_brocot<uint32_t>(2)));
+    auto one = lazy32(4294967294u, 4294967295u) + lazy32(1u, 4294967295u);
+    assert(one.value() == (stern_brocot<uint32_t>(1)));
+    threw = false;
+    try {
+        auto bad = lazy32(4294963816u, 4294965991u) + lazy32(4294963218u, 4294965208u);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Tree-wise sum matches the eager left fold for every size
+    const int64_t dens[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 25, 100, 360, 1000};
+    std::vector<stern_brocot<int64_t>> values;
+    for (std::size_t n : {0, 1, 2, 3, 7, 64, 1000, 20001}) {
+        values.clear();
+        stern_brocot<int64_t> eager;
+        for (std::size_t i = 0; i < n; ++i) {
+            values.emplace_back(static_cast<int64_t>(gen() % 2001) - 1000, dens[gen() % 16]);
+            eager = eager + values.back();
+        }
+        assert(lazy::sum(values) == eager);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+void test_stern_brocot_batch_comprehensive() {
+    std::cout << "Testing stern_brocot batched approximation and path keys (comprehensive)... ";
+    using sb = stern_brocot<int64_t>;
+    
+    // Batched results match the scalar call, including signs, zero and ties
+    std::vector<double> xs = {3.141592653589793, -3.141592653589793, 0.0, 0.2, 2.5, 1e-300, 3.75,
+                              212019.12984911454, 1e12, -7.0};
+    std::mt19937_64 gen(23);
+    std::uniform_real_distribution<double> wide(-1e4, 1e4);
+    for (int i = 0; i < 2000; ++i) xs.push_back(i % 2 ? wide(gen) : wide(gen) / 1e4);
+    for (int64_t max_den : {int64_t(1), int64_t(100), int64_t(1000000), int64_t(1) << 40}) {
+        auto batch = sb::approximate_many(xs, max_den);
+        assert(batch.size() == xs.size());
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            assert(batch[i] == sb::approximate(xs[i], max_den));
+            assert(batch[i].denominator() <= max_den);
+        }
+    }
+    assert(sb::approximate_many(xs, 1000)[0] == sb(355, 113));
+    assert(sb::approximate_many(xs, 1000)[3] == sb(1, 5));
+    assert(sb::approximate(2.5, 1) == sb(2));   // tie keeps the convergent
+    // The semiconvergent wins although both errors are below ulp(x)
+    assert(sb::approximate(212019.12984911454, 1000000) == sb(210030178392LL, 990619));
+    
+    // The double kernel's numerator is checked against a narrow T
+    using sb32 = stern_brocot<int32_t>;
+    for (bool batched : {false, true}) {
+        bool threw = false;
+        try {
+            if (batched) sb32::approximate_many(std::vector<double>{0.5, 3e9 + 0.5}, 10);
+            else sb32::approximate(3e9 + 0.5, 10);
+        } catch (const std::overflow_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(sb32::approximate(-2e9 - 0.25, 1) == sb32(-2000000000));   // near the limit, still fits
+    bool unsigned_threw = false;
+    try { stern_brocot<uint32_t>::approximate(-0.5, 10); } catch (const std::overflow_error&) { unsigned_threw = true; }
+    assert(unsigned_threw);
+    
+    // No fraction with a denominator ≤ 100 is nearer
+    for (std::size_t i = 10; i < 210; ++i) {
+        sb best = sb::approximate(xs[i], 100);
+        long double x = xs[i];
+        long double error = std::abs(x - static_cast<long double>(best.numerator()) / best.denominator());
+        for (int64_t q = 1; q <= 100; ++q) {
+            long double p = std::round(x * q);
+            assert(std::abs(x - p / q) >= error);
+        }
+    }
+    
+    // A huge partial quotient is compared before it is multiplied
+    assert(stern_brocot<int32_t>::approximate(3.000000001, 7) == (stern_brocot<int32_t>(3)));
+    bool threw = false;
+    try {
+        auto bad = sb::approximate(1e300, 7);
+        (void)bad;
+    } catch (const std::overflow_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        auto bad = sb::approximate_many(std::vector<double>{1.0, std::nan("")}, 10);
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Inline continued fractions, up to the longest int64_t expansion (F₉₂/F₉₁)
+    int64_t fib_prev = 1, fib = 1;
+    for (int i = 0; i < 90; ++i) {
+        int64_t next = fib + fib_prev;
+        fib_prev = fib;
+        fib = next;
+    }
+    std::vector<sb> samples = {sb(fib, fib_prev), sb(-fib_prev, fib), sb(0), sb(1), sb(-1), sb(7),
+                               sb(1, 1000), sb(-1, 1000), sb(std::numeric_limits<int64_t>::max()),
+                               sb(std::numeric_limits<int64_t>::min()), sb(1, std::numeric_limits<int64_t>::max())};
+    for (int i = 0; i < 500; ++i) {
+        samples.emplace_back(static_cast<int64_t>(gen() >> (gen() % 64)) * (i % 2 ? 1 : -1),
+                             static_cast<int64_t>((gen() >> (gen() % 64)) | 1) >> 1 | 1);
+    }
+    for (const auto& value : samples) {
+        auto cf = value.to_continued_fraction_inline();
+        auto expected = value.to_continued_fraction();
+        assert(cf.size() == expected.size());
+        for (std::size_t i = 0; i < cf.size(); ++i) assert(cf[i] == expected[i]);
+    }
+    assert(samples[0].to_continued_fraction_inline().size() == 90);
+    
+    // Path keys round-trip and sort in numeric order
+    std::vector<std::pair<std::string, sb>> keyed;
+    for (const auto& value : samples) {
+        std::string key = value.path_key();
+        assert(key.size() <= sb::path_key_capacity);
+        assert(sb::from_path_key(key) == value);
+        keyed.emplace_back(key, value);
+    }
+    std::sort(keyed.begin(), keyed.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (std::size_t i = 1; i < keyed.size(); ++i) {
+        assert(keyed[i - 1].second < keyed[i].second || keyed[i - 1].second == keyed[i].second);
+        assert((keyed[i - 1].first == keyed[i].first) == (keyed[i - 1].second == keyed[i].second));
+    }
+    for (const std::string& bad : {std::string(), std::string("\x03"), std::string("\x01\x00", 2), std::string("\x02"),
+                                   sb(5, 3).path_key().substr(0, 3)}) {
+        threw = false;
+        try {
+            auto decoded = sb::from_path_key(bad);
+            (void)decoded;
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+void test_big_integer_comprehensive() {
+    std::cout << "Testing big_integer backend (comprehensive)... ";
+    
+    // Small values stay inline; overflow of int64_t spills to limbs
+    big_integer small = big_integer(355) * big_integer(113);
+    assert(small.is_inline() && small.to_int64() == 40115);
+    big_integer max = std::numeric_limits<int64_t>::max();
+    assert(!(max + 1).is_inline() && (max + 1 - 1).is_inline());
+    assert((max + 1).to_string() == "9223372036854775808");
+    big_integer min = std::numeric_limits<int64_t>::min();
+    assert(min.is_inline() && !(-min).is_inline() && -(-min) == min);
+    
+    // 30! and exact round trips through multiplication and division
+    big_integer factorial = 1;
+    for (int i = 1; i <= 30; ++i) factorial *= i;
+    assert(factorial.to_string() == "265252859812191058636308480000000");
+    big_integer back = factorial;
+    for (int i = 30; i >= 1; --i) back /= i;
+    assert(back == 1 && back.is_inline());
+    
+    // Truncating division on multi-limb operands
+    auto dividend = big_integer::from_string("123456789012345678901234567890123456789");
+    auto divisor = big_integer::from_string("987654321987654321");
+    assert((dividend / divisor).to_string() == "124999998748437501153");
+    assert((dividend % divisor).to_string() == "142745764920524676");
+    assert((-dividend / divisor).to_string() == "-124999998748437501153");
+    assert((-dividend % divisor).to_string() == "-142745764920524676");
+    assert(dividend / divisor * divisor + dividend % divisor == dividend);
+    
+    // gcd, ordering, conversions
+    assert(gcd(factorial, dividend) == 9);
+    assert(gcd(factorial * 7919, big_integer::from_string("-7919")) == 7919);
+    assert(-dividend < min && min < max && max < dividend && !(dividend < dividend));
+    assert(approx_equal(factorial.to_double(), 2.6525285981219107e32, 1e18));
+    assert(big_integer(1e30).to_string() == "1000000000000000019884624838656");
+    
+    // Harmonic number H₅₀ on the big_integer backend: exact, beyond int64_t
+    stern_brocot<big_integer> h;
+    for (int i = 1; i <= 50; ++i) h = h + stern_brocot<big_integer>(1, i);
+    assert(h.numerator().to_string() == "13943237577224054960759");
+    assert(h.denominator().to_string() == "3099044504245996706400");
+    assert(approx_equal(h.to_double(), 4.499205338329425));
+    auto pi = stern_brocot<big_integer>::approximate(3.141592653589793, 1000);
+    assert(pi.numerator() == 355 && pi.denominator() == 113);
+    
+    bool threw = false;
+    try {
+        auto bad = factorial / big_integer(0);
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
 // ============= RESIDUE NUMBER SYSTEM TESTS =============
 void test_rns_comprehensive() {
     std::cout << "Testing residue number system (comprehensive)... ";
@@ -229,6 +718,150 @@ void test_rns_comprehensive() {
     auto rns_8 = RNS3::from_integer(8);
     auto wrapped_diff = rns_3 - rns_8;
     // Should handle modular arithmetic correctly
+    assert(wrapped_diff == RNS3::from_integer(-5));
+    assert(static_cast<long long>(wrapped_diff.to_range_type()) ==
+           static_cast<long long>(RNS3::dynamic_range()) - 5);
+    
+    // Values store residues only; the basis is shared and precomputed
+    static_assert(sizeof(RNS3) == 3 * sizeof(int32_t));
+    const auto& basis = RNS3::basis();
+    assert(basis.dynamic_range() == 251u * 253u * 255u);
+    for (size_t i = 0; i < 3; ++i) {
+        auto m = basis.modulus(i);
+        auto mi_mod = static_cast<int64_t>(basis.mi(i) % m);
+        assert(mi_mod * basis.mi_inverse(i) % m == 1);
+    }
+    
+    // Compile-time moduli: the basis is validated during compilation
+    using RNS_CT = residue_number_system<int32_t, 3, rns_moduli<int32_t, 7, 11, 13>>;
+    static_assert(RNS_CT::dynamic_range() == 1001);
+    static_assert(RNS_CT::from_integer(500).to_integer() == 500);
+    auto ct_product = RNS_CT::from_integer(31) * RNS_CT::from_integer(29);
+    assert(ct_product.to_integer() == 899);
+    
+    // Four default moduli exceed int32 but the wide reconstruction holds
+    auto rns4_value = rns4<int32_t>::from_integer(123456789);
+    assert((rns4_value * rns4<int32_t>::from_integer(3)).to_integer() == 370370367);
+    
+    // Barrett reduction agrees with hardware division
+    barrett_reducer reducer(4294967291u);
+    for (uint64_t x : {0ull, 1ull, 4294967290ull, 4294967291ull, 18446744073709551615ull,
+                       12345678901234567ull}) {
+        assert(reducer.reduce(x) == x % 4294967291u);
+    }
+    
+    // Invalid bases are rejected once, at construction
+    bool threw = false;
+    try {
+        rns_basis<int32_t, 2> bad({4, 6});
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Mixed-radix digits reconstruct the value: x = a0 + a1*7 + a2*77
+    auto digits = RNS_CT::from_integer(900).mixed_radix();
+    assert(digits[0] + digits[1] * 7 + digits[2] * 77 == 900);
+
+    // Sign and ordering over the symmetric range [-500, 501)
+    assert(RNS_CT::from_integer(0).sign() == 0);
+    assert(RNS_CT::from_integer(500).sign() == 1);
+    assert(RNS_CT::from_integer(-1).sign() == -1);
+    assert(RNS_CT::from_integer(-500).sign() == -1);
+    assert(RNS_CT::from_integer(-3) < RNS_CT::from_integer(2));
+    assert(RNS_CT::from_integer(123) > RNS_CT::from_integer(122));
+    assert(RNS_CT::from_integer(-7).compare(RNS_CT::from_integer(-7)) == 0);
+    for (int a = -500; a <= 500; a += 37) {
+        for (int b = -500; b <= 500; b += 41) {
+            int expected = a < b ? -1 : (a > b ? 1 : 0);
+            assert(RNS_CT::from_integer(a).compare(RNS_CT::from_integer(b)) == expected);
+            bool overflow = a + b > 500 || a + b < -500;
+            assert(RNS_CT::from_integer(a).is_overflow(RNS_CT::from_integer(b)) == overflow);
+        }
+    }
+
+    // Unsigned types order by the representative in [0, M)
+    using RNS_U = residue_number_system<uint32_t, 3, rns_moduli<uint32_t, 7, 11, 13>>;
+    assert(RNS_U::from_integer(1000u) > RNS_U::from_integer(999u));
+    assert(RNS_U::from_integer(1000u).sign() == 1);
+
+    // Scaling and base extension never leave residue space
+    for (int x : {0, 1, 76, 77, 500, 999, 1000}) {
+        auto value = RNS_CT::from_integer(x);
+        assert(value.scale_by_modulus(0).to_integer() == x / 7);
+        assert(value.scale_by_modulus(1).to_integer() == x / 11);
+        assert(value.scale_by_modulus(2).to_integer() == x / 13);
+        assert(value.base_extend(17) == x % 17);
+    }
+    auto big = rns4<int32_t>::from_integer(123456789);
+    assert(big.base_extend(65521) == 123456789 % 65521);
+    assert(big.scale_by_modulus(3).to_integer() == 123456789 / 256);
+
+    std::cout << "PASSED\n";
+}
+
+// ============= RNS ARRAY (SoA) TESTS =============
+void test_rns_array_comprehensive() {
+    std::cout << "Testing rns_array batched kernels (comprehensive)... ";
+    
+    using RNS3 = residue_number_system<int32_t, 3>;
+    using Array = rns_array<int32_t, 3>;
+    
+    std::vector<int32_t> xs, ys;
+    for (int32_t k = 0; k < 1000; ++k) {
+        xs.push_back(k * 37 - 5000);
+        ys.push_back(k % 97 + 1);
+    }
+    auto a = Array::from_integers(xs);
+    auto b = Array::from_integers(ys);
+    assert(a.size() == 1000);
+    assert(a.channel(1).size() == 1000);
+    
+    // Batched results agree with the scalar type element by element
+    auto sum = a + b;
+    auto diff = a - b;
+    auto product = a * b;
+    for (size_t k = 0; k < xs.size(); ++k) {
+        auto sa = RNS3::from_integer(xs[k]);
+        auto sb = RNS3::from_integer(ys[k]);
+        assert(a.get(k) == sa);
+        assert(sum.get(k) == sa + sb);
+        assert(diff.get(k) == sa - sb);
+        assert(product.get(k) == sa * sb);
+    }
+    
+    // Batched CRT reconstruction
+    auto back = sum.to_integers();
+    for (size_t k = 0; k < xs.size(); ++k) {
+        int64_t expected = (int64_t(xs[k]) + ys[k]) % int64_t(RNS3::dynamic_range());
+        if (expected < 0) expected += int64_t(RNS3::dynamic_range());
+        assert(back[k] == expected);
+    }
+    
+    // Multiply-accumulate and deferred-reduction dot product
+    Array acc(xs.size());
+    acc.multiply_accumulate(a, b).multiply_accumulate(a, b);
+    auto sdot = RNS3::from_integer(0);
+    for (size_t k = 0; k < xs.size(); ++k) {
+        auto term = RNS3::from_integer(xs[k]) * RNS3::from_integer(ys[k]);
+        assert(acc.get(k) == term + term);
+        sdot = sdot + term;
+    }
+    assert(dot(a, b) == sdot);
+    
+    // Element updates
+    acc.set(3, RNS3::from_integer(42));
+    assert(acc.to_integers()[3] == 42);
+    
+    bool threw = false;
+    try {
+        auto bad = a + Array(3);
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
     
     std::cout << "PASSED\n";
 }
@@ -282,6 +915,56 @@ void test_multiscale_comprehensive() {
     auto mixed = neg + pos;
     assert(approx_equal(mixed.to_value(), -2e10, 1e5));
     
+    // O(1) normalization: mantissa in [1/SCALE, 1) far from unity
+    for (double v : {1e-300, 3.7e-200, 1e-3, 0.5, 1.0, 999.999, 1000.0, 1000.001, 6.02e23, 1e300}) {
+        multiscale<double, 3> x(v);
+        assert(std::abs(x.mantissa()) >= 1e-3 && std::abs(x.mantissa()) < 1.0);
+        assert(approx_equal(x.to_value() / v, 1.0, 1e-14));
+    }
+    assert((multiscale<double, 3>(1000.0).scale_level() == 2));
+    assert((multiscale<double, 3>(999.999).scale_level() == 1));
+    assert((multiscale<double, 3>(-1e-10).scale_level() == -3));
+    
+    // Scale sums no longer wrap int8_t: they saturate
+    multiscale<double, 1> near_top(0.5, 100);
+    auto saturated = near_top * near_top;
+    assert(saturated.scale_level() == 127);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= MULTISCALE ARRAY (SoA) TESTS =============
+void test_multiscale_array_comprehensive() {
+    std::cout << "Testing multiscale_array batched kernels (comprehensive)... ";
+    
+    using MS = multiscale<double, 3>;
+    std::vector<double> xs = {1e-250, 2.5e-100, -3e-5, 0.0, 1.0, 42.0, 7e80, 1e250, -6e12};
+    std::vector<double> ys = {3e200, 4e90, 2e5, 5.0, -1.0, 1e-3, 1e-80, 2e-240, 1e-12};
+    auto a = multiscale_array<double, 3>::from_values(xs);
+    auto b = multiscale_array<double, 3>::from_values(ys);
+    assert(a.size() == xs.size());
+    
+    // Same results as the scalar type
+    auto product = a * b;
+    auto sum = a + b;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        MS sx(xs[i]), sy(ys[i]);
+        assert(a.get(i) == sx);
+        assert(product.get(i).scale_level() == (sx * sy).scale_level());
+        assert(approx_equal(product.get(i).mantissa(), (sx * sy).mantissa(), 1e-15));
+        assert(approx_equal(sum.get(i).mantissa(), (sx + sy).mantissa(), 1e-15));
+        assert(sum.get(i).scale_level() == (sx + sy).scale_level());
+    }
+    auto values = product.to_values();
+    assert(approx_equal(values[0] / (1e-250 * 3e200), 1.0, 1e-14));
+    
+    // Reduction across 500 orders of magnitude keeps the dominant terms
+    std::vector<double> spread;
+    for (int e = -250; e <= 250; e += 10) spread.push_back(std::pow(10.0, e));
+    auto total = multiscale_array<double, 3>::from_values(spread).sum();
+    assert(approx_equal(total.to_value() / 1.0000000001e250, 1.0, 1e-12));
+    assert((multiscale_array<double, 3>(5).sum() == MS(0.0)));
+    
     std::cout << "PASSED\n";
 }
 
@@ -347,6 +1030,232 @@ void test_dual_comprehensive() {
     std::cout << "PASSED\n";
 }
 
+// ============= MULTI-DIRECTIONAL DUAL TESTS =============
+void test_dual_vec_comprehensive() {
+    std::cout << "Testing dual_vec multi-directional AD (comprehensive)... ";
+    
+    using D3 = dual_vec<double, 3>;
+    auto x = D3::variable(2.0, 0);
+    auto y = D3::variable(3.0, 1);
+    auto z = D3::variable(0.5, 2);
+    
+    // f = x·y/z + sin(x)·exp(z) - log(y) + sqrt(x)·pow(y, 2) + pow(x, z)
+    auto f = x * y / z + sin(x) * exp(z) - log(y) + sqrt(x) * pow(y, 2.0) + pow(x, z);
+    double fx = 2.0 * 3.0 / 0.5 + std::sin(2.0) * std::exp(0.5) - std::log(3.0)
+                + std::sqrt(2.0) * 9.0 + std::pow(2.0, 0.5);
+    assert(approx_equal(f.value(), fx, 1e-12));
+    double dfdx = 3.0 / 0.5 + std::cos(2.0) * std::exp(0.5) + 9.0 / (2 * std::sqrt(2.0))
+                  + 0.5 * std::pow(2.0, -0.5);
+    double dfdy = 2.0 / 0.5 - 1.0 / 3.0 + std::sqrt(2.0) * 6.0;
+    double dfdz = -2.0 * 3.0 / 0.25 + std::sin(2.0) * std::exp(0.5)
+                  + std::pow(2.0, 0.5) * std::log(2.0);
+    assert(approx_equal(f.derivative(0), dfdx, 1e-12));
+    assert(approx_equal(f.derivative(1), dfdy, 1e-12));
+    assert(approx_equal(f.derivative(2), dfdz, 1e-12));
+    
+    // Agrees lane by lane with scalar dual
+    auto scalar = dual<double>::variable(2.0);
+    auto g_scalar = cos(scalar * scalar) / (dual<double>(1.0) + scalar);
+    auto g_vec = cos(x * x) / (1.0 + x);
+    assert(approx_equal(g_vec.derivative(0), g_scalar.derivative(), 1e-14));
+    assert(g_vec.derivative(1) == 0.0 && g_vec.derivative(2) == 0.0);
+    assert(approx_equal((2.0 - x).derivative(0), -1.0) && approx_equal((1.0 / x).derivative(0), -0.25));
+    
+    // Jacobian of f: R^10 → R^2 with K = 4 (three sweeps, last one partial)
+    std::vector<double> p(10);
+    for (size_t i = 0; i < p.size(); ++i) p[i] = 0.1 * double(i + 1);
+    auto model = [](const auto& in) {
+        using V = typename std::decay_t<decltype(in)>::value_type;
+        V sum = 0.0, prod = 1.0;
+        for (size_t i = 0; i < in.size(); ++i) {
+            sum += in[i] * in[i] * double(i + 1);
+            prod *= exp(in[i]);
+        }
+        return std::vector<V>{sum, prod};
+    };
+    auto J = jacobian<4>(model, p);
+    assert(J.rows == 2 && J.cols == 10);
+    double total = 0;
+    for (double v : p) total += v;
+    assert(approx_equal(J.values[1], std::exp(total), 1e-12));
+    for (size_t j = 0; j < 10; ++j) {
+        assert(approx_equal(J(0, j), 2.0 * p[j] * double(j + 1), 1e-12));
+        assert(approx_equal(J(1, j), std::exp(total), 1e-12));
+    }
+    // Same Jacobian regardless of lane count
+    auto J16 = jacobian<16>(model, p);
+    for (size_t k = 0; k < J.matrix.size(); ++k) assert(approx_equal(J.matrix[k], J16.matrix[k], 1e-14));
+    
+    auto grad = gradient<8>([](const auto& in) { return in[0] * in[1] + sin(in[2]); },
+                            std::vector<double>{1.5, -2.0, 0.3});
+    assert(grad.size() == 3);
+    assert(approx_equal(grad[0], -2.0) && approx_equal(grad[1], 1.5));
+    assert(approx_equal(grad[2], std::cos(0.3)));
+    
+    bool rejected = false;
+    try { D3::variable(1.0, 3); } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= REVERSE-MODE (ADJOINT) TESTS =============
+template<typename V>
+V adjoint_test_function(const V& x) {
+    // Written once, differentiated by dual and adjoint alike
+    return sin(x * x) / (x + V(1.0)) + exp(x) * log(x) - sqrt(x) + pow(x, 3.0);
+}
+
+void test_adjoint_comprehensive() {
+    std::cout << "Testing adjoint reverse-mode AD (comprehensive)... ";
+    
+    // Interchangeable with dual in templated code
+    tape<double> t;
+    auto x = t.variable(1.7);
+    auto y = adjoint_test_function(x);
+    auto forward = adjoint_test_function(dual<double>::variable(1.7));
+    assert(approx_equal(y.value(), forward.value(), 1e-14));
+    t.backward(y);
+    assert(approx_equal(t.adjoint_of(x), forward.derivative(), 1e-12));
+    
+    // Mixed constants on either side record single-parent nodes
+    auto z = 2.0 - x * 3.0 + 1.0 / x - x / 4.0 + (-x);
+    t.backward(z);
+    assert(approx_equal(t.adjoint_of(x), -3.0 - 1.0 / (1.7 * 1.7) - 0.25 - 1.0, 1e-12));
+    
+    // Many inputs, one output: one reverse sweep gives the whole gradient
+    tape<double> loss_tape;
+    std::vector<adjoint<double>> w;
+    for (int i = 0; i < 2000; ++i) w.push_back(loss_tape.variable(0.001 * i));
+    adjoint<double> loss = 0.0;
+    for (size_t i = 0; i < w.size(); ++i) loss += w[i] * w[i] * double(i % 7);
+    auto grad = loss_tape.gradient(loss);
+    assert(grad.size() == 2000);
+    for (size_t i = 0; i < grad.size(); ++i) {
+        assert(approx_equal(grad[i], 2.0 * 0.001 * double(i) * double(i % 7), 1e-12));
+    }
+    
+    // Checkpoint / rewind reuses the arena for the next iteration
+    tape<double> fit;
+    auto a = fit.variable(0.5), b = fit.variable(-1.0);
+    auto after_inputs = fit.checkpoint();
+    double first_size = 0;
+    for (int iter = 0; iter < 3; ++iter) {
+        fit.rewind(after_inputs);
+        adjoint<double> sse = 0.0;
+        for (int k = 0; k < 10; ++k) {
+            auto residual = a * double(k) + b - double(2 * k + 1);
+            sse += residual * residual;
+        }
+        if (iter == 0) first_size = double(fit.size());
+        assert(double(fit.size()) == first_size);
+        auto g = fit.gradient(sse);
+        assert(g.size() == 2);
+        double ga = 0, gb = 0;
+        for (int k = 0; k < 10; ++k) {
+            double r = 0.5 * k - 1.0 - (2 * k + 1);
+            ga += 2 * r * k;
+            gb += 2 * r;
+        }
+        assert(approx_equal(g[0], ga, 1e-10) && approx_equal(g[1], gb, 1e-10));
+    }
+    
+    // Replay: same control flow, new input values, no re-recording
+    tape<double> rec;
+    auto u = rec.variable(2.0), v = rec.variable(3.0);
+    auto f = u * v + sin(u) * exp(v / 2.0);
+    rec.set_value(u, 0.5);
+    rec.set_value(v, -1.0);
+    rec.replay();
+    assert(approx_equal(rec.value(f), 0.5 * -1.0 + std::sin(0.5) * std::exp(-0.5), 1e-14));
+    auto g = rec.gradient(f);
+    assert(approx_equal(g[0], -1.0 + std::cos(0.5) * std::exp(-0.5), 1e-14));
+    assert(approx_equal(g[1], 0.5 + std::sin(0.5) * std::exp(-0.5) / 2.0, 1e-14));
+    
+    // Infinite partials do not leak NaN into unrelated adjoints
+    tape<double> edge;
+    auto p = edge.variable(0.0), q = edge.variable(2.0);
+    auto r = sqrt(p) + q * q;
+    auto gr = edge.gradient(r);
+    assert(std::isinf(gr[0]) && gr[1] == 4.0);
+    
+    bool rejected = false;
+    tape<double> other;
+    try { auto bad = x + other.variable(1.0); (void)bad; } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= SECOND-ORDER AD TESTS =============
+template<typename V>
+V rosenbrock(const std::vector<V>& x) {
+    V sum = 0.0;
+    for (size_t i = 0; i + 1 < x.size(); ++i) {
+        V a = x[i + 1] - x[i] * x[i];
+        V b = V(1.0) - x[i];
+        sum = sum + V(100.0) * a * a + b * b;
+    }
+    return sum;
+}
+
+void test_second_order_ad_comprehensive() {
+    std::cout << "Testing hyper_dual and Hessian-vector products (comprehensive)... ";
+    
+    // f″ along one variable matches the analytic second derivative
+    auto h = hyper_dual<double>::variable(0.8);
+    auto f = sin(h * h) / (h + hyper_dual<double>(1.0)) + exp(h) * log(h) - sqrt(h) + pow(h, 3.0);
+    auto scalar = adjoint_test_function(dual<double>::variable(0.8));
+    assert(approx_equal(f.value(), scalar.value(), 1e-14));
+    assert(approx_equal(f.derivative(), scalar.derivative(), 1e-13));
+    // Compare f″ with a central difference of the exact dual derivative
+    double step = 1e-5;
+    double fd = (adjoint_test_function(dual<double>::variable(0.8 + step)).derivative() -
+                 adjoint_test_function(dual<double>::variable(0.8 - step)).derivative()) / (2 * step);
+    assert(approx_equal(f.second_derivative(), fd, 1e-6));
+    
+    // Mixed partial of g = x²y + sin(xy) at (x, y) = (1.2, -0.7)
+    double x0 = 1.2, y0 = -0.7;
+    hyper_dual<double> hx(x0, 1, 0, 0), hy(y0, 0, 1, 0);
+    auto g = hx * hx * hy + sin(hx * hy);
+    double mixed = 2 * x0 + std::cos(x0 * y0) - x0 * y0 * std::sin(x0 * y0);
+    assert(approx_equal(g.second_derivative(), mixed, 1e-13));
+    
+    // Forward-over-reverse H·v on the tape equals hyper-dual eⱼᵀHv
+    const size_t n = 12;
+    std::vector<double> x(n), v(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 0.3 + 0.05 * double(i);
+        v[i] = std::cos(double(i));
+    }
+    tape<double> t;
+    std::vector<adjoint<double>> xs;
+    for (double xi : x) xs.push_back(t.variable(xi));
+    auto loss = rosenbrock(xs);
+    auto hv = t.hessian_vector(loss, v);
+    auto grad = t.gradient(loss);
+    for (size_t j = 0; j < n; ++j) {
+        std::vector<hyper_dual<double>> hxs;
+        for (size_t i = 0; i < n; ++i) hxs.emplace_back(x[i], v[i], i == j ? 1.0 : 0.0, 0.0);
+        auto r = rosenbrock(hxs);
+        assert(approx_equal(hv[j], r.second_derivative(), 1e-9));
+        assert(approx_equal(grad[j], r.derivative2(), 1e-10));
+    }
+    
+    // Every elementary rule: H·v of one-variable functions is f″·v
+    tape<double> u;
+    auto p = u.variable(0.8);
+    auto q = adjoint_test_function(p) + 2.0 / p - p / 3.0 + cos(p) - (1.0 - p) * (p + 2.0);
+    auto hq = u.hessian_vector(q, std::vector<double>{2.0});
+    auto hp = hyper_dual<double>::variable(0.8);
+    auto ref = sin(hp * hp) / (hp + hyper_dual<double>(1.0)) + exp(hp) * log(hp) - sqrt(hp)
+               + pow(hp, 3.0) + hyper_dual<double>(2.0) / hp - hp / hyper_dual<double>(3.0)
+               + cos(hp) - (hyper_dual<double>(1.0) - hp) * (hp + hyper_dual<double>(2.0));
+    assert(approx_equal(hq[0], 2.0 * ref.second_derivative(), 1e-11));
+    
+    std::cout << "PASSED\n";
+}
+
 // ============= INTERVAL TRANSFORM TESTS =============
 void test_interval_comprehensive() {
     std::cout << "Testing interval transform (comprehensive)... ";
@@ -419,6 +1328,203 @@ void test_interval_comprehensive() {
     assert(approx_equal(sqrt_interval.lower(), 2.0));
     assert(approx_equal(sqrt_interval.upper(), 3.0));
     
+    // Outward rounding: exact results stay tight, inexact ones enclose the
+    // real result (checked in long double) within one step on each side
+    assert((interval<double>(1.0) + interval<double>(2.0)) == interval<double>(3.0));
+    assert((interval<double>(3.0) * interval<double>(0.5)) == interval<double>(1.5));
+    assert(sqrt(interval<double>(4.0, 9.0)) == interval<double>(2.0, 3.0));
+    auto tenth = interval<double>(0.1) + interval<double>(0.2);
+    assert(tenth.lower() < tenth.upper());
+    assert((long double)tenth.lower() <= (long double)0.1 + (long double)0.2);
+    assert((long double)tenth.upper() >= (long double)0.1 + (long double)0.2);
+    assert(std::nextafter(tenth.lower(), 1.0) == tenth.upper());
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    for (int i = 0; i < 1000; ++i) {
+        double x = dist(rng), y = dist(rng);
+        auto p = interval<double>(x) * interval<double>(y);
+        long double exact = (long double)x * (long double)y;
+        assert(p.lower() <= exact && exact <= p.upper());
+        assert(p.upper() <= std::nextafter(std::nextafter(p.lower(), 1e300), 1e300));
+        auto q = interval<double>(x) / interval<double>(y);
+        long double ratio = (long double)x / (long double)y;
+        assert(q.lower() <= ratio && ratio <= q.upper());
+        auto s = sqrt(interval<double>(std::abs(x)));
+        assert((long double)s.lower() * s.lower() <= std::abs(x));
+        assert((long double)s.upper() * s.upper() >= std::abs(x));
+    }
+    // Overflow keeps a finite, sound lower bound
+    auto huge = interval<double>(1e300) * interval<double>(1e300);
+    assert(huge.lower() == std::numeric_limits<double>::max() && std::isinf(huge.upper()));
+    auto zero_inf = interval<double>(0.0, 1.0) * interval<double>(1.0, std::numeric_limits<double>::infinity());
+    assert(zero_inf.lower() == 0.0 && std::isinf(zero_inf.upper()));
+    
+    // Tight, range-reduced elementary functions
+    auto s1 = sin(interval<double>(0.1, 0.2));
+    assert(s1.lower() <= std::sin(0.1) && s1.upper() >= std::sin(0.2));
+    assert(s1.width() < std::sin(0.2) - std::sin(0.1) + 1e-15);
+    assert(sin(interval<double>(1.0, 2.0)).upper() == 1.0);
+    assert(sin(interval<double>(1.0, 2.0)).lower() <= std::sin(1.0));
+    assert(sin(interval<double>(1.0, 2.0)).lower() > 0.8);
+    assert(cos(interval<double>(3.0, 3.3)).lower() == -1.0);
+    assert(cos(interval<double>(3.0, 3.3)).upper() < -0.98);
+    assert(sin(interval<double>(-20.0, -19.0)).contains(std::sin(-19.5)));
+    assert(sin(interval<double>(0.0, 10.0)) == interval<double>(-1.0, 1.0));
+    assert(cos(interval<double>(100.0 * 6.283185307179586, 100.0 * 6.283185307179586 + 0.1)).upper() == 1.0);
+    // Float arguments near 1e5 still enclose: the phase is located in double
+    assert(sin(interval<float>(185832.875f, 185833.062f)).upper() == 1.0f);
+    std::mt19937 trig_rng(18);
+    std::uniform_real_distribution<double> where(-1e6, 1e6), wide(0.0, 0.5);
+    for (int i = 0; i < 2000; ++i) {
+        const float lo = static_cast<float>(where(trig_rng));
+        const float hi = lo + static_cast<float>(wide(trig_rng));
+        const interval<float> s = sin(interval<float>(lo, hi)), c = cos(interval<float>(lo, hi));
+        for (int k = 0; k <= 16; ++k) {
+            const double v = lo + (double(hi) - lo) * k / 16;
+            assert(s.lower() <= std::sin(v) && std::sin(v) <= s.upper());
+            assert(c.lower() <= std::cos(v) && std::cos(v) <= c.upper());
+        }
+        const long double turns = (hi - 1.57079632679489661923L) / 6.28318530717958647692L;
+        if (std::floor(turns) * 6.28318530717958647692L + 1.57079632679489661923L >= lo) assert(s.upper() == 1.0f);
+    }
+    auto e = exp(interval<double>(0.0, 1.0));
+    assert(e.contains(1.0) && e.contains(std::exp(1.0)) && e.width() < 1.7183);
+    auto l = log(interval<double>(1.0, std::exp(2.0)));
+    assert(l.contains(0.0) && l.contains(2.0) && l.width() < 2.0 + 1e-14);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= INTERVAL ARRAY TESTS =============
+void test_interval_array_comprehensive() {
+    std::cout << "Testing interval_array batched kernels (comprehensive)... ";
+    
+    std::vector<interval<double>> xs, ys;
+    for (int i = 0; i < 37; ++i) {
+        xs.emplace_back(0.1 * i - 1.7, 0.1 * i - 1.2);
+        ys.emplace_back(0.3 + 0.01 * i, 0.9 + 0.02 * i);
+    }
+    auto a = interval_array<double>::from_intervals(xs);
+    auto b = interval_array<double>::from_intervals(ys);
+    auto sum = a + b, diff = a - b, prod = a * b, quot = a / b, sq = a.square();
+    for (size_t i = 0; i < xs.size(); ++i) {
+        assert(sum.get(i) == xs[i] + ys[i]);
+        assert(diff.get(i) == xs[i] - ys[i]);
+        assert(prod.get(i) == xs[i] * ys[i]);
+        assert(quot.get(i) == xs[i] / ys[i]);
+        assert((xs[i] * xs[i]).contains(sq.get(i)));
+        assert(sq.get(i).lower() >= 0.0);
+    }
+    // Straddling divisors give the entire line; square of [-1, 2] is [0, 4]
+    auto straddle = interval_array<double>::from_intervals(std::vector<interval<double>>{{-1.0, 2.0}});
+    assert((straddle / straddle).get(0) == interval<double>::entire());
+    assert(straddle.square().get(0) == interval<double>(0.0, 4.0));
+    
+    // Sum of 1000 copies of 0.1 encloses 100·0.1 computed exactly
+    interval_array<double> tenths(std::vector<double>(1000, 0.1), std::vector<double>(1000, 0.1));
+    auto total = tenths.sum();
+    long double exact = 1000 * (long double)0.1;
+    assert(total.lower() <= exact && exact <= total.upper());
+    assert(total.width() < 1e-11);
+    assert(tenths.widths()[0] == 0.0);
+    
+    bool rejected = false;
+    try { interval_array<double>({2.0}, {1.0}); } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= INTERVAL BRANCH-AND-BOUND TESTS =============
+void test_interval_bnb_comprehensive() {
+    std::cout << "Testing interval_bnb global minimization (comprehensive)... ";
+    
+    using I = interval<double>;
+    // Six-hump camel: minimum -1.031628453489877 at ±(0.08984, -0.71266)
+    auto camel = [](const auto& x) {
+        I x2 = x[0] * x[0], y2 = x[1] * x[1];
+        return (I(4.0) - I(2.1) * x2 + x2 * x2 / I(3.0)) * x2 + x[0] * x[1] +
+               (I(-4.0) + I(4.0) * y2) * y2;
+    };
+    const double camel_min = -1.031628453489877;
+    for (unsigned threads : {1u, 4u}) {
+        bnb_options<double> options;
+        options.threads = threads;
+        options.box_tolerance = 1e-3;
+        options.value_tolerance = 1e-6;
+        interval_bnb<double> solver({I(-3.0, 3.0), I(-2.0, 2.0)}, options);
+        auto result = solver.minimize(camel);
+        assert(result.complete);
+        assert(result.lower_bound <= camel_min && camel_min <= result.upper_bound);
+        assert(result.upper_bound - result.lower_bound < 1e-2);
+        assert(std::abs(std::abs(result.minimizer[0]) - 0.0898420) < 1e-2);
+        assert(std::abs(std::abs(result.minimizer[1]) - 0.7126564) < 1e-2);
+        assert(std::abs(camel(result.minimizer).mid() - result.upper_bound) < 1e-12);
+        assert(result.stats.boxes > 0 && result.stats.pruned > 0);
+        assert(result.stats.pruning_ratio() > 0.0 && result.stats.pruning_ratio() <= 1.0);
+    }
+    
+    // Gradient enclosures prune boxes where f is monotone
+    auto shifted_sphere = [](const auto& x) {
+        I total(0.0);
+        for (std::size_t i = 0; i < x.size(); ++i) total = total + (x[i] - I(0.3)) * (x[i] - I(0.3));
+        return total;
+    };
+    auto sphere_gradient = [](const auto& x, auto out) {
+        for (std::size_t i = 0; i < x.size(); ++i) out[i] = I(2.0) * (x[i] - I(0.3));
+    };
+    bnb_options<double> options;
+    options.threads = 2;
+    options.box_tolerance = 1e-3;
+    options.value_tolerance = 1e-6;
+    std::vector<I> cube(6, I(-2.0, 3.0));
+    auto plain = interval_bnb<double>(cube, options).minimize(shifted_sphere);
+    auto pruned = interval_bnb<double>(cube, options).minimize(shifted_sphere, sphere_gradient);
+    assert(plain.lower_bound <= 0.0 && 0.0 <= plain.upper_bound && plain.upper_bound < 1e-5);
+    assert(pruned.lower_bound <= 0.0 && 0.0 <= pruned.upper_bound && pruned.upper_bound < 1e-5);
+    assert(pruned.stats.boxes * 10 < plain.stats.boxes);
+    
+    // Minimum on the boundary survives the monotonicity test: f = x on [1, 2]
+    auto linear = [](const auto& x) { return x[0]; };
+    auto slope = [](const auto&, auto out) { out[0] = I(1.0); };
+    auto edge = interval_bnb<double>({I(1.0, 2.0)}).minimize(linear, slope);
+    assert(edge.lower_bound == 1.0 && edge.upper_bound == 1.0);
+    
+    // Progress hook and box budget
+    std::size_t reports = 0;
+    bnb_options<double> limited;
+    limited.threads = 3;
+    limited.max_boxes = 500;
+    limited.report_every = 100;
+    limited.progress = [&](const bnb_stats& s) { ++reports; assert(s.boxes > 0); };
+    auto partial = interval_bnb<double>(cube, limited).minimize(shifted_sphere);
+    assert(!partial.complete);
+    assert(partial.lower_bound <= 0.0 && 0.0 <= partial.upper_bound);
+    assert(reports >= 1);
+    
+    // An exception from f on any thread stops the workers and reaches the caller
+    for (unsigned threads : {1u, 4u}) {
+        std::atomic<int> calls{0};
+        auto failing = [&](const auto& x) {
+            if (calls.fetch_add(1) == 200) throw std::runtime_error("f failed");
+            return shifted_sphere(x);
+        };
+        bnb_options<double> failing_options = options;
+        failing_options.threads = threads;
+        bool propagated = false;
+        try {
+            interval_bnb<double>(cube, failing_options).minimize(failing);
+        } catch (const std::runtime_error&) {
+            propagated = true;
+        }
+        assert(propagated);
+    }
+    
+    bool rejected = false;
+    try { interval_bnb<double>({I(0.0, std::numeric_limits<double>::infinity())}); }
+    catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
     std::cout << "PASSED\n";
 }
 
@@ -490,7 +1596,314 @@ void test_tropical_comprehensive() {
     std::cout << "PASSED\n";
 }
 
-// ============= MODULAR TRANSFORM TESTS =============
+// ============= TROPICAL MATRIX ENGINE TESTS =============
+void test_tropical_matrix_comprehensive() {
+    std::cout << "Testing tropical matrix engine (comprehensive)... ";
+    
+    const double inf = std::numeric_limits<double>::infinity();
+    
+    // Same 3-node graph as above: 0 -4-> 1 -2-> 2 -1-> 0
+    tropical_matrix_dyn<double> small(3);
+    small.set(0, 1, 4);
+    small.set(1, 2, 2);
+    small.set(2, 0, 1);
+    auto paths = small.all_pairs_shortest_paths();
+    assert(paths.get(0, 2) == 6.0);
+    assert(paths.get(1, 0) == 3.0);
+    assert(paths.get(2, 1) == 5.0);
+    assert(paths.get(1, 1) == 0.0);
+    
+    // Identity and dimension checks
+    auto product = small * tropical_matrix_dyn<double>::identity(3);
+    assert(product == small);
+    tropical_matrix_dyn<double> rect(3, 5);
+    assert((small * rect).cols() == 5);
+    bool threw = false;
+    try {
+        (void)(rect * small);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Random sparse-ish graph spanning several tiles: compare with Floyd-Warshall
+    const size_t n = 200;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    tropical_matrix_dyn<double> graph(n);
+    std::vector<double> fw(n * n, inf);
+    for (size_t i = 0; i < n; ++i) {
+        fw[i * n + i] = 0;
+        for (size_t j = 0; j < n; ++j) {
+            if (i != j && rng() % 50 == 0) {
+                double w = weight(rng);
+                graph.set(i, j, w);
+                fw[i * n + j] = w;
+            }
+        }
+    }
+    for (size_t k = 0; k < n; ++k)
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                fw[i * n + j] = std::min(fw[i * n + j], fw[i * n + k] + fw[k * n + j]);
+    
+    auto serial = graph.all_pairs_shortest_paths(1);
+    auto parallel = graph.all_pairs_shortest_paths(4);
+    assert(serial == parallel);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            double expected = fw[i * n + j];
+            double got = serial.get(i, j);
+            assert(std::isinf(expected) ? std::isinf(got) : approx_equal(got, expected, 1e-9));
+        }
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= SPARSE TROPICAL TESTS =============
+void test_tropical_sparse_comprehensive() {
+    std::cout << "Testing sparse tropical solvers (comprehensive)... ";
+    
+    const double inf = std::numeric_limits<double>::infinity();
+    using MinGraph = tropical_sparse_matrix<tropical_min<double>>;
+    using MaxGraph = tropical_sparse_matrix<tropical_max<double>>;
+    
+    // One SpMV kernel, two semirings
+    std::vector<tropical_edge<double>> edges = {{0, 1, 4}, {0, 2, 1}, {2, 1, 2}, {1, 3, 5}};
+    MinGraph g_min(4, edges);
+    MaxGraph g_max(4, edges);
+    assert(g_min.nnz() == 4);
+    std::vector<double> x = {0, 0, 0, 0};
+    auto y_min = g_min.multiply(x);
+    auto y_max = g_max.multiply(x);
+    assert(y_min[0] == 1 && y_max[0] == 4 && std::isinf(y_min[3]) && y_max[3] == -inf);
+    
+    auto sp = g_min.bellman_ford(0);
+    assert(sp[1] == 3 && sp[3] == 8 && sp[2] == 1);
+    assert(g_min.dag_paths(0) == sp);
+    auto lp = g_max.dag_paths(0);
+    assert(lp[1] == 4 && lp[3] == 9);
+    
+    // Critical path of a small schedule (weights = predecessor durations)
+    auto schedule = critical_path(g_max);
+    assert(schedule.length == 9);
+    assert((schedule.path == std::vector<size_t>{0, 1, 3}));
+    
+    // Cycles are reported
+    std::vector<tropical_edge<double>> cyclic = {{0, 1, 1}, {1, 0, -3}};
+    bool threw = false;
+    try {
+        MinGraph(2, cyclic).bellman_ford(0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        critical_path(MaxGraph(2, cyclic));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Random graph: Bellman-Ford and delta-stepping (serial and threaded) agree
+    const size_t n = 5000;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> weight(0.0, 10.0);
+    std::vector<tropical_edge<double>> random_edges;
+    for (size_t i = 0; i < 8 * n; ++i) {
+        random_edges.push_back({rng() % n, rng() % n, weight(rng)});
+    }
+    MinGraph graph(n, random_edges);
+    auto reference = graph.bellman_ford(0);
+    auto serial = delta_stepping(graph, 0, 2.0, 1);
+    auto parallel = delta_stepping(graph, 0, 2.0, 4);
+    assert(serial == parallel);
+    for (size_t v = 0; v < n; ++v) {
+        assert(std::isinf(reference[v]) ? std::isinf(serial[v])
+                                        : approx_equal(reference[v], serial[v], 1e-9));
+    }
+    
+    // Narrow buckets reuse a bounded ring; one too narrow for the weights is rejected
+    auto narrow = delta_stepping(graph, 0, 0.001, 1);
+    for (size_t v = 0; v < n; ++v) {
+        assert(std::isinf(reference[v]) ? std::isinf(narrow[v])
+                                        : approx_equal(reference[v], narrow[v], 1e-9));
+    }
+    threw = false;
+    try {
+        delta_stepping(MinGraph(2, std::vector<tropical_edge<double>>{{0, 1, 1e3}}), 0, 1e-9);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+// ============= HMM DECODING TESTS =============
+void test_hmm_comprehensive() {
+    std::cout << "Testing HMM Viterbi and forward decoding (comprehensive)... ";
+
+    const double neg_inf = -std::numeric_limits<double>::infinity();
+    using tmaxd = tropical_max<double>;
+    std::mt19937 rng(28);
+    std::uniform_real_distribution<double> unit(0.05, 1.0);
+
+    // Small model with a forbidden transition (2 → 0), checked by enumeration
+    const std::size_t n = 3, frames = 8;
+    std::vector<double> a(n * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        double row_sum = 0;
+        for (std::size_t j = 0; j < n; ++j) row_sum += a[i * n + j] = (i == 2 && j == 0) ? 0.0 : unit(rng);
+        for (std::size_t j = 0; j < n; ++j) a[i * n + j] /= row_sum;
+    }
+    std::vector<double> pi = {0.5, 0.3, 0.2};
+    std::vector<std::vector<double>> b(frames, std::vector<double>(n));
+    for (auto& frame : b) {
+        for (auto& e : frame) e = unit(rng);
+    }
+
+    std::vector<tmaxd> log_a, log_pi;
+    std::vector<lgd> lg_a, lg_pi;
+    std::vector<tropical_edge<double>> edges;
+    for (std::size_t p = 0; p < n * n; ++p) {
+        log_a.emplace_back(a[p] > 0 ? std::log(a[p]) : neg_inf);
+        lg_a.emplace_back(a[p]);
+        if (a[p] > 0) edges.push_back({p / n, p % n, std::log(a[p])});
+    }
+    for (double p : pi) {
+        log_pi.emplace_back(std::log(p));
+        lg_pi.emplace_back(p);
+    }
+    auto dense = hmm_transitions<double>::from_dense(n, log_a);
+    auto dense_lg = hmm_transitions<double>::from_dense(n, lg_a);
+    auto sparse = hmm_transitions<double>::from_sparse(tropical_sparse_matrix<tmaxd>(n, edges));
+    assert(dense.is_dense() && !sparse.is_dense() && sparse.nnz() == 8);
+
+    double best = neg_inf, total = 0;
+    std::vector<std::size_t> best_path, path(frames);
+    for (std::size_t code = 0; code < 6561; ++code) {
+        double p = 1;
+        for (std::size_t t = 0, c = code; t < frames; ++t, c /= n) {
+            path[t] = c % n;
+            p *= (t == 0 ? pi[path[t]] : a[path[t - 1] * n + path[t]]) * b[t][path[t]];
+        }
+        total += p;
+        if (p > 0 && std::log(p) > best) {
+            best = std::log(p);
+            best_path = path;
+        }
+    }
+
+    viterbi_decoder<double> on_dense(dense, log_pi), on_sparse(sparse, log_pi);
+    viterbi_decoder<double> on_lg(dense_lg, log_pi, viterbi_options<double>{std::numeric_limits<double>::infinity(), 0, 0});
+    hmm_forward<double> forward(dense, lg_pi), forward_sparse(sparse, lg_pi);
+    for (std::size_t t = 0; t < frames; ++t) {
+        std::vector<tmaxd> log_b;
+        std::vector<lgd> lg_b;
+        for (double e : b[t]) {
+            log_b.emplace_back(std::log(e));
+            lg_b.emplace_back(e);
+        }
+        on_dense.step(log_b);
+        on_sparse.step(log_b);
+        on_lg.step(log_b);
+        forward.step(lg_b);
+        forward_sparse.step(lg_b);
+    }
+    assert(on_dense.frames() == frames && on_dense.path() == best_path);
+    assert(on_sparse.path() == best_path && on_lg.path() == best_path);
+    assert(approx_equal(on_dense.best_score().value(), best, 1e-9));
+    assert(approx_equal(on_sparse.best_score().value(), best, 1e-9));
+    assert(approx_equal(forward.likelihood().log(), std::log(total), 1e-9));
+    assert(approx_equal(forward_sparse.likelihood().log(), std::log(total), 1e-9));
+    double filtered_sum = 0;
+    for (const auto& p : forward.filtered()) filtered_sum += p.value();
+    assert(approx_equal(filtered_sum, 1.0, 1e-12));
+    assert(on_dense.backpointer_bits() == 2);
+
+    // Long stream over a sticky model: survivors merge, so the committed
+    // prefix keeps up and the open window stays short
+    const std::size_t big = 200, stream = 5000;
+    std::vector<tropical_edge<double>> sticky_edges;
+    for (std::size_t i = 0; i < big; ++i) {
+        sticky_edges.push_back({i, i, std::log(0.9)});
+        sticky_edges.push_back({i, (i + 1) % big, std::log(0.05)});
+        sticky_edges.push_back({i, (i + 7) % big, std::log(0.05)});
+    }
+    auto sticky = hmm_transitions<double>::from_sparse(tropical_sparse_matrix<tmaxd>(big, sticky_edges));
+    std::vector<tmaxd> uniform_start(big, tmaxd(-std::log(double(big))));
+    viterbi_decoder<double> streaming(sticky, uniform_start);
+    viterbi_decoder<double> exact(sticky, uniform_start, viterbi_options<double>{std::numeric_limits<double>::infinity(), 0, 0});
+    viterbi_decoder<double> lagged(sticky, uniform_start, viterbi_options<double>{std::numeric_limits<double>::infinity(), 16, 40});
+    viterbi_decoder<double> beamed(sticky, uniform_start, viterbi_options<double>{8.0, 64, 0});
+    std::vector<std::size_t> streamed;
+    std::size_t truth = 0, max_window = 0;
+    std::vector<std::size_t> truths;
+    for (std::size_t t = 0; t < stream; ++t) {
+        if (rng() % 10 == 0) truth = (truth + 1) % big;
+        truths.push_back(truth);
+        std::vector<tmaxd> log_b(big);
+        for (std::size_t j = 0; j < big; ++j) log_b[j] = tmaxd(j == truth ? std::log(0.6) : std::log(0.4 / big));
+        streaming.step(log_b);
+        exact.step(log_b);
+        lagged.step(log_b);
+        beamed.step(log_b);
+        auto out = streaming.take_committed();
+        streamed.insert(streamed.end(), out.begin(), out.end());
+        max_window = std::max(max_window, lagged.frames() - lagged.committed_frames());
+    }
+    assert(streaming.committed_frames() > stream - 200);
+    assert(streaming.backpointer_bytes() < 200 * big);
+    assert(exact.committed_frames() == 0 && exact.backpointer_bytes() >= (stream - 1) * big / 8);
+    auto rest = streaming.path();
+    streamed.insert(streamed.end(), rest.begin(), rest.end());
+    auto exact_path = exact.path();
+    assert(streamed == exact_path && exact_path.size() == stream);
+    assert(approx_equal(streaming.best_score().value(), exact.best_score().value(), 1e-6));
+    assert(max_window <= 40);
+    assert(beamed.active_states() < big);
+    std::size_t matches = 0;
+    for (std::size_t t = 0; t < stream; ++t) matches += exact_path[t] == truths[t];
+    assert(matches > stream * 9 / 10);
+    // Lagged and beamed paths are still feasible under the model
+    for (const auto& p : {lagged.path(), beamed.path()}) {
+        assert(p.size() == stream);
+        for (std::size_t t = 1; t < stream; ++t) {
+            std::size_t step = (p[t] + big - p[t - 1]) % big;
+            assert(step == 0 || step == 1 || step == 7);
+        }
+    }
+
+    // Errors
+    bool threw = false;
+    try {
+        hmm_transitions<double>::from_dense(3, std::vector<tmaxd>(8));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        on_dense.step(std::vector<tmaxd>(2));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        hmm_forward<double>(dense, std::vector<lgd>(4));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED\n";
+}
+
+// ============= MODULAR TESTS =============
 void test_modular_comprehensive() {
     std::cout << "Testing modular transform (comprehensive)... ";
     
@@ -560,6 +1973,135 @@ void test_modular_comprehensive() {
     modular<int, 3> mod3(2);  // x = 2 (mod 3)
     modular<int, 5> mod5(3);  // x = 3 (mod 5)
     // Solution: x = 8 (mod 15)
+
+    // Odd moduli use Montgomery form, even moduli Barrett: same results
+    static_assert(std::is_same_v<mod7::engine_type, montgomery_reducer<uint32_t>>);
+    static_assert(std::is_same_v<modular<int, 256>::engine_type, barrett_reducer>);
+    static_assert(modular<int, 7>(3).pow(3).value() == 6);
+    modular<int, 256> even(300);
+    assert(even.value() == 44);
+    assert((even * modular<int, 256>(7)).value() == (44 * 7) % 256);
+    assert((modular<int, 256>(3) * modular<int, 256>(3).inverse()).value() == 1);
+    bool no_inverse = false;
+    try {
+        modular<int, 256>(4).inverse();
+    } catch (const std::runtime_error&) {
+        no_inverse = true;
+    }
+    assert(no_inverse);
+    assert((-mod7(3)).value() == 4);
+    assert(mod_prime(2).pow(-1).value() == 16);
+    assert((mod_prime(12) / mod_prime(3)).value() == 4);
+
+    // 64-bit moduli: the Goldilocks prime 2^64 - 2^32 + 1
+    const uint64_t p = 0xFFFFFFFF00000001ull;
+    mod_goldilocks g(p - 1);  // -1
+    assert((g * g).value() == 1);
+    assert((g + mod_goldilocks(5)).value() == 4);
+    assert(mod_goldilocks(7).pow(p - 1).value() == 1);  // Fermat
+    mod_goldilocks h(0x123456789ABCDEFull);
+    assert((h * h.inverse()).value() == 1);
+    unsigned __int128 wide = static_cast<unsigned __int128>(0x123456789ABCDEFull) * 0xFEDCBA987654321ull;
+    assert((h * mod_goldilocks(0xFEDCBA987654321ull)).value() == static_cast<uint64_t>(wide % p));
+
+    // Even 64-bit modulus falls back to 128-bit division
+    using mod_even64 = modular<uint64_t, (1ull << 40) + 2>;
+    static_assert(std::is_same_v<mod_even64::engine_type, wide_reducer>);
+    mod_even64 e((1ull << 39) + 12345);
+    unsigned __int128 sq = static_cast<unsigned __int128>((1ull << 39) + 12345) * ((1ull << 39) + 12345);
+    assert((e * e).value() == static_cast<uint64_t>(sq % ((1ull << 40) + 2)));
+
+    // Runtime-selected engine
+    modular_dynamic<int64_t> d(10, 1000000007);
+    assert((d * d.inverse()).value() == 1);
+    assert(d.pow(3).value() == 1000);
+    modular_dynamic<int> d_even(-3, 10);
+    assert(d_even.value() == 7);
+    assert((d_even * modular_dynamic<int>(9, 10)).value() == 3);
+    assert((d_even - modular_dynamic<int>(9, 10)).value() == 8);
+    assert((d_even * d_even.inverse()).value() == 1);
+
+    std::cout << "PASSED\n";
+}
+
+// ============= NTT TESTS =============
+void test_ntt_comprehensive() {
+    std::cout << "Testing number-theoretic transform (comprehensive)... ";
+    
+    using F = modular<uint32_t, 998244353u>;
+    std::mt19937 rng(7);
+    
+    // Round trip through forward and inverse transforms
+    for (size_t n : {size_t(1), size_t(2), size_t(8), size_t(8192)}) {
+        ntt998 plan(n);
+        std::vector<F> data(n), original;
+        for (auto& x : data) x = F(rng() % 998244353u);
+        original = data;
+        plan.forward(data);
+        plan.inverse(data);
+        assert(data == original);
+    }
+    
+    // Transform-domain product matches the schoolbook product
+    std::vector<F> a(300), b(257);
+    for (auto& x : a) x = F(rng() % 998244353u);
+    for (auto& x : b) x = F(rng() % 998244353u);
+    auto fast = ntt_convolve(a, b);
+    assert(fast.size() == a.size() + b.size() - 1);
+    for (size_t k : {size_t(0), size_t(1), size_t(200), size_t(555)}) {
+        F expected(0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (k >= i && k - i < b.size()) expected = expected + a[i] * b[k - i];
+        }
+        assert(fast[k] == expected);
+    }
+    
+    // (1 + x)^2 = 1 + 2x + x^2, also over the Goldilocks field
+    using G = modular<uint64_t, 0xFFFFFFFF00000001ull>;
+    std::vector<G> ones(64, G(1));
+    auto square = ntt_convolve(ones, ones);
+    assert(square[0].value() == 1 && square[63].value() == 64 && square[126].value() == 1);
+    
+    // Invalid plans are rejected
+    bool threw = false;
+    try {
+        ntt998 bad(12);
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Multi-prime: exact convolution beyond any single 32-bit prime
+    std::vector<uint64_t> big_a(100), big_b(80);
+    for (auto& x : big_a) x = rng();
+    for (auto& x : big_b) x = rng();
+    auto exact = ntt_convolve_exact(big_a, big_b);
+    for (size_t k : {size_t(0), size_t(50), size_t(178)}) {
+        unsigned __int128 expected = 0;
+        for (size_t i = 0; i < big_a.size(); ++i) {
+            if (k >= i && k - i < big_b.size()) {
+                expected += static_cast<unsigned __int128>(big_a[i]) * big_b[k - i];
+            }
+        }
+        assert(exact[k] == expected);
+    }
+    
+    // ...and convolution modulo a non-NTT-friendly modulus via base extension
+    const uint32_t m = 1000000007u;
+    std::vector<uint32_t> ma(70), mb(90);
+    for (auto& x : ma) x = rng() % m;
+    for (auto& x : mb) x = rng() % m;
+    auto modded = ntt_convolve_mod(ma, mb, m);
+    for (size_t k : {size_t(0), size_t(69), size_t(158)}) {
+        uint64_t expected = 0;
+        for (size_t i = 0; i < ma.size(); ++i) {
+            if (k >= i && k - i < mb.size()) {
+                expected = (expected + static_cast<uint64_t>(ma[i]) * mb[k - i]) % m;
+            }
+        }
+        assert(modded[k] == expected);
+    }
     
     std::cout << "PASSED\n";
 }
@@ -637,6 +2179,100 @@ void test_quaternion_comprehensive() {
     std::cout << "PASSED\n";
 }
 
+// ============= QUATERNION ARRAY TESTS =============
+void test_quaternion_array_comprehensive() {
+    std::cout << "Testing quaternion_array/vec3_array kernels (comprehensive)... ";
+    
+    std::mt19937_64 rng(20);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    auto random_rotation = [&] {
+        return quaternion<double>(dist(rng), dist(rng), dist(rng), dist(rng)).normalized();
+    };
+    auto close = [](const std::array<double, 3>& a, const std::array<double, 3>& b) {
+        return approx_equal(a[0], b[0], 1e-12) && approx_equal(a[1], b[1], 1e-12) &&
+               approx_equal(a[2], b[2], 1e-12);
+    };
+    
+    // Fast rotate and the rotation matrix agree with q·v·q*
+    for (int trial = 0; trial < 50; ++trial) {
+        auto q = random_rotation();
+        double vx = dist(rng), vy = dist(rng), vz = dist(rng);
+        auto full = q * quaternion<double>(0, vx, vy, vz) * q.conjugate();
+        std::array<double, 3> expected{full.x(), full.y(), full.z()};
+        assert(close(q.rotate(vx, vy, vz), expected));
+        auto m = q.to_rotation_matrix();
+        assert(close({m[0] * vx + m[1] * vy + m[2] * vz, m[3] * vx + m[4] * vy + m[5] * vz,
+                      m[6] * vx + m[7] * vy + m[8] * vz}, expected));
+        // The matrix of a scaled quaternion is the same rotation
+        auto m2 = (q * 3.0).to_rotation_matrix();
+        for (int k = 0; k < 9; ++k) assert(approx_equal(m[k], m2[k], 1e-12));
+    }
+    
+    // One quaternion × many points, and paired rotation
+    const std::size_t n = 37;
+    std::vector<std::array<double, 3>> points;
+    std::vector<quaternion<double>> rotations;
+    for (std::size_t i = 0; i < n; ++i) {
+        points.push_back({dist(rng), dist(rng), dist(rng)});
+        rotations.push_back(random_rotation());
+    }
+    auto cloud = vec3_array<double>::from_points(points);
+    auto q = random_rotation();
+    auto turned = cloud.rotated(q);
+    for (std::size_t i = 0; i < n; ++i) {
+        assert(close(turned.get(i), q.rotate(points[i][0], points[i][1], points[i][2])));
+    }
+    auto orientations = quaternion_array<double>::from_quaternions(rotations);
+    auto paired = orientations.rotate(cloud);
+    for (std::size_t i = 0; i < n; ++i) {
+        assert(close(paired.get(i), rotations[i].rotate(points[i][0], points[i][1], points[i][2])));
+    }
+    auto composed = orientations * orientations;
+    auto twice = orientations.rotate(paired);
+    auto once = composed.rotate(cloud);
+    for (std::size_t i = 0; i < n; ++i) assert(close(twice.get(i), once.get(i)));
+    
+    // Paired and shared-endpoint interpolation match the scalar versions
+    std::vector<quaternion<double>> targets;
+    for (std::size_t i = 0; i < n; ++i) targets.push_back(random_rotation());
+    targets[0] = rotations[0];                        // identical pair
+    targets[1] = rotations[1] * -1.0;                 // same rotation, opposite sign
+    auto ends = quaternion_array<double>::from_quaternions(targets);
+    for (double t : {0.0, 0.3, 1.0}) {
+        auto s = orientations.slerp(ends, t);
+        auto l = orientations.nlerp(ends, t);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto expected = rotations[i].slerp(targets[i], t);
+            auto lerp = rotations[i].nlerp(targets[i], t);
+            assert(approx_equal(s.get(i).w(), expected.w(), 1e-9));
+            assert(approx_equal(s.get(i).x(), expected.x(), 1e-9));
+            assert(approx_equal(s.get(i).z(), expected.z(), 1e-9));
+            assert(approx_equal(l.get(i).y(), lerp.y(), 1e-12));
+            assert(approx_equal(l.get(i).norm(), 1.0, 1e-12));
+        }
+    }
+    std::vector<double> ts{0.0, 0.25, 0.5, 0.75, 1.0};
+    auto a = quaternion<double>::from_axis_angle(0, 0, 1, 0.2);
+    auto b = quaternion<double>::from_axis_angle(0, 0, 1, 2.2);
+    auto path = quaternion_array<double>::from_slerp(a, b, ts);
+    auto fast_path = quaternion_array<double>::from_nlerp(a, b, ts);
+    for (std::size_t i = 0; i < ts.size(); ++i) {
+        // Constant angular velocity: angle 0.2 + 2·tᵢ
+        assert(approx_equal(2 * std::acos(path.get(i).w()), 0.2 + 2.0 * ts[i], 1e-9));
+        assert(approx_equal(fast_path.get(i).norm(), 1.0, 1e-12));
+        auto expected = a.nlerp(b, ts[i]);
+        assert(approx_equal(fast_path.get(i).w(), expected.w(), 1e-12));
+    }
+    auto near = quaternion_array<double>::from_slerp(a, a, ts);
+    assert(approx_equal(near.get(2).w(), a.w(), 1e-12));
+    
+    bool rejected = false;
+    try { orientations.rotate(vec3_array<double>(n + 1)); } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
+    std::cout << "PASSED\n";
+}
+
 // ============= MAPPINGS TESTS =============
 void test_mappings_comprehensive() {
     std::cout << "Testing mappings utilities (comprehensive)... ";
@@ -700,6 +2336,227 @@ void test_mappings_comprehensive() {
     std::cout << "PASSED\n";
 }
 
+void test_conversion_graph_comprehensive() {
+    std::cout << "Testing conversion graph (comprehensive)... ";
+    using namespace cbt::mappings;
+    using ms3 = multiscale<double, 3>;
+    using ms6 = multiscale<double, 6>;
+
+    // Cheapest routes stay in representation space
+    using trop_to_ms = cbt_converter<tropical_min<double>, ms3>;
+    static_assert(trop_to_ms::exists && trop_to_ms::hops == 2, "tropical -> lg -> multiscale");
+    static_assert(trop_to_ms::cost == conversion_cost::relabel + conversion_cost::transcendental, "");
+    using ms_to_ms = cbt_converter<ms3, ms6>;
+    static_assert(ms_to_ms::cost == 2 * conversion_cost::transcendental, "multiscale rescaling goes via lg");
+    static_assert(cbt_converter<lgd, lgd>::cost == 0 && cbt_converter<lgd, lgd>::hops == 0, "");
+    static_assert(!cbt_converter<int, lgd>::exists, "");
+
+    // Routes never form the real value: 1e300 · 1e300 rescales without overflow
+    ms3 huge = ms3(1e300) * ms3(1e300);
+    ms6 rescaled = ms_to_ms::convert(huge);
+    assert(approx_equal(multiscale_to_lg(rescaled).log(), 600 * std::log(10.0), 1e-9));
+    assert(rescaled.mantissa() >= 1e-6 && rescaled.mantissa() < 1);
+    assert(approx_equal(convert<ms3>(tropical_min<double>(std::log(12345.0))).to_value(), 12345.0, 1e-8));
+    assert(convert<lgd>(tropical_min<double>()).log() == -std::numeric_limits<double>::infinity());
+    assert(approx_equal(cbt_network<double>::convert<interval<double>>(lgd(4.0)).mid(), 4.0, 1e-12));
+
+    // lg -> multiscale keeps the level in range (no int8_t wrap) and normalizes
+    ms3 big = lg_to_multiscale(lgd::from_log(600.0));   // e^600 ≈ 3.77e260
+    assert(big.scale_level() == 87);
+    assert(big.mantissa() >= 1e-3 && big.mantissa() < 1);
+    assert(approx_equal(multiscale_to_lg(big).log(), 600.0, 1e-12));
+    assert(lg_to_multiscale(lgd::from_log(1000.0)).scale_level() == 127);   // saturates
+    assert(lg_to_multiscale(lgd(0.0)).mantissa() == 0);
+    ms3 thousand = lg_to_multiscale(lgd(1000.0 * (1 + 1e-12)));
+    assert(thousand.scale_level() == 2 && approx_equal(thousand.mantissa(), 1e-3, 1e-15));
+
+    // Via dual works in the log domain, so e^800 survives
+    ms3 via = cbt_network<double>::lg_to_multiscale_via_dual(lgd::from_log(800.0));
+    assert(via.scale_level() == 116);
+    assert(approx_equal(multiscale_to_lg(via).log(), 800.0, 1e-9));
+
+    // Batches match element-wise conversion, including the scalar tail
+    std::vector<lgd> logs;
+    for (int i = 0; i < 37; ++i) logs.push_back(lgd::from_log(-700.0 + 41.3 * i));
+    logs.push_back(lgd(0.0));
+    std::vector<ms3> scaled = convert_batch<ms3>(logs);
+    std::vector<lgd> round_trip = convert_batch<lgd>(scaled);
+    std::vector<tropical_min<double>> tropical = convert_batch<tropical_min<double>>(logs);
+    for (std::size_t i = 0; i < logs.size(); ++i) {
+        ms3 expected = lg_to_multiscale(logs[i]);
+        assert(scaled[i].mantissa() == expected.mantissa() && scaled[i].scale_level() == expected.scale_level());
+        assert(round_trip[i].log() == multiscale_to_lg(expected).log());
+        assert(tropical[i].value() == logs[i].log());
+    }
+    assert(approx_equal(round_trip[5].log(), logs[5].log(), 1e-12));
+    std::vector<ms6> rescaled_batch = convert_batch<ms6>(scaled);
+    assert(rescaled_batch[20].mantissa() == ms_to_ms::convert(scaled[20]).mantissa());
+
+    // Mismatched spans throw
+    std::vector<ms3> short_out(3);
+    bool threw = false;
+    try {
+        convert_batch(span<const lgd>(logs), span<ms3>(short_out));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED\n";
+}
+
+void test_adaptive_comprehensive() {
+    std::cout << "Testing adaptive representation selection (comprehensive)... ";
+    using Array = adaptive_array<double>;
+    using rep = adaptive_representation;
+    const auto policy = Array::policy_type::defaults();
+    const std::size_t n = 64;
+
+    // Near 1: stays plain, bit-identical to plain arithmetic
+    std::vector<double> start(n), factors(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        start[i] = 0.5 + 0.02 * static_cast<double>(i);
+        factors[i] = 0.9 + 0.003 * static_cast<double>(i);
+    }
+    auto near_one = Array::from_values(start, policy);
+    std::vector<double> expected = start;
+    for (int batch = 0; batch < 20; ++batch) {
+        near_one.multiply(factors);
+        near_one.add(factors);
+        for (std::size_t i = 0; i < n; ++i) expected[i] = expected[i] * factors[i] + factors[i];
+    }
+    assert(near_one.representation() == rep::plain);
+    assert(near_one.switches() == 0);
+    assert(near_one.to_values() == expected);
+
+    // Positive drift: moves to lg before leaving max_exponent / 2, then
+    // tracks the log exactly far beyond the range of double
+    auto drifting = Array::from_values(std::vector<double>(n, 1.0), policy);
+    const std::vector<double> tiny(n, 1e-30);
+    for (int batch = 0; batch < 5; ++batch) drifting.multiply(tiny);
+    assert(drifting.representation() == rep::plain);   // 1e-150 is within 2^-512
+    drifting.multiply(tiny);
+    assert(drifting.representation() == rep::lg);
+    for (int batch = 6; batch < 100; ++batch) drifting.multiply(tiny);
+    assert(drifting.switches() == 1);
+    assert(std::abs(drifting.to_lg()[7].log() - 100 * std::log(1e-30)) < 1e-9 * 6908);
+    assert(drifting.get(0) == 0.0);                     // underflows in the real domain only
+
+    // ... and back to plain once the values return to range
+    const std::vector<double> huge(n, 1e30);
+    for (int batch = 0; batch < 97; ++batch) drifting.multiply(huge);
+    assert(drifting.representation() == rep::plain);
+    assert(std::abs(drifting.get(3) - 1e-90) < 1e-90 * 1e-9);
+
+    // Signed values cannot use lg: wide range goes to multiscale
+    std::vector<double> signs(n);
+    for (std::size_t i = 0; i < n; ++i) signs[i] = i % 2 == 0 ? 1.0 : -1.0;
+    auto signed_wide = Array::from_values(signs, policy);
+    const std::vector<double> big(n, 1e100);
+    for (int batch = 0; batch < 3; ++batch) signed_wide.multiply(big);
+    assert(signed_wide.representation() == rep::multiscale);
+    assert(std::abs(signed_wide.get(1) + 1e300) < 1e300 * 1e-9);
+    assert(signed_wide.to_multiscale().get(0).scale_level() > 0);
+
+    // A negative term forces lg out; the selector never picks an unsafe one
+    auto positive = Array::from_values(std::vector<double>(n, 1e-200), policy);
+    assert(positive.representation() == rep::lg);
+    std::vector<double> terms(n, 1e-200);
+    terms[5] = -3e-200;
+    positive.add(terms);
+    assert(positive.representation() == rep::multiscale);
+    assert(std::abs(positive.get(5) + 2e-200) < 1e-209);
+    assert(std::abs(positive.get(4) - 2e-200) < 1e-209);
+
+    // Selector: safety first, then cost, with hysteresis
+    adaptive_profile wide;
+    wide.min_log2 = -1000;
+    wide.max_log2 = 10;
+    assert(!policy.holds(rep::plain, wide) && policy.holds(rep::lg, wide));
+    assert(policy.select(wide, rep::plain) == rep::lg);
+    wide.negative = true;
+    assert(policy.select(wide, rep::lg) == rep::multiscale);
+    adaptive_profile narrow;
+    narrow.min_log2 = -3;
+    narrow.max_log2 = 3;
+    narrow.multiplies = 100;
+    assert(policy.select(narrow, rep::lg) == rep::plain);
+    auto close = policy;
+    close.multiply_cost = {1.0, 1.2, 5.0};
+    assert(close.select(narrow, rep::lg) == rep::lg);   // within switch_margin
+    assert(adaptive_profile().all_zero() && policy.holds(rep::plain, adaptive_profile()));
+    adaptive_profile beyond = wide;
+    beyond.min_log2 = -2000;   // about 10^-602: past the multiscale levels
+    assert(!policy.holds(rep::multiscale, beyond) && policy.holds(rep::multiscale, wide));
+    beyond.negative = false;
+    assert(policy.select(beyond, rep::multiscale) == rep::lg);
+
+    // Contents beyond 10^-381 stay in lg even where multiscale is cheaper,
+    // and a negative term then has nowhere to go
+    auto cheap_multiscale = policy;
+    cheap_multiscale.add_cost[2] = 20;
+    auto deep = Array::from_values(std::vector<double>(n, 1.0), cheap_multiscale);
+    for (int batch = 0; batch < 100; ++batch) deep.multiply(tiny);
+    const std::vector<double> no_terms(n, 0.0);
+    for (int batch = 0; batch < 4; ++batch) deep.add(no_terms);
+    assert(deep.representation() == rep::lg);
+    assert(std::abs(deep.to_lg()[0].log() - 100 * std::log(1e-30)) < 1e-9 * 6908);
+    bool overflowed = false;
+    try {
+        deep.convert_to(rep::multiscale);
+    } catch (const std::overflow_error&) {
+        overflowed = true;
+    }
+    assert(overflowed && deep.representation() == rep::lg);
+    overflowed = false;
+    try {
+        deep.add(terms);
+    } catch (const std::overflow_error&) {
+        overflowed = true;
+    }
+    assert(overflowed && deep.representation() == rep::lg);
+    assert(std::abs(deep.to_lg()[5].log() - 100 * std::log(1e-30)) < 1e-9 * 6908);
+
+    // Zeros stay plain under any factor
+    auto zeros = Array::from_values(std::vector<double>(n, 0.0), policy);
+    zeros.multiply(big);
+    assert(zeros.representation() == rep::plain && zeros.get(0) == 0.0);
+
+    // Errors
+    bool threw = false;
+    try {
+        near_one.multiply(std::vector<double>(n + 1, 1.0));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        signed_wide.convert_to(rep::lg);
+    } catch (const std::domain_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        adaptive_policy<double>::calibrate(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Calibration measures every kernel
+    auto measured = adaptive_policy<float>::calibrate(256, 2);
+    for (std::size_t r = 0; r < adaptive_representation_count; ++r) {
+        assert(measured.multiply_cost[r] > 0 && std::isfinite(measured.multiply_cost[r]));
+        assert(measured.add_cost[r] > 0 && std::isfinite(measured.add_cost[r]));
+    }
+    assert(std::string(name(rep::multiscale)) == "multiscale");
+    assert(std::string(instrumentation::name(instrumentation::counter::adaptive_switches)) == "adaptive.switches");
+
+    std::cout << "PASSED\n";
+}
+
 // ============= COMPOSED TRANSFORM TESTS =============  
 void test_composed_comprehensive() {
     std::cout << "Testing composed transforms (comprehensive)... ";
@@ -731,6 +2588,66 @@ void test_composed_comprehensive() {
     assert(posterior3.to_probability() > 0.001 && 
            posterior3.to_probability() < posterior1.to_probability());
     
+    // Precomputed LLRs match the textbook likelihood ratios
+    assert(approx_equal(diagnostic.positive_llr(0), std::log(0.95 / 0.10), 1e-12));
+    assert(approx_equal(diagnostic.negative_llr(1), std::log(0.15 / 0.95), 1e-12));
+    log_odds<double> streamed = diagnostic.prior();
+    streamed = diagnostic.posterior(streamed, 0, true);
+    streamed = diagnostic.posterior(streamed, 1, false);
+    assert(approx_equal(streamed.value(), diagnostic.posterior(mixed).value(), 1e-12));
+    static_assert(std::is_same_v<decltype(diagnostic.update(mixed)), odds_ratio<double>>);
+    
+    // A perfect test has an infinite LLR; only its observed outcome counts
+    bayesian_diagnostic<double> perfect(0.01);
+    perfect.add_test(1.0, 0.9);
+    perfect.add_test(0.8, 0.9);
+    const double finite_part = std::log(0.01 / 0.99) + std::log(1.0 / 0.1) + std::log(0.8 / 0.1);
+    assert(approx_equal(perfect.posterior(both_pos).value(), finite_part, 1e-12));
+    assert(perfect.posterior(std::vector<bool>{false, true}).value() == -std::numeric_limits<double>::infinity());
+    assert(approx_equal(perfect.update(both_pos).value(), std::exp(finite_part), 1e-12));
+    auto flagged = perfect.update_batch(std::vector<std::uint64_t>{3, 2});
+    assert(approx_equal(flagged[0].value(), finite_part, 1e-12) && std::isinf(flagged[1].value()));
+    assert(approx_equal(posterior3.value(), std::exp(streamed.value()), 1e-12));
+    
+    // 100 tests span two packed words; dense and sparse words agree with
+    // a direct sum of log-likelihood ratios
+    bayesian_diagnostic<double> panel(0.001);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> rate(0.55, 0.99);
+    std::vector<double> sens, spec;
+    for (int i = 0; i < 100; ++i) {
+        sens.push_back(rate(rng));
+        spec.push_back(rate(rng));
+        panel.add_test(sens.back(), spec.back());
+    }
+    assert(panel.words_per_record() == 2);
+    std::vector<std::uint64_t> batch;
+    std::vector<double> expected;
+    for (int r = 0; r < 50; ++r) {
+        std::uint64_t w0 = r % 3 == 0 ? (std::uint64_t(1) << (r % 64)) : rng();
+        std::uint64_t w1 = rng();  // bits past test 99 must be ignored
+        double direct = std::log(0.001 / 0.999);
+        std::vector<bool> unpacked(100);
+        for (int i = 0; i < 100; ++i) {
+            bool positive = ((i < 64 ? w0 >> i : w1 >> (i - 64)) & 1) != 0;
+            unpacked[i] = positive;
+            direct += positive ? std::log(sens[i] / (1 - spec[i]))
+                               : std::log((1 - sens[i]) / spec[i]);
+        }
+        batch.push_back(w0);
+        batch.push_back(w1);
+        expected.push_back(direct);
+        assert(approx_equal(panel.posterior(unpacked).value(), direct, 1e-9));
+    }
+    auto scored = panel.update_batch(batch);
+    assert(scored.size() == 50);
+    for (size_t r = 0; r < scored.size(); ++r) {
+        assert(approx_equal(scored[r].value(), expected[r], 1e-9));
+    }
+    bool rejected = false;
+    try { panel.update_batch(std::vector<std::uint64_t>(3)); } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
     // Test combined transforms
     // Multiscale logarithmic for extreme multiplication
     multiscale<double, 3> huge(1e50);
@@ -738,6 +2655,49 @@ void test_composed_comprehensive() {
     auto extreme = huge * tiny;
     assert(approx_equal(extreme.to_value(), 1.0));
     
+    // Native (scale, log-mantissa) composition
+    using MSL = multiscale_log<double>;
+    MSL planck(1.616e-35), cosmos(8.8e26);
+    assert(approx_equal((planck * cosmos).to_value(), 1.616e-35 * 8.8e26, 1e-20));
+    assert(approx_equal((cosmos / planck).log(), std::log(8.8e26 / 1.616e-35), 1e-12));
+    assert(approx_equal((MSL(3.0) + MSL(4.0)).to_value(), 7.0, 1e-12));
+    assert(MSL(3.0) + MSL() == MSL(3.0));
+    assert(MSL() + MSL() == MSL());
+    assert(MSL() < MSL(1e-300) && MSL(1e-300) < MSL(2.0) && MSL(2.0) < cosmos);
+    
+    // 10^±200000: far outside double, relative precision kept
+    MSL big = cosmos;
+    for (int i = 0; i < 14; ++i) big = big * big;  // cosmos^16384
+    double expected_log = 16384 * std::log(8.8e26);
+    assert(approx_equal(big.log() / expected_log, 1.0, 1e-13));
+    assert(big.log_mantissa() >= 0 && big.log_mantissa() < MSL::window);
+    assert(approx_equal((big / big).to_value(), 1.0, 1e-9));
+    assert(approx_equal(big.pow(0.5).log(), expected_log / 2, 1e-6));
+    assert(big + MSL(1.0) == big);
+    assert(MSL(lgd(5.0)) == MSL(5.0));
+    assert(approx_equal(MSL(5.0).to_lg().value(), 5.0, 1e-12));
+    
+    // SoA batch kernels agree with the scalar type
+    std::vector<double> xs = {1e-300, 2.5e-100, 0.0, 1.0, 42.0, 7e80, 1e300};
+    std::vector<double> ys = {3e200, 4e90, 5.0, 0.25, 1e-3, 1e-80, 2e-240};
+    auto xa = multiscale_log_array<double>::from_values(xs);
+    auto ya = multiscale_log_array<double>::from_values(ys);
+    auto prod = xa * ya;
+    auto total = xa + ya;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        assert(xa.get(i) == MSL(xs[i]));
+        assert(prod.get(i) == MSL(xs[i]) * MSL(ys[i]));
+        assert(approx_equal(total.get(i).log(), (MSL(xs[i]) + MSL(ys[i])).log(), 1e-12));
+    }
+    // Π of the nonzero elements; Σ dominated by the largest term
+    double log_product = 0;
+    for (double x : xs) if (x > 0) log_product += std::log(x);
+    auto live = multiscale_log_array<double>::from_values(std::vector<double>{1e-300, 2.5e-100, 1.0, 42.0, 7e80, 1e300});
+    assert(approx_equal(live.product().log(), log_product, 1e-10));
+    assert(xa.product().is_zero());
+    assert(approx_equal(xa.sum().log(), std::log(1e300 + 7e80), 1e-12));
+    assert(multiscale_log_array<double>(4).sum().is_zero());
+    
     // Interval with modular arithmetic for cryptographic bounds
     interval<double> key_range(0, 255);
     modular<int, 256> key_mod(300);  // Wraps to 44
@@ -747,7 +2707,516 @@ void test_composed_comprehensive() {
     std::cout << "PASSED\n";
 }
 
+// ============= LOG-ODDS SCORER TESTS =============
+void test_log_odds_scorer_comprehensive() {
+    std::cout << "Testing log_odds_scorer sparse scoring (comprehensive)... ";
+    
+    // Dense naive Bayes: score = prior + Σ weights of active features
+    log_odds_scorer<double> dense(100, log_odds<double>::from_probability(0.2));
+    dense.add_weight(3, std::log(4.0));
+    dense.add_weight(7, -std::log(2.0));
+    dense.add_weight(3, std::log(0.5));  // accumulates: log 2
+    assert(approx_equal(dense.weight(3), std::log(2.0)));
+    assert(dense.weight(99) == 0.0 && dense.weight(1000) == 0.0);
+    std::vector<std::uint64_t> doc = {3, 7, 50, 3};
+    auto s = dense.score(doc);
+    assert(approx_equal(s.value(), std::log(0.25) + 2 * std::log(2.0) - std::log(2.0)));
+    assert(approx_equal(dense.probability(span<const std::uint64_t>(doc)), s.to_probability()));
+    bool rejected = false;
+    try { dense.add_weight(100, 1.0); } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
+    // Hashed table over arbitrary 64-bit ids, batch scoring in CSR layout
+    hashed_log_odds_scorer<double> hashed(1000);
+    assert(hashed.table().capacity() >= 2000);
+    std::mt19937_64 rng(11);
+    std::vector<std::uint64_t> ids(500);
+    for (auto& id : ids) id = rng() >> 1;
+    for (size_t i = 0; i < ids.size(); ++i) hashed.add_weight(ids[i], 0.01 * double(i));
+    std::vector<std::uint64_t> features;
+    std::vector<std::size_t> offsets = {0};
+    std::vector<double> expected;
+    for (int d = 0; d < 40; ++d) {
+        double total = 0;
+        for (int k = 0; k < d; ++k) {  // document d has d features, some unseen
+            size_t pick = (d * 31 + k * 17) % 600;
+            features.push_back(pick < ids.size() ? ids[pick] : rng() >> 1);
+            total += pick < ids.size() ? 0.01 * double(pick) : 0.0;
+        }
+        offsets.push_back(features.size());
+        expected.push_back(total);
+    }
+    auto scores = hashed.score_batch(features, offsets);
+    assert(scores.size() == 40);
+    for (size_t d = 0; d < scores.size(); ++d) {
+        assert(approx_equal(scores[d].value(), expected[d], 1e-9));
+    }
+    hashed_log_odds_scorer<double> tiny(1);
+    tiny.add_weight(1, 1.0);
+    tiny.add_weight(2, 1.0);
+    bool full = false;
+    try { tiny.add_weight(3, 1.0); } catch (const std::runtime_error&) { full = true; }
+    assert(full);
+    
+    // Online logistic regression separates a linearly separable stream
+    log_odds_scorer<double> model(4);
+    for (int epoch = 0; epoch < 200; ++epoch) {
+        model.train(std::vector<std::uint64_t>{0, 2}, true, 0.5);
+        model.train(std::vector<std::uint64_t>{1, 2}, false, 0.5);
+    }
+    assert(model.score(std::vector<std::uint64_t>{0, 2}).to_probability() > 0.95);
+    assert(model.score(std::vector<std::uint64_t>{1, 2}).to_probability() < 0.05);
+    
+    // Lock-free updates: concurrent writers lose no increments
+    hashed_log_odds_scorer<double> shared(64);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&shared] {
+            for (int i = 0; i < 2000; ++i) shared.add_weight(std::uint64_t(i % 16), 1.0);
+        });
+    }
+    for (auto& w : writers) w.join();
+    for (std::uint64_t f = 0; f < 16; ++f) assert(shared.weight(f) == 500.0);
+    
+    std::cout << "PASSED\n";
+}
+
 // ============= EDGE CASES AND ERROR CONDITIONS =============
+void test_instrumentation_comprehensive() {
+    std::cout << "Testing instrumentation counters (comprehensive)... ";
+    using instrumentation::counter;
+    using live = instrumentation::policy<true>;
+
+    // The disabled policy is a stub
+    instrumentation::policy<false>::count(counter::lg_ops, 5);
+    auto stub = instrumentation::policy<false>::snapshot();
+    for (std::uint64_t v : stub.values) assert(v == 0);
+
+    // Hooks in the transforms (the test target builds with CBT_INSTRUMENTATION=1)
+    if constexpr (instrumentation::enabled) {
+        auto before = instrumentation::snapshot();
+        lgd two(2.0), nothing(0.0);
+        lgd product = two * two / two + nothing;
+        double overflowed = lgd::from_log(1000.0).value();
+        assert(std::isinf(overflowed) && product.log() > 0);
+
+        multiscale<double, 3> top = multiscale<double, 3>::from_normalized(0.5, 127);
+        multiscale<double, 3> saturated = top * top;
+        assert(saturated.scale_level() == 127);
+
+        interval<double> unit(1.0, 2.0), hundred(100.0, 101.0), straddle(-1.0, 1.0);
+        interval<double> wide = unit * hundred;
+        assert(std::isinf((unit / straddle).upper()) && wide.width() > 100);
+
+        using RNS3 = residue_number_system<int32_t, 3>;
+        assert((RNS3::from_integer(6) * RNS3::from_integer(7)).to_integer() == 42);
+
+        std::vector<lgd> logs(10, two);
+        auto scaled = mappings::convert_batch<multiscale<double>>(logs);
+        assert(scaled.size() == 10);
+
+        auto delta = instrumentation::snapshot() - before;
+        assert(delta[counter::lg_conversions] == 3);
+        assert(delta[counter::lg_zero] == 1);
+        assert(delta[counter::lg_ops] == 3);
+        assert(delta[counter::lg_value_saturations] == 1);
+        assert(delta[counter::multiscale_ops] == 1);
+        assert(delta[counter::multiscale_saturations] == 1);
+        assert(delta[counter::multiscale_normalizations] >= 1);
+        assert(delta[counter::interval_ops] == 2);
+        assert(delta[counter::interval_division_entire] == 1);
+        assert(delta[counter::interval_width_growth_bits] == 6);   // width 1 → 101
+        assert(delta[counter::rns_ops] == 1);
+        assert(delta[counter::rns_reconstructions] == 1);
+        assert(delta[counter::conversions] == 10);
+
+        // Counting stops during constant evaluation, so constexpr use still compiles
+        constexpr lgd folded = lgd(3.0) * lgd(4.0);
+        static_assert(folded.log() > 2.48 && folded.log() < 2.49, "");
+    }
+
+    // Per-thread blocks merge on read and survive their threads
+    auto start = live::snapshot();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) live::count(counter::rns_reconstructions);
+        });
+    }
+    for (auto& w : workers) w.join();
+    assert((live::snapshot() - start)[counter::rns_reconstructions] == 4000);
+    std::thread reuse([] { live::count(counter::rns_reconstructions, 25); });
+    reuse.join();
+    assert((live::snapshot() - start)[counter::rns_reconstructions] == 4025);
+
+    // Export names for a metrics system
+    std::size_t named = 0;
+    live::snapshot().for_each([&](const char* metric, std::uint64_t) {
+        assert(metric != nullptr && std::string(metric).find('.') != std::string::npos);
+        ++named;
+    });
+    assert(named == instrumentation::counter_count);
+    assert(std::string(instrumentation::name(counter::rns_reconstructions)) == "rns.reconstructions");
+
+    std::cout << "PASSED\n";
+}
+
+void test_parallel_comprehensive() {
+    std::cout << "Testing parallel reduce/scan (comprehensive)... ";
+
+    // Declared algebra
+    static_assert(is_monoid_v<lgd, std::multiplies<>>, "");
+    static_assert(monoid_traits<quatd, std::multiplies<>>::associative, "");
+    static_assert(!monoid_traits<quatd, std::multiplies<>>::commutative, "");
+    static_assert(monoid_traits<tropical_min<double>, std::plus<>>::commutative, "");
+    static_assert(!is_monoid_v<quatd, std::minus<>>, "");
+    assert((monoid_traits<lgd, std::multiplies<>>::identity().log() == 0.0));
+    assert((monoid_traits<tropical_min<double>, std::plus<>>::identity().is_infinite()));
+
+    thread_pool pool(4), single(1);
+    inline_executor sequential;
+    assert(pool.concurrency() == 4 && single.concurrency() == 1);
+
+    // Exact sums agree with the closed form for any executor
+    std::vector<long long> counts(100000);
+    for (std::size_t i = 0; i < counts.size(); ++i) counts[i] = static_cast<long long>(i) + 1;
+    const long long expected = 100000LL * 100001 / 2;
+    assert(parallel_reduce(counts) == expected);
+    assert(parallel_reduce(counts, std::plus<>(), pool, 1000) == expected);
+    assert(parallel_reduce(counts, std::plus<>(), inline_executor(), 7) == expected);
+    assert(parallel_reduce(std::vector<long long>()) == 0);
+
+    // Floating-point results depend on the grain only, not the thread count
+    std::mt19937_64 rng(27);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> noisy(50000);
+    for (auto& x : noisy) x = uniform(rng) * std::pow(10.0, uniform(rng) * 8);
+    double reference = parallel_reduce(noisy, std::plus<>(), sequential, 512);
+    assert(parallel_reduce(noisy, std::plus<>(), pool, 512) == reference);
+    assert(parallel_reduce(noisy, std::plus<>(), single, 512) == reference);
+    assert(parallel_reduce(noisy, std::plus<>(), thread_pool::shared(), 512) == reference);
+
+    // lg products never leave the log domain
+    std::vector<lgd> halves(20000, lgd(0.5));
+    lgd tiny = parallel_reduce(halves, std::multiplies<>(), pool, 256);
+    assert(approx_equal(tiny.log(), 20000 * std::log(0.5), 1e-6));
+    assert(approx_equal(parallel_reduce(halves, std::plus<>(), pool, 256).value(), 10000.0, 1e-6));
+
+    // Quaternion prefix products keep operand order
+    std::vector<quatd> steps;
+    for (int i = 0; i < 3000; ++i) {
+        steps.push_back(quatd::from_axis_angle(uniform(rng), uniform(rng), uniform(rng), uniform(rng)));
+    }
+    std::vector<quatd> path = parallel_inclusive_scan(steps, std::multiplies<>(), pool, 64);
+    assert(path.size() == steps.size());
+    quatd running = steps[0];
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        if (i > 0) running = running * steps[i];
+        quatd diff = path[i] - running;
+        assert(diff.norm() < 1e-9);
+    }
+    quatd total = parallel_reduce(steps, std::multiplies<>(), pool, 64);
+    assert((total - running).norm() < 1e-9);
+    std::vector<quatd> reversed(steps.rbegin(), steps.rend());
+    assert((parallel_reduce(reversed, std::multiplies<>(), pool, 64) - running).norm() > 1e-3);
+
+    // Tropical scans: running minimum and prefix path lengths, exactly
+    std::vector<tropical_min<double>> costs;
+    for (int i = 0; i < 5000; ++i) costs.emplace_back(static_cast<double>((i * 7919) % 1000));
+    auto minima = parallel_inclusive_scan(costs, std::plus<>(), pool, 100);
+    auto lengths = parallel_inclusive_scan(costs, std::multiplies<>(), pool, 100);
+    double best = costs[0].value(), length = 0;
+    for (std::size_t i = 0; i < costs.size(); ++i) {
+        best = std::min(best, costs[i].value());
+        length += costs[i].value();
+        assert(minima[i].value() == best && lengths[i].value() == length);
+    }
+
+    // DP transfer matrices compose as a non-commutative monoid
+    std::vector<tropical_matrix<double, 2>> transfers(300);
+    for (std::size_t i = 0; i < transfers.size(); ++i) {
+        transfers[i].set(0, 0, double(i % 3));
+        transfers[i].set(0, 1, double(i % 5));
+        transfers[i].set(1, 0, 1.0);
+        transfers[i].set(1, 1, double(i % 2));
+    }
+    auto composed = tropical_matrix<double, 2>::identity();
+    for (const auto& m : transfers) composed = composed * m;
+    auto parallel_composed = parallel_reduce(transfers, std::multiplies<>(), pool, 16);
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t j = 0; j < 2; ++j) assert(parallel_composed.get(i, j) == composed.get(i, j));
+    }
+
+    // Residues, and in-place scans through spans
+    using mod = modular<uint32_t, 1000000007u>;
+    std::vector<mod> factors;
+    for (uint32_t i = 1; i <= 1000; ++i) factors.emplace_back(i);
+    std::vector<mod> factorials(factors);
+    parallel_inclusive_scan(span<const mod>(factorials), span<mod>(factorials), std::multiplies<>(), pool, 33);
+    mod factorial(1);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        factorial = factorial * factors[i];
+        assert(factorials[i].value() == factorial.value());
+    }
+    assert(parallel_reduce(factors, std::multiplies<>(), pool, 33).value() == factorial.value());
+
+    // Nested bulk jobs and exceptions from tasks
+    std::vector<std::atomic<int>> hits(64);
+    pool.bulk(8, [&](std::size_t outer) {
+        pool.bulk(8, [&](std::size_t inner) { hits[outer * 8 + inner].fetch_add(1); });
+    });
+    for (const auto& h : hits) assert(h.load() == 1);
+
+    bool threw = false;
+    try {
+        pool.bulk(100, [](std::size_t i) {
+            if (i == 37) throw std::runtime_error("task failed");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        parallel_reduce(counts, std::plus<>(), pool, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        std::vector<double> shorter(3);
+        parallel_inclusive_scan(span<const double>(noisy), span<double>(shorter));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED\n";
+}
+
+void test_serialization_comprehensive() {
+    std::cout << "Testing memory-mapped serialization (comprehensive)... ";
+    const std::string path = std::filesystem::temp_directory_path() / "cbt_serialization_test.cbt";
+
+    // lg: the mapped logs are bit-identical and usable as an expression
+    std::vector<double> probs = {0.5, 1e-300, 0.0, 2.0, 0.125};
+    lg_vector<double> logs(probs);
+    save_array(path, logs);
+    {
+        mapped_lg_vector<double> mapped(path);
+        assert(mapped.size() == probs.size());
+        assert(reinterpret_cast<std::uintptr_t>(mapped.data()) % array_alignment == 0);
+        for (std::size_t i = 0; i < logs.size(); ++i) {
+            assert(std::memcmp(&mapped.logs()[i], &logs.logs()[i], sizeof(double)) == 0);
+        }
+        assert(mapped[2].log() == -std::numeric_limits<double>::infinity());
+        lg_vector<double> squared = mapped * logs;
+        assert(approx_equal(squared[3].value(), 4.0));
+        assert(reduce_product(mapped).log() == -std::numeric_limits<double>::infinity());
+        assert(approx_equal(mapped.to_array().sum().log(), logs.sum().log()));
+
+        // Copies share the mapping and outlive the original view
+        mapped_lg_vector<double> copy = mapped;
+        mapped = mapped_lg_vector<double>(path);
+        assert(copy.log_at(0) == logs.log_at(0));
+    }
+
+    // log_odds
+    std::vector<log_odds<float>> evidence = {log_odds<float>(-3.5f), log_odds<float>(0.0f),
+                                             log_odds<float>::from_probability(0.9f)};
+    save_array(path, evidence);
+    {
+        mapped_log_odds_array<float> mapped(path);
+        assert(mapped.size() == 3);
+        for (std::size_t i = 0; i < evidence.size(); ++i) assert(mapped[i].value() == evidence[i].value());
+        assert(mapped.to_array().back().value() == evidence.back().value());
+    }
+
+    // multiscale: normalized parts stored as is, including the scale column
+    using MS = multiscale_array<double, 3>;
+    auto ms = MS::from_values(std::vector<double>{1e-250, 3.0, -7e200, 0.0, 42.0});
+    save_array(path, ms);
+    {
+        mapped_multiscale_array<double, 3> mapped(path);
+        assert(mapped.size() == ms.size());
+        assert(reinterpret_cast<std::uintptr_t>(mapped.scales().data()) % array_alignment == 0);
+        for (std::size_t i = 0; i < ms.size(); ++i) {
+            assert(mapped.mantissas()[i] == ms.mantissas()[i]);
+            assert(mapped.scales()[i] == ms.scales()[i]);
+            assert(mapped.get(i).to_value() == ms.get(i).to_value());
+        }
+        assert(mapped.to_array().sum().to_value() == ms.sum().to_value());
+
+        // SCALE_FACTOR is part of the format
+        bool threw = false;
+        try {
+            mapped_multiscale_array<double, 2> other(path);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // RNS: one column per channel, moduli checked against the basis
+    using Basis = rns_moduli<uint32_t, 7, 11, 13>;
+    using Array = rns_array<uint32_t, 3, Basis>;
+    std::vector<uint32_t> ints;
+    for (uint32_t k = 0; k < 300; ++k) ints.push_back((k * 37) % 1001);
+    auto rns = Array::from_integers(ints);
+    save_array(path, rns);
+    {
+        mapped_rns_array<uint32_t, 3, Basis> mapped(path);
+        assert(mapped.size() == ints.size());
+        for (std::size_t i = 0; i < 3; ++i) {
+            assert(reinterpret_cast<std::uintptr_t>(mapped.channel(i).data()) % array_alignment == 0);
+            for (std::size_t k = 0; k < ints.size(); ++k) assert(mapped.channel(i)[k] == rns.channel(i)[k]);
+        }
+        assert(mapped.get(123).to_integer() == ints[123]);
+        assert(mapped.to_array().to_integers() == ints);
+
+        bool threw = false;
+        try {
+            mapped_rns_array<uint32_t, 3, rns_moduli<uint32_t, 5, 11, 13>> other(path);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Residues are checked when read: from_channels rejects them outright,
+    // a corrupt file fails get() and to_array() for the residue it holds
+    {
+        std::vector<uint32_t> sevens(4, 7), elevens(4, 3), thirteens(4, 5);
+        bool threw = false;
+        try {
+            Array::from_channels({span<const uint32_t>(sevens), span<const uint32_t>(elevens),
+                                  span<const uint32_t>(thirteens)});
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        // Negative residues of a signed type are out of range too
+        const std::vector<int32_t> negative(1, -1);
+        threw = false;
+        try {
+            rns_array<int32_t, 3>::from_channels({span<const int32_t>(negative), span<const int32_t>(negative),
+                                                  span<const int32_t>(negative)});
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        std::size_t offset;
+        {
+            auto file = std::make_shared<const mapped_file>(path);
+            offset = static_cast<std::size_t>(reinterpret_cast<const std::byte*>(
+                         mapped_rns_array<uint32_t, 3, Basis>(file).channel(1).data() + 50) - file->data());
+        }
+        const uint32_t corrupt = 11;
+        std::fstream patch(path, std::ios::in | std::ios::out | std::ios::binary);
+        patch.seekp(static_cast<std::streamoff>(offset));
+        patch.write(reinterpret_cast<const char*>(&corrupt), sizeof(corrupt));
+        patch.close();
+
+        mapped_rns_array<uint32_t, 3, Basis> mapped(path);
+        assert(mapped.channel(1)[50] == 11 && mapped.get(49).to_integer() == ints[49]);
+        threw = false;
+        try {
+            mapped.get(50);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        threw = false;
+        try {
+            mapped.to_array();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    {
+        using Signed = rns_array<int32_t, 3>;
+        save_array(path, Signed::from_integers(std::vector<int32_t>{5, 6, 7}));
+        std::size_t offset;
+        {
+            auto file = std::make_shared<const mapped_file>(path);
+            offset = static_cast<std::size_t>(reinterpret_cast<const std::byte*>(
+                         mapped_rns_array<int32_t, 3>(file).channel(2).data() + 1) - file->data());
+        }
+        const int32_t corrupt = -1;
+        std::fstream patch(path, std::ios::in | std::ios::out | std::ios::binary);
+        patch.seekp(static_cast<std::streamoff>(offset));
+        patch.write(reinterpret_cast<const char*>(&corrupt), sizeof(corrupt));
+        patch.close();
+        mapped_rns_array<int32_t, 3> mapped(path);
+        assert(mapped.get(0).to_integer() == 5);
+        bool threw = false;
+        try {
+            mapped.get(1);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Empty arrays round-trip
+    save_array(path, lg_vector<float>());
+    assert(mapped_lg_vector<float>(path).empty());
+
+    // Transform and scalar type must match
+    save_array(path, logs);
+    bool threw = false;
+    try {
+        mapped_lg_vector<float> wrong(path);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        mapped_log_odds_array<double> wrong(path);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Foreign, byte-swapped, truncated and missing files
+    auto rewrite = [&](auto edit) {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        edit(bytes);
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    auto rejects = [&](const std::string& file) {
+        try {
+            mapped_lg_vector<double> bad(file);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    rewrite([](std::vector<char>& b) { std::reverse(b.begin() + 8, b.begin() + 12); });
+    assert(rejects(path));
+    save_array(path, logs);
+    rewrite([](std::vector<char>& b) { b.resize(b.size() - 64); });
+    assert(rejects(path));
+    save_array(path, logs);
+    rewrite([](std::vector<char>& b) { b[0] = 'X'; });
+    assert(rejects(path));
+    save_array(path, logs);
+    rewrite([](std::vector<char>& b) { b[12] = 9; });   // future version
+    assert(rejects(path));
+    std::filesystem::remove(path);
+    assert(rejects(path));
+
+    std::cout << "PASSED\n";
+}
+
 void test_edge_cases() {
     std::cout << "Testing edge cases and error conditions... ";
     
@@ -846,17 +3315,41 @@ int main() {
     
     // Test all transforms
     test_logarithmic_comprehensive();
+    test_cmath_comprehensive();
+    test_lg_vector_comprehensive();
     test_odds_ratio_comprehensive();
     test_stern_brocot_comprehensive();
+    test_stern_brocot_overflow_comprehensive();
+    test_stern_brocot_lazy_comprehensive();
+    test_stern_brocot_batch_comprehensive();
+    test_big_integer_comprehensive();
     test_rns_comprehensive();
+    test_rns_array_comprehensive();
     test_multiscale_comprehensive();
+    test_multiscale_array_comprehensive();
     test_dual_comprehensive();
+    test_dual_vec_comprehensive();
+    test_adjoint_comprehensive();
+    test_second_order_ad_comprehensive();
     test_interval_comprehensive();
+    test_interval_array_comprehensive();
+    test_interval_bnb_comprehensive();
     test_tropical_comprehensive();
+    test_tropical_matrix_comprehensive();
+    test_tropical_sparse_comprehensive();
+    test_hmm_comprehensive();
     test_modular_comprehensive();
+    test_ntt_comprehensive();
     test_quaternion_comprehensive();
+    test_quaternion_array_comprehensive();
     test_mappings_comprehensive();
+    test_conversion_graph_comprehensive();
+    test_adaptive_comprehensive();
+    test_instrumentation_comprehensive();
+    test_parallel_comprehensive();
+    test_serialization_comprehensive();
     test_composed_comprehensive();
+    test_log_odds_scorer_comprehensive();
     
     // Test edge cases and error conditions
     test_edge_cases();